@@ -1,6 +1,11 @@
 #pragma once
 
+#include "config.h"
+
+#include "transfer.hpp"
+
 #include <cassert>
+#include <chrono>
 #include <functional>
 #include <map>
 #include <vector>
@@ -23,16 +28,24 @@ using HandlerFunc =
 class CmdHandler
 {
   public:
+    CmdHandler() :
+        sessions(TRANSFER_PART_SIZE, TRANSFER_SESSION_MAX_BYTES,
+                 std::chrono::milliseconds(TRANSFER_SESSION_TIMEOUT_MS))
+    {
+    }
+
     /** @brief Invoke a PLDM command handler
      *
+     *  @param[in] eid - MCTP endpoint the request came from
      *  @param[in] pldmCommand - PLDM command code
      *  @param[in] request - PLDM request message
      *  @param[in] reqMsgLen - PLDM request message size
      *  @return PLDM response message
      */
-    Response handle(Command pldmCommand, const pldm_msg* request,
+    Response handle(uint8_t eid, Command pldmCommand, const pldm_msg* request,
                     size_t reqMsgLen)
     {
+        requesterEid = eid;
         return handlers.at(pldmCommand)(request, reqMsgLen);
     }
 
@@ -54,10 +67,36 @@ class CmdHandler
     }
 
   protected:
+    /** @brief Get the part of a table a request of a multipart transfer asks
+     *         for, the table being built for the first part
+     *
+     *  @param[in] request - PLDM request message
+     *  @param[in] tableType - type of the table
+     *  @param[in] transferHandle - transfer handle from the request
+     *  @param[in] transferOpFlag - transfer operation flag from the request
+     *  @param[in] build - builds the table
+     *  @param[out] part - the part
+     *  @return PLDM completion code
+     */
+    uint8_t getTablePart(const pldm_msg* request, uint8_t tableType,
+                         uint32_t transferHandle, uint8_t transferOpFlag,
+                         const transfer::Build& build, transfer::Part& part)
+    {
+        return sessions.getPart(requesterEid, request->hdr.command, tableType,
+                                transferHandle, transferOpFlag, build, part);
+    }
+
     /** @brief map of PLDM command code to handler - to be populated by derived
      *         classes.
      */
     std::map<Command, HandlerFunc> handlers;
+
+  private:
+    /** @brief MCTP endpoint of the request being handled */
+    uint8_t requesterEid = 0;
+
+    /** @brief Multipart transfers of the tables of the handler */
+    transfer::Sessions sessions;
 };
 
 } // namespace responder
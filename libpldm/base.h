@@ -39,7 +39,8 @@ enum pldm_completion_codes {
 	PLDM_ERROR_INVALID_LENGTH = 0x03,
 	PLDM_ERROR_NOT_READY = 0x04,
 	PLDM_ERROR_UNSUPPORTED_PLDM_CMD = 0x05,
-	PLDM_ERROR_INVALID_PLDM_TYPE = 0x20
+	PLDM_ERROR_INVALID_PLDM_TYPE = 0x20,
+	PLDM_INVALID_TRANSFER_OPERATION_FLAG = 0x21
 };
 
 enum transfer_op_flag {
@@ -335,6 +335,20 @@ int pldm_bios_table_attr_entry_string_decode_def_string_length_check(
     const struct pldm_bios_attr_table_entry *entry,
     uint16_t *def_string_length);
 
+/** @brief Get the minimum length of the string in bytes for the entry
+ *  @param[in] entry - Pointer to bios attribute table entry
+ *  @return minimum length of the string in bytes
+ */
+uint16_t pldm_bios_table_attr_entry_string_decode_min_length(
+    const struct pldm_bios_attr_table_entry *entry);
+
+/** @brief Get the maximum length of the string in bytes for the entry
+ *  @param[in] entry - Pointer to bios attribute table entry
+ *  @return maximum length of the string in bytes
+ */
+uint16_t pldm_bios_table_attr_entry_string_decode_max_length(
+    const struct pldm_bios_attr_table_entry *entry);
+
 /** @struct pldm_bios_table_attr_entry_integer_info
  *
  *  An auxiliary structure for passing parameters to @ref
@@ -388,6 +402,17 @@ int pldm_bios_table_attr_entry_integer_encode_check(
     void *entry, size_t entry_length,
     const struct pldm_bios_table_attr_entry_integer_info *info);
 
+/** @brief Decode the fields of an attribute entry(type: integer)
+ *  @param[in] entry - Pointer to bios attribute table entry
+ *  @param[out] lower - The lower bound on the integer value
+ *  @param[out] upper - The upper bound on the integer value
+ *  @param[out] scalar - The scalar value that is used for the increments
+ *  @param[out] def - The default value of the integer
+ */
+void pldm_bios_table_attr_entry_integer_decode(
+    const struct pldm_bios_attr_table_entry *entry, uint64_t *lower,
+    uint64_t *upper, uint32_t *scalar, uint64_t *def);
+
 /** @brief Get length that an attribute value entry(type: enum) will take
  *  @param[in] count - Total number of current values for this enumeration
  *  @return The length that an entry(type: enum) will take
@@ -416,6 +441,17 @@ void pldm_bios_table_attr_value_entry_encode_enum(
 uint8_t pldm_bios_table_attr_value_entry_enum_decode_number(
     const struct pldm_bios_attr_val_table_entry *entry);
 
+/** @brief Get the current values of the enum entry
+ *  @param[in] entry - Pointer to bios attribute value table entry
+ *  @param[out] handles - Buffer for the indexes into the array of the possible
+ * values of string handles, provided in the BIOS Attribute Table
+ *  @param[in] number - Number of indexes the buffer holds
+ *  @return Number of indexes copied to the buffer
+ */
+uint8_t pldm_bios_table_attr_value_entry_enum_decode_handles(
+    const struct pldm_bios_attr_val_table_entry *entry, uint8_t *handles,
+    uint8_t number);
+
 /** @brief Create an attribute value entry(type: enum) and check the validity of
  * the parameters
  *  @param[out] entry - Pointer to bios attribute value entry
@@ -517,6 +553,13 @@ int pldm_bios_table_attr_value_entry_encode_integer_check(void *entry,
 							  uint8_t attr_type,
 							  uint64_t cv);
 
+/** @brief Get the current value of the integer entry
+ *  @param[in] entry - Pointer to bios attribute value table entry
+ *  @return Current Value
+ */
+uint64_t pldm_bios_table_attr_value_entry_integer_decode_cv(
+    const struct pldm_bios_attr_val_table_entry *entry);
+
 /** @brief Get the handle from the attribute value entry
  *  @param[in] entry - Pointer to bios attribute value entry
  *  @return handle to identify the attribute in the attribute value table
@@ -19,19 +19,172 @@ extern "C" {
 /* Minimum response length */
 #define PLDM_GET_PDR_MIN_RESP_BYTES 12
 
+#define PLDM_GET_PDR_REPOSITORY_INFO_RESP_BYTES 41
+#define PLDM_TIMESTAMP104_SIZE 13
+
+#define PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES 4
+/* Minimum response length, with a single composite sensor */
+#define PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES 6
+
+#define PLDM_GET_SENSOR_READING_REQ_BYTES 3
+/* Minimum response length, with a uint8 or sint8 present reading */
+#define PLDM_GET_SENSOR_READING_MIN_RESP_BYTES 8
+
+/* Minimum request length, without event data */
+#define PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES 3
+#define PLDM_PLATFORM_EVENT_MESSAGE_RESP_BYTES 2
+
+/* Sensor event data lengths, the numeric sensor state with a uint8 or sint8
+ * present reading
+ */
+#define PLDM_SENSOR_EVENT_DATA_MIN_LENGTH 3
+#define PLDM_SENSOR_EVENT_SENSOR_OP_STATE_DATA_LENGTH 2
+#define PLDM_SENSOR_EVENT_STATE_SENSOR_STATE_DATA_LENGTH 3
+#define PLDM_SENSOR_EVENT_NUMERIC_SENSOR_STATE_MIN_DATA_LENGTH 4
+
 enum set_request { PLDM_NO_CHANGE = 0x00, PLDM_REQUEST_SET = 0x01 };
 
 enum effecter_state { PLDM_INVALID_VALUE = 0xFF };
 
 enum pldm_platform_commands {
+	PLDM_PLATFORM_EVENT_MESSAGE = 0x0A,
+	PLDM_GET_SENSOR_READING = 0x11,
+	PLDM_GET_STATE_SENSOR_READINGS = 0x21,
 	PLDM_SET_STATE_EFFECTER_STATES = 0x39,
+	PLDM_GET_PDR_REPOSITORY_INFO = 0x50,
 	PLDM_GET_PDR = 0x51,
 };
 
+/** @brief PLDM PDR repository states, as per table 68 of DSP0248 v1.1.1
+ */
+enum pldm_pdr_repository_state {
+	PLDM_PDR_REPOSITORY_AVAILABLE,
+	PLDM_PDR_REPOSITORY_UPDATE_IN_PROGRESS,
+	PLDM_PDR_REPOSITORY_FAILED
+};
+
 /** @brief PLDM PDR types
  */
 enum pldm_pdr_types {
+	PLDM_TERMINUS_LOCATOR_PDR = 1,
+	PLDM_NUMERIC_SENSOR_PDR = 2,
+	PLDM_STATE_SENSOR_PDR = 4,
+	PLDM_NUMERIC_EFFECTER_PDR = 9,
 	PLDM_STATE_EFFECTER_PDR = 11,
+	PLDM_PDR_ENTITY_ASSOCIATION = 15,
+	PLDM_PDR_FRU_RECORD_SET = 20,
+};
+
+/** @brief PLDM sensor operational states, as per table 20 of DSP0248 v1.1.1
+ */
+enum pldm_sensor_operational_state {
+	PLDM_SENSOR_ENABLED,
+	PLDM_SENSOR_DISABLED,
+	PLDM_SENSOR_UNAVAILABLE,
+	PLDM_SENSOR_STATUSUNKNOWN,
+	PLDM_SENSOR_FAILED,
+	PLDM_SENSOR_INITIALIZING,
+	PLDM_SENSOR_SHUTTINGDOWN,
+	PLDM_SENSOR_INTEST
+};
+
+/** @brief PLDM sensor event message enable values, as per table 20 of
+ *         DSP0248 v1.1.1
+ */
+enum pldm_sensor_event_message_enable {
+	PLDM_NO_EVENT_GENERATION,
+	PLDM_EVENTS_DISABLED,
+	PLDM_EVENTS_ENABLED,
+	PLDM_OP_EVENTS_ONLY_ENABLED,
+	PLDM_STATE_EVENTS_ONLY_ENABLED
+};
+
+/** @brief PLDM numeric sensor present, previous and event states, as per
+ *         table 20 of DSP0248 v1.1.1
+ */
+enum pldm_sensor_present_state {
+	PLDM_SENSOR_UNKNOWN = 0x0,
+	PLDM_SENSOR_NORMAL = 0x01,
+	PLDM_SENSOR_WARNING = 0x02,
+	PLDM_SENSOR_CRITICAL = 0x03,
+	PLDM_SENSOR_FATAL = 0x04,
+	PLDM_SENSOR_LOWERWARNING = 0x05,
+	PLDM_SENSOR_LOWERCRITICAL = 0x06,
+	PLDM_SENSOR_LOWERFATAL = 0x07,
+	PLDM_SENSOR_UPPERWARNING = 0x08,
+	PLDM_SENSOR_UPPERCRITICAL = 0x09,
+	PLDM_SENSOR_UPPERFATAL = 0x0a
+};
+
+/** @brief PLDM event classes, as per table 11 of DSP0248 v1.1.1
+ */
+enum pldm_event_types {
+	PLDM_SENSOR_EVENT = 0x00,
+	PLDM_EFFECTER_EVENT = 0x01,
+	PLDM_REDFISH_TASK_EXECUTED_EVENT = 0x02,
+	PLDM_REDFISH_MESSAGE_EVENT = 0x03,
+	PLDM_PDR_REPOSITORY_CHG_EVENT = 0x04,
+	PLDM_MESSAGE_POLL_EVENT = 0x05,
+	PLDM_HEARTBEAT_TIMER_ELAPSED_EVENT = 0x06
+};
+
+/** @brief PLDM sensor event classes, as per table 19 of DSP0248 v1.1.1
+ */
+enum pldm_sensor_event_message_types {
+	PLDM_SENSOR_OP_STATE,
+	PLDM_STATE_SENSOR_STATE,
+	PLDM_NUMERIC_SENSOR_STATE
+};
+
+/** @brief PLDM platform event status, as per table 14 of DSP0248 v1.1.1
+ */
+enum pldm_platform_event_status {
+	PLDM_EVENT_NO_LOGGING = 0x00,
+	PLDM_EVENT_LOGGING_DISABLED = 0x01,
+	PLDM_EVENT_LOG_FULL = 0x02,
+	PLDM_EVENT_ACCEPTED_FOR_LOGGING = 0x03,
+	PLDM_EVENT_LOGGED = 0x04,
+	PLDM_EVENT_LOGGING_REJECTED = 0x05
+};
+
+/** @brief PLDM sensor initialization schemes
+ */
+enum pldm_sensor_init {
+	PLDM_SENSOR_NO_INIT,
+	PLDM_SENSOR_USE_INIT_PDR,
+	PLDM_SENSOR_ENABLE,
+	PLDM_SENSOR_DISABLE
+};
+
+/** @brief PLDM numeric sensor data sizes, as per table 78 of DSP0248 v1.1.1
+ */
+enum pldm_sensor_readings_data_type {
+	PLDM_SENSOR_DATA_SIZE_UINT8,
+	PLDM_SENSOR_DATA_SIZE_SINT8,
+	PLDM_SENSOR_DATA_SIZE_UINT16,
+	PLDM_SENSOR_DATA_SIZE_SINT16,
+	PLDM_SENSOR_DATA_SIZE_UINT32,
+	PLDM_SENSOR_DATA_SIZE_SINT32
+};
+
+/** @brief PLDM numeric sensor range field formats, as per table 78 of
+ *  DSP0248 v1.1.1
+ */
+enum pldm_range_field_format {
+	PLDM_RANGE_FIELD_FORMAT_UINT8,
+	PLDM_RANGE_FIELD_FORMAT_SINT8,
+	PLDM_RANGE_FIELD_FORMAT_UINT16,
+	PLDM_RANGE_FIELD_FORMAT_SINT16,
+	PLDM_RANGE_FIELD_FORMAT_UINT32,
+	PLDM_RANGE_FIELD_FORMAT_SINT32,
+	PLDM_RANGE_FIELD_FORMAT_REAL32
+};
+
+/** @brief PLDM entity association types
+ */
+enum pldm_entity_association_type {
+	PLDM_ENTITY_ASSOCIATION_PHYSICAL = 0x0,
+	PLDM_ENTITY_ASSOCIATION_LOGICAL = 0x1,
 };
 
 /** @brief PLDM effecter initialization schemes
@@ -47,6 +200,7 @@ enum pldm_effecter_init {
  */
 enum pldm_platform_completion_codes {
 	PLDM_PLATFORM_INVALID_EFFECTER_ID = 0x80,
+	PLDM_PLATFORM_INVALID_SENSOR_ID = 0x80,
 	PLDM_PLATFORM_INVALID_STATE_VALUE = 0x81,
 	PLDM_PLATFORM_INVALID_RECORD_HANDLE = 0x82,
 	PLDM_PLATFORM_SET_EFFECTER_UNSUPPORTED_SENSORSTATE = 0x82,
@@ -92,6 +246,99 @@ struct state_effecter_possible_states {
 	bitfield8_t states[1];
 } __attribute__((packed));
 
+/** @struct pldm_state_sensor_pdr
+ *
+ *  Structure representing PLDM state sensor PDR
+ */
+struct pldm_state_sensor_pdr {
+	struct pldm_pdr_hdr hdr;
+	uint16_t terminus_handle;
+	uint16_t sensor_id;
+	uint16_t entity_type;
+	uint16_t entity_instance;
+	uint16_t container_id;
+	uint8_t sensor_init;
+	bool8_t sensor_auxiliary_names_pdr;
+	uint8_t composite_sensor_count;
+	uint8_t possible_states[1];
+} __attribute__((packed));
+
+/** @struct state_sensor_possible_states
+ *
+ *  Structure representing state enums for state sensor
+ */
+struct state_sensor_possible_states {
+	uint16_t state_set_id;
+	uint8_t possible_states_size;
+	bitfield8_t states[1];
+} __attribute__((packed));
+
+/** @struct pldm_numeric_sensor_pdr
+ *
+ *  Structure representing the fixed length leading part of the PLDM numeric
+ *  sensor PDR, up to and including the sensor data size. The remaining fields
+ *  have a length that depends on the sensor data size and the range field
+ *  format.
+ */
+struct pldm_numeric_sensor_pdr {
+	struct pldm_pdr_hdr hdr;
+	uint16_t terminus_handle;
+	uint16_t sensor_id;
+	uint16_t entity_type;
+	uint16_t entity_instance;
+	uint16_t container_id;
+	uint8_t sensor_init;
+	bool8_t sensor_auxiliary_names_pdr;
+	uint8_t base_unit;
+	int8_t unit_modifier;
+	uint8_t rate_unit;
+	uint8_t base_oem_unit_handle;
+	uint8_t aux_unit;
+	int8_t aux_unit_modifier;
+	uint8_t aux_rate_unit;
+	uint8_t rel;
+	uint8_t aux_oem_unit_handle;
+	bool8_t is_linear;
+	uint8_t sensor_data_size;
+	uint8_t variable_fields[1];
+} __attribute__((packed));
+
+/** @struct pldm_entity
+ *
+ *  Structure representing a PLDM entity
+ */
+typedef struct pldm_entity {
+	uint16_t entity_type;
+	uint16_t entity_instance_num;
+	uint16_t entity_container_id;
+} __attribute__((packed)) pldm_entity;
+
+/** @struct pldm_pdr_entity_association
+ *
+ *  Structure representing PLDM entity association PDR
+ */
+struct pldm_pdr_entity_association {
+	struct pldm_pdr_hdr hdr;
+	uint16_t container_id;
+	uint8_t association_type;
+	pldm_entity container;
+	uint8_t num_children;
+	pldm_entity children[1];
+} __attribute__((packed));
+
+/** @struct pldm_pdr_fru_record_set
+ *
+ *  Structure representing PLDM FRU record set PDR
+ */
+struct pldm_pdr_fru_record_set {
+	struct pldm_pdr_hdr hdr;
+	uint16_t terminus_handle;
+	uint16_t fru_rsi;
+	uint16_t entity_type;
+	uint16_t entity_instance_num;
+	uint16_t container_id;
+} __attribute__((packed));
+
 /** @struct set_effecter_state_field
  *
  *  Structure representing a stateField in SetStateEffecterStates command */
@@ -138,6 +385,139 @@ struct pldm_get_pdr_req {
 	uint16_t record_change_number;
 } __attribute__((packed));
 
+/** @struct pldm_get_pdr_repository_info_resp
+ *
+ *  Structure representing PLDM get PDR repository info response.
+ */
+struct pldm_get_pdr_repository_info_resp {
+	uint8_t completion_code;
+	uint8_t repository_state;
+	uint8_t update_time[PLDM_TIMESTAMP104_SIZE];
+	uint8_t oem_update_time[PLDM_TIMESTAMP104_SIZE];
+	uint32_t record_count;
+	uint32_t repository_size;
+	uint32_t largest_record_size;
+	uint8_t data_transfer_handle_timeout;
+} __attribute__((packed));
+
+/** @struct get_sensor_state_field
+ *
+ *  Structure representing a stateField in GetStateSensorReadings command */
+
+typedef struct state_field_for_get_state_sensor_readings {
+	uint8_t sensor_op_state; //!< The state of the sensor itself
+	uint8_t present_state;   //!< Most recently assessed state value
+	uint8_t previous_state;  //!< State the present state changed from
+	uint8_t event_state;     //!< State value that triggered the last event
+} __attribute__((packed)) get_sensor_state_field;
+
+/** @struct pldm_get_sensor_reading_req
+ *
+ *  Structure representing PLDM get sensor reading request.
+ */
+struct pldm_get_sensor_reading_req {
+	uint16_t sensor_id;
+	bool8_t rearm_event_state;
+} __attribute__((packed));
+
+/** @struct pldm_get_sensor_reading_resp
+ *
+ *  Structure representing PLDM get sensor reading response. The present
+ *  reading is 1, 2 or 4 bytes long depending on the sensor data size.
+ */
+struct pldm_get_sensor_reading_resp {
+	uint8_t completion_code;
+	uint8_t sensor_data_size;
+	uint8_t sensor_operational_state;
+	uint8_t sensor_event_message_enable;
+	uint8_t present_state;
+	uint8_t previous_state;
+	uint8_t event_state;
+	uint8_t present_reading[1];
+} __attribute__((packed));
+
+/** @struct pldm_get_state_sensor_readings_req
+ *
+ *  Structure representing PLDM get state sensor readings request.
+ */
+struct pldm_get_state_sensor_readings_req {
+	uint16_t sensor_id;
+	bitfield8_t sensor_rearm;
+	uint8_t reserved;
+} __attribute__((packed));
+
+/** @struct pldm_get_state_sensor_readings_resp
+ *
+ *  Structure representing PLDM get state sensor readings response.
+ */
+struct pldm_get_state_sensor_readings_resp {
+	uint8_t completion_code;
+	uint8_t comp_sensor_count;
+	get_sensor_state_field field[1];
+} __attribute__((packed));
+
+/** @struct pldm_platform_event_message_req
+ *
+ *  Structure representing PLDM platform event message request.
+ */
+struct pldm_platform_event_message_req {
+	uint8_t format_version;
+	uint8_t tid;
+	uint8_t event_class;
+	uint8_t event_data[1];
+} __attribute__((packed));
+
+/** @struct pldm_platform_event_message_resp
+ *
+ *  Structure representing PLDM platform event message response.
+ */
+struct pldm_platform_event_message_resp {
+	uint8_t completion_code;
+	uint8_t platform_event_status;
+} __attribute__((packed));
+
+/** @struct pldm_sensor_event_data
+ *
+ *  Structure representing the event data of a sensor event.
+ */
+struct pldm_sensor_event_data {
+	uint16_t sensor_id;
+	uint8_t sensor_event_class_type;
+	uint8_t event_class[1];
+} __attribute__((packed));
+
+/** @struct pldm_sensor_event_sensor_op_state
+ *
+ *  Structure representing the sensorOpState sensor event class data.
+ */
+struct pldm_sensor_event_sensor_op_state {
+	uint8_t present_op_state;
+	uint8_t previous_op_state;
+} __attribute__((packed));
+
+/** @struct pldm_sensor_event_state_sensor_state
+ *
+ *  Structure representing the stateSensorState sensor event class data.
+ */
+struct pldm_sensor_event_state_sensor_state {
+	uint8_t sensor_offset;
+	uint8_t event_state;
+	uint8_t previous_event_state;
+} __attribute__((packed));
+
+/** @struct pldm_sensor_event_numeric_sensor_state
+ *
+ *  Structure representing the numericSensorState sensor event class data.
+ *  The present reading is 1, 2 or 4 bytes long depending on the sensor data
+ *  size.
+ */
+struct pldm_sensor_event_numeric_sensor_state {
+	uint8_t event_state;
+	uint8_t previous_event_state;
+	uint8_t sensor_data_size;
+	uint8_t present_reading[1];
+} __attribute__((packed));
+
 /* Responder */
 
 /* SetStateEffecterStates */
@@ -228,6 +608,209 @@ int decode_get_pdr_req(const struct pldm_msg *msg, size_t payload_length,
 		       uint8_t *transfer_op_flag, uint16_t *request_cnt,
 		       uint16_t *record_chg_num);
 
+/* GetPDRRepositoryInfo */
+
+/** @brief Create a PLDM response message for GetPDRRepositoryInfo
+ *
+ *  @param[in] instance_id - Message's instance id
+ *  @param[in] completion_code - PLDM completion code
+ *  @param[in] repository_state - pldm_pdr_repository_state
+ *  @param[in] update_time - When the repository was last updated, a
+ *         timestamp104 of PLDM_TIMESTAMP104_SIZE bytes
+ *  @param[in] oem_update_time - When OEM PDRs were last updated, a
+ *         timestamp104 of PLDM_TIMESTAMP104_SIZE bytes
+ *  @param[in] record_count - Number of PDRs in the repository
+ *  @param[in] repository_size - Total size of the PDRs in bytes
+ *  @param[in] largest_record_size - Size of the largest PDR in bytes
+ *  @param[in] data_transfer_handle_timeout - Seconds a data transfer handle
+ *         stays valid
+ *  @param[out] msg - Message will be written to this
+ *  @return pldm_completion_codes
+ *  @note  Caller is responsible for memory alloc and dealloc of param
+ *         'msg.payload'
+ */
+int encode_get_pdr_repository_info_resp(
+    uint8_t instance_id, uint8_t completion_code, uint8_t repository_state,
+    const uint8_t *update_time, const uint8_t *oem_update_time,
+    uint32_t record_count, uint32_t repository_size,
+    uint32_t largest_record_size, uint8_t data_transfer_handle_timeout,
+    struct pldm_msg *msg);
+
+/* GetStateSensorReadings */
+
+/** @brief Create a PLDM response message for GetStateSensorReadings
+ *
+ *  @param[in] instance_id - Message's instance id
+ *  @param[in] completion_code - PLDM completion code
+ *  @param[in] comp_sensor_count - The number of individual sets of sensor
+ *         information that this command accesses, 1 to 8
+ *  @param[in] field - Array of comp_sensor_count sensor state fields
+ *  @param[out] msg - Message will be written to this
+ *  @return pldm_completion_codes
+ *  @note  Caller is responsible for memory alloc and dealloc of param
+ *         'msg.payload'
+ */
+int encode_get_state_sensor_readings_resp(uint8_t instance_id,
+					  uint8_t completion_code,
+					  uint8_t comp_sensor_count,
+					  const get_sensor_state_field *field,
+					  struct pldm_msg *msg);
+
+/** @brief Decode GetStateSensorReadings request data
+ *
+ *  @param[in] msg - Request message
+ *  @param[in] payload_length - Length of request message payload
+ *  @param[out] sensor_id - used to identify and access the sensor
+ *  @param[out] sensor_rearm - Each bit location in this field corresponds to a
+ *         particular sensor within the state sensor, where bit [0] corresponds
+ *         to the first state sensor (sensor offset 0) and bit [7] corresponds
+ *         to the eighth sensor (sensor offset 7), sequentially
+ *  @param[out] reserved - value: 0x00
+ *  @return pldm_completion_codes
+ */
+int decode_get_state_sensor_readings_req(const struct pldm_msg *msg,
+					 size_t payload_length,
+					 uint16_t *sensor_id,
+					 bitfield8_t *sensor_rearm,
+					 uint8_t *reserved);
+
+/* GetSensorReading */
+
+/** @brief Create a PLDM response message for GetSensorReading
+ *
+ *  @param[in] instance_id - Message's instance id
+ *  @param[in] completion_code - PLDM completion code
+ *  @param[in] sensor_data_size - The bit width and format of reading and
+ *         threshold values, as per enum pldm_sensor_readings_data_type
+ *  @param[in] sensor_operational_state - The state of the sensor itself
+ *  @param[in] sensor_event_message_enable - Whether the sensor generates
+ *         events
+ *  @param[in] present_state - The most recently assessed state value
+ *  @param[in] previous_state - The state the present state changed from
+ *  @param[in] event_state - The state value that triggered the last event
+ *  @param[in] present_reading - The present value of the sensor, little
+ *         endian, of the width given by sensor_data_size
+ *  @param[out] msg - Message will be written to this
+ *  @param[in] payload_length - Length of response message payload
+ *  @return pldm_completion_codes
+ *  @note  Caller is responsible for memory alloc and dealloc of param
+ *         'msg.payload'
+ */
+int encode_get_sensor_reading_resp(
+    uint8_t instance_id, uint8_t completion_code, uint8_t sensor_data_size,
+    uint8_t sensor_operational_state, uint8_t sensor_event_message_enable,
+    uint8_t present_state, uint8_t previous_state, uint8_t event_state,
+    const uint8_t *present_reading, struct pldm_msg *msg,
+    size_t payload_length);
+
+/** @brief Decode GetSensorReading request data
+ *
+ *  @param[in] msg - Request message
+ *  @param[in] payload_length - Length of request message payload
+ *  @param[out] sensor_id - A handle that is used to identify and access
+ *         the sensor
+ *  @param[out] rearm_event_state - true = manually re-arm EventState after
+ *         responding to this request, false = no manual re-arm
+ *  @return pldm_completion_codes
+ */
+int decode_get_sensor_reading_req(const struct pldm_msg *msg,
+				  size_t payload_length, uint16_t *sensor_id,
+				  bool8_t *rearm_event_state);
+
+/* PlatformEventMessage */
+
+/** @brief Decode PlatformEventMessage request data
+ *
+ *  @param[in] msg - Request message
+ *  @param[in] payload_length - Length of request message payload
+ *  @param[out] format_version - Version of the event format
+ *  @param[out] tid - Terminus ID of the terminus that sent the event
+ *  @param[out] event_class - The class of event being sent
+ *  @param[out] event_data_offset - Offset of the event data in the payload
+ *  @return pldm_completion_codes
+ */
+int decode_platform_event_message_req(const struct pldm_msg *msg,
+				      size_t payload_length,
+				      uint8_t *format_version, uint8_t *tid,
+				      uint8_t *event_class,
+				      size_t *event_data_offset);
+
+/** @brief Create a PLDM response message for PlatformEventMessage
+ *
+ *  @param[in] instance_id - Message's instance id
+ *  @param[in] completion_code - PLDM completion code
+ *  @param[in] platform_event_status - What the receiver did with the event,
+ *         as per enum pldm_platform_event_status
+ *  @param[out] msg - Message will be written to this
+ *  @return pldm_completion_codes
+ *  @note  Caller is responsible for memory alloc and dealloc of param
+ *         'msg.payload'
+ */
+int encode_platform_event_message_resp(uint8_t instance_id,
+				       uint8_t completion_code,
+				       uint8_t platform_event_status,
+				       struct pldm_msg *msg);
+
+/** @brief Decode the event data of a sensor event
+ *
+ *  @param[in] event_data - The event data of the PlatformEventMessage
+ *  @param[in] event_data_length - Length of the event data
+ *  @param[out] sensor_id - The sensor the event is from
+ *  @param[out] sensor_event_class_type - The sensor event class, as per enum
+ *         pldm_sensor_event_message_types
+ *  @param[out] event_class_data_offset - Offset of the sensor event class
+ *         data in the event data
+ *  @return pldm_completion_codes
+ */
+int decode_sensor_event_data(const uint8_t *event_data,
+			     size_t event_data_length, uint16_t *sensor_id,
+			     uint8_t *sensor_event_class_type,
+			     size_t *event_class_data_offset);
+
+/** @brief Decode the sensorOpState sensor event class data
+ *
+ *  @param[in] class_data - The sensor event class data
+ *  @param[in] class_data_length - Length of the sensor event class data
+ *  @param[out] present_op_state - The sensor operational state
+ *  @param[out] previous_op_state - The operational state the sensor changed
+ *         from
+ *  @return pldm_completion_codes
+ */
+int decode_sensor_op_data(const uint8_t *class_data, size_t class_data_length,
+			  uint8_t *present_op_state,
+			  uint8_t *previous_op_state);
+
+/** @brief Decode the stateSensorState sensor event class data
+ *
+ *  @param[in] class_data - The sensor event class data
+ *  @param[in] class_data_length - Length of the sensor event class data
+ *  @param[out] sensor_offset - The composite sensor the event is for
+ *  @param[out] event_state - The state that triggered the event
+ *  @param[out] previous_event_state - The state the sensor changed from
+ *  @return pldm_completion_codes
+ */
+int decode_state_sensor_data(const uint8_t *class_data,
+			     size_t class_data_length, uint8_t *sensor_offset,
+			     uint8_t *event_state,
+			     uint8_t *previous_event_state);
+
+/** @brief Decode the numericSensorState sensor event class data
+ *
+ *  @param[in] class_data - The sensor event class data
+ *  @param[in] class_data_length - Length of the sensor event class data
+ *  @param[out] event_state - The state that triggered the event
+ *  @param[out] previous_event_state - The state the sensor changed from
+ *  @param[out] sensor_data_size - The format of the present reading
+ *  @param[out] present_reading - The reading that triggered the event,
+ *         zero or sign extended to 32 bits as per sensor_data_size
+ *  @return pldm_completion_codes
+ */
+int decode_numeric_sensor_data(const uint8_t *class_data,
+			       size_t class_data_length, uint8_t *event_state,
+			       uint8_t *previous_event_state,
+			       uint8_t *sensor_data_size,
+			       uint32_t *present_reading);
+
 /* Requester */
 
 /* GetPDR */
@@ -280,6 +863,43 @@ int decode_get_pdr_resp(const struct pldm_msg *msg, size_t payload_length,
 			uint8_t *record_data, size_t record_data_length,
 			uint8_t *transfer_crc);
 
+/* GetPDRRepositoryInfo */
+
+/** @brief Create a PLDM request message for GetPDRRepositoryInfo
+ *
+ *  @param[in] instance_id - Message's instance id
+ *  @param[out] msg - Message will be written to this
+ *  @return pldm_completion_codes
+ *  @note  Caller is responsible for memory alloc and dealloc of param
+ *         'msg.payload'
+ */
+int encode_get_pdr_repository_info_req(uint8_t instance_id,
+				       struct pldm_msg *msg);
+
+/** @brief Decode GetPDRRepositoryInfo response data
+ *
+ *  @param[in] msg - Response message
+ *  @param[in] payload_length - Length of response message payload
+ *  @param[out] completion_code - PLDM completion code
+ *  @param[out] repository_state - pldm_pdr_repository_state
+ *  @param[out] update_time - When the repository was last updated, room for
+ *         PLDM_TIMESTAMP104_SIZE bytes is required
+ *  @param[out] oem_update_time - When OEM PDRs were last updated, room for
+ *         PLDM_TIMESTAMP104_SIZE bytes is required
+ *  @param[out] record_count - Number of PDRs in the repository
+ *  @param[out] repository_size - Total size of the PDRs in bytes
+ *  @param[out] largest_record_size - Size of the largest PDR in bytes
+ *  @param[out] data_transfer_handle_timeout - Seconds a data transfer handle
+ *         stays valid
+ *  @return pldm_completion_codes
+ */
+int decode_get_pdr_repository_info_resp(
+    const struct pldm_msg *msg, size_t payload_length,
+    uint8_t *completion_code, uint8_t *repository_state,
+    uint8_t *update_time, uint8_t *oem_update_time, uint32_t *record_count,
+    uint32_t *repository_size, uint32_t *largest_record_size,
+    uint8_t *data_transfer_handle_timeout);
+
 /* SetStateEffecterStates */
 
 /** @brief Create a PLDM request message for SetStateEffecterStates
@@ -317,6 +937,121 @@ int encode_set_state_effecter_states_req(uint8_t instance_id,
 int decode_set_state_effecter_states_resp(const struct pldm_msg *msg,
 					  size_t payload_length,
 					  uint8_t *completion_code);
+
+/* GetStateSensorReadings */
+
+/** @brief Create a PLDM request message for GetStateSensorReadings
+ *
+ *  @param[in] instance_id - Message's instance id
+ *  @param[in] sensor_id - used to identify and access the sensor
+ *  @param[in] sensor_rearm - Each bit location in this field corresponds to a
+ *         particular sensor within the state sensor
+ *  @param[in] reserved - value: 0x00
+ *  @param[out] msg - Message will be written to this
+ *  @return pldm_completion_codes
+ *  @note  Caller is responsible for memory alloc and dealloc of param
+ *         'msg.payload'
+ */
+int encode_get_state_sensor_readings_req(uint8_t instance_id,
+					 uint16_t sensor_id,
+					 bitfield8_t sensor_rearm,
+					 uint8_t reserved, struct pldm_msg *msg);
+
+/** @brief Decode GetStateSensorReadings response data
+ *
+ *  @param[in] msg - Response message
+ *  @param[in] payload_length - Length of response message payload
+ *  @param[out] completion_code - PLDM completion code
+ *  @param[in,out] comp_sensor_count - The number of sensor state fields the
+ *         field array has room for on input, the number returned on output
+ *  @param[out] field - Array of sensor state fields
+ *  @return pldm_completion_codes
+ */
+int decode_get_state_sensor_readings_resp(const struct pldm_msg *msg,
+					  size_t payload_length,
+					  uint8_t *completion_code,
+					  uint8_t *comp_sensor_count,
+					  get_sensor_state_field *field);
+
+/* GetSensorReading */
+
+/** @brief Create a PLDM request message for GetSensorReading
+ *
+ *  @param[in] instance_id - Message's instance id
+ *  @param[in] sensor_id - A handle that is used to identify and access the
+ *         sensor
+ *  @param[in] rearm_event_state - true = manually re-arm EventState after
+ *         responding to this request, false = no manual re-arm
+ *  @param[out] msg - Message will be written to this
+ *  @return pldm_completion_codes
+ *  @note  Caller is responsible for memory alloc and dealloc of param
+ *         'msg.payload'
+ */
+int encode_get_sensor_reading_req(uint8_t instance_id, uint16_t sensor_id,
+				  bool8_t rearm_event_state,
+				  struct pldm_msg *msg);
+
+/** @brief Decode GetSensorReading response data
+ *
+ *  @param[in] msg - Response message
+ *  @param[in] payload_length - Length of response message payload
+ *  @param[out] completion_code - PLDM completion code
+ *  @param[out] sensor_data_size - The bit width and format of reading and
+ *         threshold values
+ *  @param[out] sensor_operational_state - The state of the sensor itself
+ *  @param[out] sensor_event_message_enable - Whether the sensor generates
+ *         events
+ *  @param[out] present_state - The most recently assessed state value
+ *  @param[out] previous_state - The state the present state changed from
+ *  @param[out] event_state - The state value that triggered the last event
+ *  @param[out] present_reading - The present value of the sensor, little
+ *         endian, room for 4 bytes is required
+ *  @return pldm_completion_codes
+ */
+int decode_get_sensor_reading_resp(
+    const struct pldm_msg *msg, size_t payload_length,
+    uint8_t *completion_code, uint8_t *sensor_data_size,
+    uint8_t *sensor_operational_state, uint8_t *sensor_event_message_enable,
+    uint8_t *present_state, uint8_t *previous_state, uint8_t *event_state,
+    uint8_t *present_reading);
+
+/* PlatformEventMessage */
+
+/** @brief Create a PLDM request message for PlatformEventMessage
+ *
+ *  @param[in] instance_id - Message's instance id
+ *  @param[in] format_version - Version of the event format
+ *  @param[in] tid - Terminus ID of the terminus sending the event
+ *  @param[in] event_class - The class of event being sent
+ *  @param[in] event_data - The event data
+ *  @param[in] event_data_length - Length of the event data
+ *  @param[out] msg - Message will be written to this
+ *  @param[in] payload_length - Length of request message payload
+ *  @return pldm_completion_codes
+ *  @note  Caller is responsible for memory alloc and dealloc of param
+ *         'msg.payload'
+ */
+int encode_platform_event_message_req(uint8_t instance_id,
+				      uint8_t format_version, uint8_t tid,
+				      uint8_t event_class,
+				      const uint8_t *event_data,
+				      size_t event_data_length,
+				      struct pldm_msg *msg,
+				      size_t payload_length);
+
+/** @brief Decode PlatformEventMessage response data
+ *
+ *  @param[in] msg - Response message
+ *  @param[in] payload_length - Length of response message payload
+ *  @param[out] completion_code - PLDM completion code
+ *  @param[out] platform_event_status - What the receiver did with the event
+ *  @return pldm_completion_codes
+ */
+int decode_platform_event_message_resp(const struct pldm_msg *msg,
+				       size_t payload_length,
+				       uint8_t *completion_code,
+				       uint8_t *platform_event_status);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,14 +5,18 @@
 
 #include <time.h>
 
+#include <algorithm>
 #include <array>
 #include <boost/crc.hpp>
 #include <chrono>
 #include <ctime>
 #include <filesystem>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <numeric>
+#include <optional>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <variant>
@@ -26,6 +30,12 @@ constexpr auto stringTableFile = "stringTable";
 constexpr auto attrTableFile = "attributeTable";
 constexpr auto attrValTableFile = "attributeValueTable";
 
+/** @brief Files the BIOS tables are persisted in, by table type */
+const std::map<uint8_t, const char*> tableFiles{
+    {PLDM_BIOS_STRING_TABLE, stringTableFile},
+    {PLDM_BIOS_ATTR_TABLE, attrTableFile},
+    {PLDM_BIOS_ATTR_VAL_TABLE, attrValTableFile}};
+
 namespace pldm
 {
 
@@ -101,17 +111,17 @@ namespace bios
 
 Handler::Handler()
 {
-    try
-    {
-        fs::remove(
-            fs::path(std::string(BIOS_TABLES_DIR) + "/" + stringTableFile));
-        fs::remove(
-            fs::path(std::string(BIOS_TABLES_DIR) + "/" + attrTableFile));
-        fs::remove(
-            fs::path(std::string(BIOS_TABLES_DIR) + "/" + attrValTableFile));
-    }
-    catch (const std::exception& e)
+    // Tables persisted from the same BIOS JSONs are used as they are, the
+    // others are rebuilt when they're asked for
+    auto inputsHash = hashConfig(BIOS_JSONS_DIR);
+    for (auto file : {stringTableFile, attrTableFile, attrValTableFile})
     {
+        BIOSTable table((fs::path(BIOS_TABLES_DIR) / file).c_str(),
+                        inputsHash);
+        if (table.isEmpty())
+        {
+            table.remove();
+        }
     }
     handlers.emplace(PLDM_SET_DATE_TIME,
                      [this](const pldm_msg* request, size_t payloadLength) {
@@ -130,6 +140,71 @@ Handler::Handler()
                          return this->getBIOSAttributeCurrentValueByHandle(
                              request, payloadLength);
                      });
+    handlers.emplace(PLDM_SET_BIOS_ATTRIBUTE_CURRENT_VALUE,
+                     [this](const pldm_msg* request, size_t payloadLength) {
+                         return this->setBIOSAttributeCurrentValue(
+                             request, payloadLength);
+                     });
+    watchAttrValues();
+}
+
+void Handler::watchAttrValues()
+{
+    if (setupConfig(BIOS_JSONS_DIR) != 0)
+    {
+        return;
+    }
+
+    namespace rules = sdbusplus::bus::match::rules;
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    std::set<std::string> paths;
+    for (const auto& [path, interface] : getDBusObjects())
+    {
+        if (!paths.emplace(path).second)
+        {
+            continue;
+        }
+
+        try
+        {
+            attrValueMatches.emplace_back(
+                std::make_unique<sdbusplus::bus::match::match>(
+                    bus,
+                    rules::type_signal() + rules::member("PropertiesChanged") +
+                        rules::path(path) +
+                        rules::interface(pldm::utils::dbusProperties),
+                    [this, path](sdbusplus::message::message& msg) {
+                        attrPropertiesChanged(path, msg);
+                    }));
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to watch BIOS attribute object, PATH="
+                      << path << " ERROR=" << e.what() << "\n";
+        }
+    }
+
+    // Read once subscribed, so no change is missed in between
+    fetchProperties(std::chrono::milliseconds(DBUS_GET_TIMEOUT_MS));
+}
+
+void Handler::attrPropertiesChanged(const std::string& path,
+                                    sdbusplus::message::message& msg)
+{
+    std::string interface;
+    pldm::utils::PropertyMap properties;
+    AttrIndices attrIndices;
+    try
+    {
+        msg.read(interface, properties);
+        attrIndices = updateProperties({path, interface}, properties);
+    }
+    catch (const std::exception& e)
+    {
+        // Can't tell what changed, so get it all again
+        attrIndices = invalidateProperties(path);
+    }
+    internal::updateAttrValues(attrIndices, BIOS_JSONS_DIR, BIOS_TABLES_DIR);
 }
 
 Response Handler::getDateTime(const pldm_msg* request, size_t /*payloadLength*/)
@@ -294,6 +369,31 @@ Response getBIOSStringTable(BIOSTable& BIOSStringTable, const pldm_msg* request)
     return response;
 }
 
+/** @brief Get the index of the strings of a BIOS string table, built once
+ *         per string table
+ *
+ *  @param[in] BIOSStringTable - the string table
+ *  @return - const BIOSStringIndex* - the index, nullptr if there's no string
+ *            table
+ */
+const BIOSStringIndex* getStringIndex(const BIOSTable& BIOSStringTable)
+{
+    static std::shared_ptr<const Table> indexed;
+    static std::optional<BIOSStringIndex> index;
+
+    auto table = BIOSStringTable.get();
+    if (!table)
+    {
+        return nullptr;
+    }
+    if (table != indexed)
+    {
+        index.emplace(*table);
+        indexed = std::move(table);
+    }
+    return &*index;
+}
+
 /** @brief Find the string handle from the BIOS string table given the name
  *
  *  @param[in] name - name of the BIOS string
@@ -303,18 +403,16 @@ Response getBIOSStringTable(BIOSTable& BIOSStringTable, const pldm_msg* request)
 StringHandle findStringHandle(const std::string& name,
                               const BIOSTable& BIOSStringTable)
 {
-    Table table;
-    BIOSStringTable.load(table);
-    auto stringEntry = pldm_bios_table_string_find_by_string(
-        table.data(), table.size(), name.c_str());
-    if (stringEntry == nullptr)
+    auto index = getStringIndex(BIOSStringTable);
+    auto handle = index ? index->findHandle(name) : std::nullopt;
+    if (!handle)
     {
         std::cerr << "Reached end of BIOS string table,did not find the "
                   << "handle for the string, STRING=" << name.c_str() << "\n";
         throw InternalFailure();
     }
 
-    return pldm_bios_table_string_entry_decode_handle(stringEntry);
+    return *handle;
 }
 
 /** @brief Find the string name from the BIOS string table for a string handle
@@ -327,23 +425,16 @@ StringHandle findStringHandle(const std::string& name,
 std::string findStringName(StringHandle stringHdl,
                            const BIOSTable& BIOSStringTable)
 {
-    Table table;
-    BIOSStringTable.load(table);
-    auto stringEntry = pldm_bios_table_string_find_by_handle(
-        table.data(), table.size(), stringHdl);
-    std::string name;
-    if (stringEntry == nullptr)
+    auto index = getStringIndex(BIOSStringTable);
+    auto name = index ? index->findName(stringHdl) : nullptr;
+    if (name == nullptr)
     {
         std::cerr << "Reached end of BIOS string table,did not find "
                   << "string name for handle, STRING_HANDLE=" << stringHdl
                   << "\n";
+        return {};
     }
-    auto strLength =
-        pldm_bios_table_string_entry_decode_string_length(stringEntry);
-    name.resize(strLength);
-    pldm_bios_table_string_entry_decode_string(stringEntry, name.data(),
-                                               name.size());
-    return name;
+    return *name;
 }
 
 namespace bios_type_enum
@@ -524,6 +615,48 @@ void constructAttrValueEntry(
         currValStrIndices.size(), currValStrIndices.data());
 }
 
+/** @brief Set the current value of an enumeration attribute
+ *
+ *  @param[in] attrTableEntry - the attribute's attribute table entry
+ *  @param[in] attrValueEntry - the attribute's new attribute value entry
+ *  @param[in] length - length of the new attribute value entry
+ *  @param[in] attrName - name of the attribute
+ *  @param[in] BIOSStringTable - the string table
+ *
+ *  @return uint8_t - PLDM completion code
+ */
+uint8_t setAttrValue(const pldm_bios_attr_table_entry* attrTableEntry,
+                     const pldm_bios_attr_val_table_entry* attrValueEntry,
+                     size_t length, const std::string& attrName,
+                     const BIOSTable& BIOSStringTable)
+{
+    if (length < pldm_bios_table_attr_value_entry_encode_enum_length(0) ||
+        length != pldm_bios_table_attr_value_entry_encode_enum_length(
+                      pldm_bios_table_attr_value_entry_enum_decode_number(
+                          attrValueEntry)))
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+
+    // The D-Bus property holds one of the possible values
+    uint8_t index = 0;
+    auto pvNum = pldm_bios_table_attr_entry_enum_decode_pv_num(attrTableEntry);
+    if (pldm_bios_table_attr_value_entry_enum_decode_number(attrValueEntry) !=
+            1 ||
+        pldm_bios_table_attr_value_entry_enum_decode_handles(attrValueEntry,
+                                                             &index, 1) != 1 ||
+        index >= pvNum)
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+    PossibleValuesByHandle pvHdls(pvNum, 0);
+    pldm_bios_table_attr_entry_enum_decode_pv_hdls(attrTableEntry,
+                                                   pvHdls.data(), pvNum);
+    bios_parser::bios_enum::setAttrValue(
+        attrName, findStringName(pvHdls[index], BIOSStringTable));
+    return PLDM_SUCCESS;
+}
+
 } // end namespace bios_type_enum
 
 namespace bios_type_string
@@ -600,6 +733,46 @@ void constructAttrValueEntry(const pldm_bios_attr_table_entry* attrTableEntry,
         currStr.c_str());
 }
 
+/** @brief Set the current value of a string attribute
+ *
+ *  @param[in] attrTableEntry - the attribute's attribute table entry
+ *  @param[in] attrValueEntry - the attribute's new attribute value entry
+ *  @param[in] length - length of the new attribute value entry
+ *  @param[in] attrName - name of the attribute
+ *  @param[in] BIOSStringTable - the string table
+ *
+ *  @return uint8_t - PLDM completion code
+ */
+uint8_t setAttrValue(const pldm_bios_attr_table_entry* attrTableEntry,
+                     const pldm_bios_attr_val_table_entry* attrValueEntry,
+                     size_t length, const std::string& attrName,
+                     const BIOSTable& BIOSStringTable)
+{
+    std::ignore = BIOSStringTable;
+    if (length < pldm_bios_table_attr_value_entry_encode_string_length(0) ||
+        length != pldm_bios_table_attr_value_entry_encode_string_length(
+                      pldm_bios_table_attr_value_entry_string_decode_length(
+                          attrValueEntry)))
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+
+    auto strLen =
+        pldm_bios_table_attr_value_entry_string_decode_length(attrValueEntry);
+    if (strLen < pldm_bios_table_attr_entry_string_decode_min_length(
+                     attrTableEntry) ||
+        strLen > pldm_bios_table_attr_entry_string_decode_max_length(
+                     attrTableEntry))
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+    auto str = reinterpret_cast<const char*>(attrValueEntry->value) +
+               sizeof(strLen);
+    bios_parser::bios_string::setAttrValue(attrName,
+                                           std::string(str, strLen));
+    return PLDM_SUCCESS;
+}
+
 } // end namespace bios_type_string
 
 namespace bios_type_integer
@@ -670,6 +843,45 @@ void constructAttrValueEntry(const pldm_bios_attr_table_entry* attrTableEntry,
         attrTableEntry->attr_handle, attrTableEntry->attr_type, currentValue);
 }
 
+/** @brief Set the current value of an integer attribute
+ *
+ *  @param[in] attrTableEntry - the attribute's attribute table entry
+ *  @param[in] attrValueEntry - the attribute's new attribute value entry
+ *  @param[in] length - length of the new attribute value entry
+ *  @param[in] attrName - name of the attribute
+ *  @param[in] BIOSStringTable - the string table
+ *
+ *  @return uint8_t - PLDM completion code
+ */
+uint8_t setAttrValue(const pldm_bios_attr_table_entry* attrTableEntry,
+                     const pldm_bios_attr_val_table_entry* attrValueEntry,
+                     size_t length, const std::string& attrName,
+                     const BIOSTable& BIOSStringTable)
+{
+    std::ignore = BIOSStringTable;
+    if (length != pldm_bios_table_attr_value_entry_encode_integer_length())
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+
+    uint64_t lowerBound = 0;
+    uint64_t upperBound = 0;
+    uint32_t scalarIncrement = 0;
+    uint64_t defaultValue = 0;
+    pldm_bios_table_attr_entry_integer_decode(attrTableEntry, &lowerBound,
+                                              &upperBound, &scalarIncrement,
+                                              &defaultValue);
+    auto value =
+        pldm_bios_table_attr_value_entry_integer_decode_cv(attrValueEntry);
+    if (value < lowerBound || value > upperBound ||
+        (scalarIncrement && (value - lowerBound) % scalarIncrement))
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+    bios_parser::bios_integer::setAttrValue(attrName, value);
+    return PLDM_SUCCESS;
+}
+
 } // namespace bios_type_integer
 
 void traverseBIOSAttrTable(const Table& biosAttrTable,
@@ -696,6 +908,108 @@ void traverseBIOSAttrTable(const Table& biosAttrTable,
     }
 }
 
+/** @brief Find the entry of an attribute in the BIOS attribute table,
+ *         through an index built once per attribute table. The handles of
+ *         the attributes of a table are consecutive, so the index is an array
+ *         from the first handle on.
+ *
+ *  @param[in] attrHandle - handle of the attribute
+ *  @param[in] BIOSAttributeTable - the attribute table
+ *
+ *  @return const pldm_bios_attr_table_entry* - the entry, nullptr if there's
+ *          no attribute table or no attribute of the handle
+ */
+const pldm_bios_attr_table_entry*
+    findAttrEntry(AttributeHandle attrHandle,
+                  const BIOSTable& BIOSAttributeTable)
+{
+    static std::shared_ptr<const Table> indexed;
+    static AttributeHandle first = 0;
+    static std::vector<const pldm_bios_attr_table_entry*> index;
+
+    auto table = BIOSAttributeTable.get();
+    if (!table)
+    {
+        return nullptr;
+    }
+    if (table != indexed)
+    {
+        std::vector<const pldm_bios_attr_table_entry*> entries;
+        traverseBIOSAttrTable(
+            *table, [&entries](const struct pldm_bios_attr_table_entry* entry) {
+                entries.push_back(entry);
+            });
+        index.clear();
+        if (!entries.empty())
+        {
+            auto [low, high] = std::minmax_element(
+                entries.begin(), entries.end(),
+                [](const auto* left, const auto* right) {
+                    return left->attr_handle < right->attr_handle;
+                });
+            first = (*low)->attr_handle;
+            index.resize((*high)->attr_handle - first + 1, nullptr);
+        }
+        for (const auto* entry : entries)
+        {
+            index[entry->attr_handle - first] = entry;
+        }
+        indexed = std::move(table);
+    }
+    size_t offset = attrHandle - first;
+    if (attrHandle < first || offset >= index.size())
+    {
+        return nullptr;
+    }
+    return index[offset];
+}
+
+/** @brief Find the entries of the BIOS attribute table by attribute index,
+ *         through an index built once per attribute table, so an attribute
+ *         whose value changes is found without walking the table or looking
+ *         up its name
+ *
+ *  @param[in] BIOSAttributeTable - the attribute table
+ *  @param[in] BIOSStringTable - the string table
+ *
+ *  @return const std::vector<const pldm_bios_attr_table_entry*>& - the
+ *          entries at their attribute index, nullptr for an attribute not in
+ *          the table
+ */
+const std::vector<const pldm_bios_attr_table_entry*>&
+    findAttrEntries(const BIOSTable& BIOSAttributeTable,
+                    const BIOSTable& BIOSStringTable)
+{
+    static std::shared_ptr<const Table> indexed;
+    static std::vector<const pldm_bios_attr_table_entry*> byIndex;
+
+    auto table = BIOSAttributeTable.get();
+    if (table != indexed)
+    {
+        byIndex.clear();
+        if (table)
+        {
+            traverseBIOSAttrTable(
+                *table,
+                [&](const struct pldm_bios_attr_table_entry* entry) {
+                    auto index = getAttrIndex(
+                        findStringName(entry->string_handle, BIOSStringTable));
+                    if (!index)
+                    {
+                        return;
+                    }
+                    if (*index >= byIndex.size())
+                    {
+                        byIndex.resize(*index + 1, nullptr);
+                    }
+                    byIndex[*index] = entry;
+                });
+        }
+        indexed = std::move(table);
+    }
+    return byIndex;
+}
+
 using typeHandler = std::function<void(const BIOSTable& BIOSStringTable,
                                        Table& attributeTable)>;
 std::map<BIOSJsonName, typeHandler> attrTypeHandlers{
@@ -743,6 +1057,8 @@ Response getBIOSAttributeTable(BIOSTable& BIOSAttributeTable,
         }
         pldm::responder::utils::padAndChecksum(attributeTable);
         BIOSAttributeTable.store(attributeTable);
+        // Indexed as it's built, for the updates of the values
+        findAttrEntries(BIOSAttributeTable, BIOSStringTable);
         response.resize(sizeof(pldm_msg_hdr) +
                         PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES +
                         attributeTable.size());
@@ -790,6 +1106,20 @@ const std::map<AttrType, AttrValTableEntryConstructHandler>
          bios_type_integer::constructAttrValueEntry},
     };
 
+using AttrValSetHandler = std::function<uint8_t(
+    const pldm_bios_attr_table_entry* attrTableEntry,
+    const pldm_bios_attr_val_table_entry* attrValueEntry, size_t length,
+    const std::string& attrName, const BIOSTable& BIOSStringTable)>;
+
+/** @brief Setters of the current values by attribute type, read only types
+ *         have none
+ */
+const std::map<AttrType, AttrValSetHandler> AttrValSetMap{
+    {PLDM_BIOS_STRING, bios_type_string::setAttrValue},
+    {PLDM_BIOS_ENUMERATION, bios_type_enum::setAttrValue},
+    {PLDM_BIOS_INTEGER, bios_type_integer::setAttrValue},
+};
+
 void constructAttrValueTableEntry(
     const struct pldm_bios_attr_table_entry* attrEntry,
     const BIOSTable& BIOSStringTable, Table& attributeValueTable)
@@ -806,6 +1136,37 @@ void constructAttrValueTableEntry(
         attrEntry, attrName, BIOSStringTable, attributeValueTable);
 }
 
+/** @brief Build the attribute value table from the current values of the
+ *         attributes. The D-Bus properties they're mapped to are read first,
+ *         each D-Bus object once and all of them concurrently, rather than
+ *         with a call per attribute.
+ *
+ *  @param[in] BIOSAttributeTable - the attribute table
+ *  @param[in] BIOSStringTable - the string table
+ *
+ *  @return Table - the table padded and checksummed, empty if no attribute
+ *          has a value
+ */
+Table buildAttrValueTable(const BIOSTable& BIOSAttributeTable,
+                          const BIOSTable& BIOSStringTable)
+{
+    fetchProperties(std::chrono::milliseconds(DBUS_GET_TIMEOUT_MS));
+
+    Table attributeValueTable;
+    traverseBIOSAttrTable(
+        *BIOSAttributeTable.get(),
+        [&BIOSStringTable, &attributeValueTable](
+            const struct pldm_bios_attr_table_entry* tableEntry) {
+            constructAttrValueTableEntry(tableEntry, BIOSStringTable,
+                                         attributeValueTable);
+        });
+    if (!attributeValueTable.empty())
+    {
+        pldm::responder::utils::padAndChecksum(attributeValueTable);
+    }
+    return attributeValueTable;
+}
+
 /** @brief Construct the BIOS attribute value table
  *
  *  @param[in,out] BIOSAttributeValueTable - the attribute value table
@@ -839,21 +1200,12 @@ Response getBIOSAttributeValueTable(BIOSTable& BIOSAttributeValueTable,
         return response;
     }
 
-    Table attributeValueTable;
-    Table attributeTable;
-    BIOSAttributeTable.load(attributeTable);
-    traverseBIOSAttrTable(
-        attributeTable,
-        [&BIOSStringTable, &attributeValueTable](
-            const struct pldm_bios_attr_table_entry* tableEntry) {
-            constructAttrValueTableEntry(tableEntry, BIOSStringTable,
-                                         attributeValueTable);
-        });
+    auto attributeValueTable =
+        buildAttrValueTable(BIOSAttributeTable, BIOSStringTable);
     if (attributeValueTable.empty())
     {
         return CmdHandler::ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
     }
-    pldm::responder::utils::padAndChecksum(attributeValueTable);
     BIOSAttributeValueTable.store(attributeValueTable);
 
     response.resize(sizeof(pldm_msg_hdr) + PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES +
@@ -872,9 +1224,68 @@ Response getBIOSAttributeValueTable(BIOSTable& BIOSAttributeValueTable,
 
 Response Handler::getBIOSTable(const pldm_msg* request, size_t payloadLength)
 {
-    fs::create_directory(BIOS_TABLES_DIR);
-    auto response = internal::buildBIOSTables(request, payloadLength,
-                                              BIOS_JSONS_DIR, BIOS_TABLES_DIR);
+    uint32_t transferHandle{};
+    uint8_t transferOpFlag{};
+    uint8_t tableType{};
+
+    auto rc = decode_get_bios_table_req(request, payloadLength, &transferHandle,
+                                        &transferOpFlag, &tableType);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+
+    transfer::Part part;
+    rc = getTablePart(
+        request, tableType, transferHandle, transferOpFlag,
+        [request, payloadLength,
+         tableType](std::shared_ptr<const transfer::Table>& table) {
+            auto file = tableFiles.find(tableType);
+            if (file != tableFiles.end())
+            {
+                BIOSTable resident(
+                    (fs::path(BIOS_TABLES_DIR) / file->second).c_str(),
+                    hashConfig(BIOS_JSONS_DIR));
+                if (!resident.isEmpty())
+                {
+                    table = resident.get();
+                    return static_cast<uint8_t>(PLDM_SUCCESS);
+                }
+            }
+
+            // Not built yet. The builder answers with a whole GetBIOSTable
+            // response, the table in it is the snapshot sent in parts.
+            auto whole = internal::buildBIOSTables(
+                request, payloadLength, BIOS_JSONS_DIR, BIOS_TABLES_DIR);
+            auto wholePtr = reinterpret_cast<const pldm_msg*>(whole.data());
+            if (wholePtr->payload[0] != PLDM_SUCCESS)
+            {
+                return wholePtr->payload[0];
+            }
+            table = std::make_shared<const transfer::Table>(
+                whole.begin() + sizeof(pldm_msg_hdr) +
+                    PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES,
+                whole.end());
+            return static_cast<uint8_t>(PLDM_SUCCESS);
+        },
+        part);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+
+    Response response(sizeof(pldm_msg_hdr) +
+                          PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES + part.length,
+                      0);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    rc = encode_get_bios_table_resp(
+        request->hdr.instance_id, PLDM_SUCCESS, part.nextTransferHandle,
+        part.transferFlag, const_cast<uint8_t*>(part.data), response.size(),
+        responsePtr);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
 
     return response;
 }
@@ -894,59 +1305,46 @@ Response Handler::getBIOSAttributeCurrentValueByHandle(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
-    fs::path tablesPath(BIOS_TABLES_DIR);
-    auto stringTablePath = tablesPath / stringTableFile;
-    BIOSTable BIOSStringTable(stringTablePath.c_str());
-    auto attrTablePath = tablesPath / attrTableFile;
-    BIOSTable BIOSAttributeTable(attrTablePath.c_str());
-    if (BIOSAttributeTable.isEmpty() || BIOSStringTable.isEmpty())
+    // Hosts poll attributes one at a time, so the value is looked up in the
+    // resident table by handle and nothing else is touched
+    static BIOSTable BIOSAttributeValueTable(
+        (fs::path(BIOS_TABLES_DIR) / attrValTableFile).c_str(),
+        hashConfig(BIOS_JSONS_DIR));
+    auto value = BIOSAttributeValueTable.findAttrValue(attributeHandle);
+    if (!value && BIOSAttributeValueTable.isEmpty())
     {
-        return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
-    }
-
-    auto attrValueTablePath = tablesPath / attrValTableFile;
-    BIOSTable BIOSAttributeValueTable(attrValueTablePath.c_str());
-
-    if (BIOSAttributeValueTable.isEmpty())
-    {
-        Table attributeValueTable;
-        Table attributeTable;
-        BIOSAttributeTable.load(attributeTable);
-        traverseBIOSAttrTable(
-            attributeTable,
-            [&BIOSStringTable, &attributeValueTable](
-                const struct pldm_bios_attr_table_entry* tableEntry) {
-                constructAttrValueTableEntry(tableEntry, BIOSStringTable,
-                                             attributeValueTable);
-            });
+        fs::path tablesPath(BIOS_TABLES_DIR);
+        auto inputsHash = hashConfig(BIOS_JSONS_DIR);
+        BIOSTable BIOSStringTable((tablesPath / stringTableFile).c_str(),
+                                  inputsHash);
+        BIOSTable BIOSAttributeTable((tablesPath / attrTableFile).c_str(),
+                                     inputsHash);
+        if (BIOSAttributeTable.isEmpty() || BIOSStringTable.isEmpty())
+        {
+            return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
+        }
+        auto attributeValueTable =
+            buildAttrValueTable(BIOSAttributeTable, BIOSStringTable);
         if (attributeValueTable.empty())
         {
             return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
         }
-        pldm::responder::utils::padAndChecksum(attributeValueTable);
         BIOSAttributeValueTable.store(attributeValueTable);
+        value = BIOSAttributeValueTable.findAttrValue(attributeHandle);
     }
-
-    Response table;
-    BIOSAttributeValueTable.load(table);
-
-    auto entry = pldm_bios_table_attr_value_find_by_handle(
-        table.data(), table.size(), attributeHandle);
-    if (entry == nullptr)
+    if (!value)
     {
         return ccOnlyResponse(request, PLDM_INVALID_BIOS_ATTR_HANDLE);
     }
 
-    auto valueLength = pldm_bios_table_attr_value_entry_value_length(entry);
-    auto valuePtr = pldm_bios_table_attr_value_entry_value(entry);
     Response response(sizeof(pldm_msg_hdr) +
                           PLDM_GET_BIOS_ATTR_CURR_VAL_BY_HANDLE_MIN_RESP_BYTES +
-                          valueLength,
+                          value->size(),
                       0);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     rc = encode_get_bios_current_value_by_handle_resp(
-        request->hdr.instance_id, PLDM_SUCCESS, 0, PLDM_START_AND_END, valuePtr,
-        valueLength, responsePtr);
+        request->hdr.instance_id, PLDM_SUCCESS, 0, PLDM_START_AND_END,
+        value->data(), value->size(), responsePtr);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
@@ -955,9 +1353,169 @@ Response Handler::getBIOSAttributeCurrentValueByHandle(const pldm_msg* request,
     return response;
 }
 
+Response Handler::setBIOSAttributeCurrentValue(const pldm_msg* request,
+                                               size_t payloadLength)
+{
+    return internal::setBIOSAttributeCurrentValue(
+        request, payloadLength, BIOS_JSONS_DIR, BIOS_TABLES_DIR);
+}
+
 namespace internal
 {
 
+Response setBIOSAttributeCurrentValue(const pldm_msg* request,
+                                      size_t payloadLength,
+                                      const char* biosJsonDir,
+                                      const char* biosTablePath)
+{
+    uint32_t transferHandle{};
+    uint8_t transferFlag{};
+    size_t length = 0;
+    Table entry(payloadLength);
+    auto rc = decode_set_bios_attribute_current_value_req(
+        request, payloadLength, &transferHandle, &transferFlag, entry.data(),
+        &length);
+    if (rc != PLDM_SUCCESS)
+    {
+        return CmdHandler::ccOnlyResponse(request, rc);
+    }
+    // An attribute value entry is small enough to come in one part
+    if (transferFlag != PLDM_START_AND_END)
+    {
+        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+    }
+    if (length < sizeof(pldm_bios_attr_val_table_entry) - 1)
+    {
+        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+    }
+    entry.resize(length);
+
+    if (setupConfig(biosJsonDir) != 0)
+    {
+        return CmdHandler::ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
+    }
+    fs::path tablesPath(biosTablePath);
+    auto inputsHash = hashConfig(biosJsonDir);
+    BIOSTable BIOSStringTable((tablesPath / stringTableFile).c_str(),
+                              inputsHash);
+    BIOSTable BIOSAttributeTable((tablesPath / attrTableFile).c_str(),
+                                 inputsHash);
+    if (BIOSAttributeTable.isEmpty() || BIOSStringTable.isEmpty())
+    {
+        return CmdHandler::ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
+    }
+
+    auto attrValueEntry =
+        reinterpret_cast<const pldm_bios_attr_val_table_entry*>(entry.data());
+    auto attrTableEntry = findAttrEntry(
+        pldm_bios_table_attr_value_entry_decode_handle(attrValueEntry),
+        BIOSAttributeTable);
+    if (attrTableEntry == nullptr)
+    {
+        return CmdHandler::ccOnlyResponse(request,
+                                          PLDM_INVALID_BIOS_ATTR_HANDLE);
+    }
+    auto setter = AttrValSetMap.find(attrTableEntry->attr_type);
+    if (attrValueEntry->attr_type != attrTableEntry->attr_type ||
+        setter == AttrValSetMap.end())
+    {
+        // Of another type, or read only
+        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+    }
+    auto attrName =
+        findStringName(attrTableEntry->string_handle, BIOSStringTable);
+
+    try
+    {
+        rc = setter->second(attrTableEntry, attrValueEntry, entry.size(),
+                            attrName, BIOSStringTable);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        rc = PLDM_ERROR_INVALID_DATA;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to set BIOS attribute, NAME=" << attrName
+                  << " ERROR=" << e.what() << "\n";
+        rc = PLDM_ERROR;
+    }
+    if (rc != PLDM_SUCCESS)
+    {
+        return CmdHandler::ccOnlyResponse(request, rc);
+    }
+
+    // The entry is valid, so it replaces the old one as it is
+    BIOSTable BIOSAttributeValueTable((tablesPath / attrValTableFile).c_str(),
+                                      inputsHash);
+    if (!BIOSAttributeValueTable.isEmpty() &&
+        !BIOSAttributeValueTable.updateAttrValue(entry.data(), entry.size()))
+    {
+        // Rebuilt from the values kept when it's next asked for
+        BIOSAttributeValueTable.remove();
+    }
+
+    Response response(
+        sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_ATTR_CURR_VAL_RESP_BYTES, 0);
+    rc = encode_set_bios_attribute_current_value_resp(
+        request->hdr.instance_id, PLDM_SUCCESS, 0,
+        reinterpret_cast<pldm_msg*>(response.data()));
+    if (rc != PLDM_SUCCESS)
+    {
+        return CmdHandler::ccOnlyResponse(request, rc);
+    }
+    return response;
+}
+
+void updateAttrValues(const AttrIndices& attrIndices, const char* biosJsonDir,
+                      const char* biosTablePath)
+{
+    if (attrIndices.empty())
+    {
+        return;
+    }
+
+    fs::path tablesPath(biosTablePath);
+    auto inputsHash = hashConfig(biosJsonDir);
+    BIOSTable BIOSStringTable((tablesPath / stringTableFile).c_str(),
+                              inputsHash);
+    BIOSTable BIOSAttributeTable((tablesPath / attrTableFile).c_str(),
+                                 inputsHash);
+    BIOSTable BIOSAttributeValueTable((tablesPath / attrValTableFile).c_str(),
+                                      inputsHash);
+    if (BIOSAttributeValueTable.isEmpty() || BIOSAttributeTable.isEmpty() ||
+        BIOSStringTable.isEmpty())
+    {
+        // Built from the current values when it's first asked for
+        return;
+    }
+
+    // Only the entries of the attributes that changed are encoded
+    const auto& entries = findAttrEntries(BIOSAttributeTable, BIOSStringTable);
+    bool stale = false;
+    for (auto index : attrIndices)
+    {
+        if (index >= entries.size() || !entries[index])
+        {
+            continue;
+        }
+        Table entry;
+        constructAttrValueTableEntry(entries[index], BIOSStringTable, entry);
+        if (!entry.empty() &&
+            !BIOSAttributeValueTable.updateAttrValue(entry.data(),
+                                                     entry.size()))
+        {
+            // The value couldn't be got when the table was built
+            stale = true;
+        }
+    }
+    if (stale)
+    {
+        // Rebuilt from the values kept when it's next asked for
+        BIOSAttributeValueTable.remove();
+    }
+}
+
 Response buildBIOSTables(const pldm_msg* request, size_t payloadLength,
                          const char* biosJsonDir, const char* biosTablePath)
 {
@@ -980,12 +1538,16 @@ Response buildBIOSTables(const pldm_msg* request, size_t payloadLength,
         return CmdHandler::ccOnlyResponse(request, rc);
     }
 
+    auto inputsHash = hashConfig(biosJsonDir);
     BIOSTable BIOSStringTable(
-        (std::string(biosTablePath) + "/" + stringTableFile).c_str());
+        (std::string(biosTablePath) + "/" + stringTableFile).c_str(),
+        inputsHash);
     BIOSTable BIOSAttributeTable(
-        (std::string(biosTablePath) + "/" + attrTableFile).c_str());
+        (std::string(biosTablePath) + "/" + attrTableFile).c_str(),
+        inputsHash);
     BIOSTable BIOSAttributeValueTable(
-        (std::string(biosTablePath) + "/" + attrValTableFile).c_str());
+        (std::string(biosTablePath) + "/" + attrValTableFile).c_str(),
+        inputsHash);
     switch (tableType)
     {
         case PLDM_BIOS_STRING_TABLE:
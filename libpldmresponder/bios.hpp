@@ -11,6 +11,9 @@
 #include <ctime>
 #include <functional>
 #include <map>
+#include <memory>
+#include <sdbusplus/bus/match.hpp>
+#include <string>
 #include <vector>
 
 #include "libpldm/bios.h"
@@ -47,6 +50,31 @@ namespace internal
  */
 Response buildBIOSTables(const pldm_msg* request, size_t payloadLength,
                          const char* biosJsonDir, const char* biosTablePath);
+
+/** @brief Set the current value of an attribute, writing it to the D-Bus
+ *         property the attribute is mapped to and replacing its entry in
+ *         the attribute value table
+ *
+ *  @param[in] request - Request message
+ *  @param[in] payloadLength - Request message payload length
+ *  @param[in] biosJsonDir - path to fetch the BIOS json files
+ *  @param[in] biosTablePath - path where the BIOS tables are persisted
+ *  @return Response - PLDM Response message
+ */
+Response setBIOSAttributeCurrentValue(const pldm_msg* request,
+                                      size_t payloadLength,
+                                      const char* biosJsonDir,
+                                      const char* biosTablePath);
+
+/** @brief Update attributes in the attribute value table, if it's built, to
+ *         the values of the D-Bus properties they're mapped to
+ *
+ *  @param[in] attrIndices - indices of the attributes
+ *  @param[in] biosJsonDir - path to fetch the BIOS json files
+ *  @param[in] biosTablePath - path where the BIOS tables are persisted
+ */
+void updateAttrValues(const bios_parser::AttrIndices& attrIndices,
+                      const char* biosJsonDir, const char* biosTablePath);
 } // namespace internal
 
 class Handler : public CmdHandler
@@ -78,6 +106,15 @@ class Handler : public CmdHandler
     Response getBIOSAttributeCurrentValueByHandle(const pldm_msg* request,
                                                   size_t payloadLength);
 
+    /** @brief Handler for SetBIOSAttributeCurrentValue
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request message payload length
+     *  @return Response - PLDM Response message
+     */
+    Response setBIOSAttributeCurrentValue(const pldm_msg* request,
+                                          size_t payloadLength);
+
     /** @brief Handler for SetDateTime
      *
      *  @param[in] request - Request message payload
@@ -85,6 +122,26 @@ class Handler : public CmdHandler
      *  @return Response - PLDM Response message
      */
     Response setDateTime(const pldm_msg* request, size_t payloadLength);
+
+  private:
+    /** @brief Read the D-Bus objects the BIOS attributes are mapped to and
+     *         subscribe to PropertiesChanged on them, so the attribute
+     *         values follow them without a D-Bus call per request
+     */
+    void watchAttrValues();
+
+    /** @brief Update the attribute value table from a PropertiesChanged
+     *         signal
+     *
+     *  @param[in] path - D-Bus object path the signal is from
+     *  @param[in] msg - the PropertiesChanged signal
+     */
+    void attrPropertiesChanged(const std::string& path,
+                               sdbusplus::message::message& msg);
+
+    /** @brief PropertiesChanged subscriptions of the attribute objects */
+    std::vector<std::unique_ptr<sdbusplus::bus::match::match>>
+        attrValueMatches{};
 };
 
 } // namespace bios
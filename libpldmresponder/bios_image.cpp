@@ -0,0 +1,535 @@
+#include "bios_image.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <unordered_map>
+
+namespace bios_parser
+{
+
+namespace image
+{
+
+using Json = nlohmann::json;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+constexpr char magic[8] = {'P', 'L', 'D', 'M', 'B', 'I', 'O', 'S'};
+
+const std::vector<Json> emptyJsonList{};
+const Json emptyJson{};
+
+/** @brief BIOS string types, by their names in the JSON files */
+const std::map<std::string, uint8_t> stringTypes{
+    {"Unknown", 0x00},  {"ASCII", 0x01},    {"Hex", 0x02},
+    {"UTF-8", 0x03},    {"UTF-16LE", 0x04}, {"UTF-16BE", 0x05},
+    {"Vendor Specific", 0xFF}};
+
+/** @brief Not a BIOS string type, so the attribute isn't taken */
+constexpr uint8_t wrongStringType = 0x06;
+
+/** @brief D-Bus property types, by their names in the JSON files */
+const std::map<std::string, PropertyType> propertyTypes{
+    {"bool", PropertyType::Bool},       {"uint8_t", PropertyType::Uint8},
+    {"int16_t", PropertyType::Int16},   {"uint16_t", PropertyType::Uint16},
+    {"int32_t", PropertyType::Int32},   {"uint32_t", PropertyType::Uint32},
+    {"int64_t", PropertyType::Int64},   {"uint64_t", PropertyType::Uint64},
+    {"double", PropertyType::Double},   {"string", PropertyType::String}};
+
+/** @class Builder
+ *
+ *  @brief Lays out an image from the attributes added to it
+ */
+class Builder
+{
+  public:
+    /** @brief Add a string to the string arena, once
+     *
+     *  @param[in] str - the string
+     *
+     *  @return StringRef - the string in the arena
+     */
+    StringRef intern(const std::string& str)
+    {
+        auto [it, added] = strings.emplace(
+            str, StringRef{static_cast<uint32_t>(arena.size()),
+                           static_cast<uint32_t>(str.size())});
+        if (added)
+        {
+            arena += str;
+        }
+        return it->second;
+    }
+
+    /** @brief Add the D-Bus mapping of an attribute
+     *
+     *  @param[in] entry - JSON entry of the attribute
+     *  @param[in,out] attr - the attribute
+     */
+    void addDBus(const Json& entry, Attr& attr)
+    {
+        attr.readOnly = entry.count("dbus") == 0;
+        if (attr.readOnly)
+        {
+            return;
+        }
+
+        auto dBusEntry = entry.value("dbus", emptyJson);
+        std::string objectPath = dBusEntry.value("object_path", "");
+        std::string interface = dBusEntry.value("interface", "");
+        std::string propertyName = dBusEntry.value("property_name", "");
+        if (!objectPath.empty() && !interface.empty() && !propertyName.empty())
+        {
+            attr.objectPath = intern(objectPath);
+            attr.interface = intern(interface);
+            attr.propertyName = intern(propertyName);
+        }
+        else
+        {
+            std::cerr << "Invalid dbus config, ATTRIBUTE_NAME="
+                      << string(attr.name) << " OBJPATH=" << objectPath
+                      << " INTERFACE=" << interface
+                      << " PROPERTY_NAME=" << propertyName << "\n";
+        }
+
+        if (attr.kind == static_cast<uint8_t>(AttrKind::String))
+        {
+            // A string attribute is mapped to a string property
+            attr.propertyType = static_cast<uint8_t>(PropertyType::String);
+            return;
+        }
+        std::string type = dBusEntry.value("property_type", "");
+        auto found = propertyTypes.find(type);
+        if (found == propertyTypes.end())
+        {
+            std::cerr << "Unknown D-Bus property type, TYPE=" << type << "\n";
+            return;
+        }
+        attr.propertyType = static_cast<uint8_t>(found->second);
+    }
+
+    /** @brief Add an enumeration attribute
+     *
+     *  @param[in] entry - JSON entry of the attribute
+     *  @param[in,out] attr - the attribute
+     */
+    void addEnum(const Json& entry, Attr& attr)
+    {
+        auto pvs = entry.value("possible_values", emptyJsonList);
+        auto dvs = entry.value("default_values", emptyJsonList);
+        attr.values = values.size();
+        attr.pvCount = pvs.size();
+        attr.dvCount = dvs.size();
+        for (const auto& pv : pvs)
+        {
+            values.push_back(pack(intern(pv.get<std::string>())));
+        }
+        for (const auto& dv : dvs)
+        {
+            values.push_back(pack(intern(dv.get<std::string>())));
+        }
+
+        auto type = static_cast<PropertyType>(attr.propertyType);
+        if (type == PropertyType::Unknown)
+        {
+            return;
+        }
+        auto dBusValues =
+            entry.value("dbus", emptyJson).value("property_values", emptyJson);
+        if (dBusValues.size() != pvs.size())
+        {
+            std::cerr << "D-Bus property values don't match the possible "
+                      << "values, ATTRIBUTE_NAME=" << string(attr.name) << "\n";
+            attr.propertyType = static_cast<uint8_t>(PropertyType::Unknown);
+            return;
+        }
+        for (const auto& dBusValue : dBusValues)
+        {
+            values.push_back(propertyValue(type, dBusValue));
+        }
+    }
+
+    /** @brief Add a string attribute
+     *
+     *  @param[in] entry - JSON entry of the attribute
+     *  @param[in,out] attr - the attribute
+     */
+    void addString(const Json& entry, Attr& attr)
+    {
+        std::string strType = entry.value("string_type", "Unknown");
+        auto found = stringTypes.find(strType);
+        if (found == stringTypes.end())
+        {
+            // Kept, for its name, but not taken as a string attribute
+            std::cerr << "Wrong string type, STRING_TYPE=" << strType
+                      << " ATTRIBUTE_NAME=" << string(attr.name) << "\n";
+            attr.stringType = wrongStringType;
+        }
+        else
+        {
+            attr.stringType = found->second;
+        }
+        attr.minLength = entry.value("minimum_string_length", 0);
+        attr.maxLength = entry.value("maximum_string_length", 0);
+        attr.defaultLength = entry.value("default_string_length", 0);
+        attr.defaultString = intern(entry.value("default_string", ""));
+    }
+
+    /** @brief Add an integer attribute
+     *
+     *  @param[in] entry - JSON entry of the attribute
+     *  @param[in,out] attr - the attribute
+     */
+    void addInteger(const Json& entry, Attr& attr)
+    {
+        attr.lowerBound = entry.value("lower_bound", 0);
+        attr.upperBound = entry.value("upper_bound", 0);
+        attr.scalarIncrement = entry.value("scalar_increment", 1);
+        attr.defaultValue = entry.value("default_value", 0);
+    }
+
+    /** @brief Add an attribute
+     *
+     *  @param[in] kind - the JSON file the attribute comes from
+     *  @param[in] entry - JSON entry of the attribute
+     */
+    void add(AttrKind kind, const Json& entry)
+    {
+        Attr attr{};
+        attr.kind = static_cast<uint8_t>(kind);
+        attr.name = intern(entry.value("attribute_name", ""));
+        addDBus(entry, attr);
+        switch (kind)
+        {
+            case AttrKind::Enum:
+                addEnum(entry, attr);
+                break;
+            case AttrKind::String:
+                addString(entry, attr);
+                break;
+            case AttrKind::Integer:
+                addInteger(entry, attr);
+                break;
+        }
+        attrs.push_back(attr);
+    }
+
+    /** @brief Lay out the image
+     *
+     *  @param[in] inputsHash - hash of the BIOS JSON files
+     *
+     *  @return std::vector<uint8_t> - the image
+     */
+    std::vector<uint8_t> build(uint64_t inputsHash)
+    {
+        // The first of the attributes of the same name is kept
+        auto byName = [this](const Attr& left, const Attr& right) {
+            return string(left.name) < string(right.name);
+        };
+        std::stable_sort(attrs.begin(), attrs.end(), byName);
+        attrs.erase(std::unique(attrs.begin(), attrs.end(),
+                                [this](const Attr& left, const Attr& right) {
+                                    return string(left.name) ==
+                                           string(right.name);
+                                }),
+                    attrs.end());
+
+        Header header{};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = formatVersion;
+        header.byteOrder = byteOrderMark;
+        header.inputsHash = inputsHash;
+        header.attrsOffset = sizeof(Header);
+        header.attrCount = attrs.size();
+        header.valuesOffset = header.attrsOffset + attrs.size() * sizeof(Attr);
+        header.valueCount = values.size();
+        header.stringsOffset =
+            header.valuesOffset + values.size() * sizeof(uint64_t);
+        header.stringsLength = arena.size();
+        header.length = header.stringsOffset + arena.size();
+
+        std::vector<uint8_t> bytes(header.length);
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::memcpy(bytes.data() + header.attrsOffset, attrs.data(),
+                    attrs.size() * sizeof(Attr));
+        std::memcpy(bytes.data() + header.valuesOffset, values.data(),
+                    values.size() * sizeof(uint64_t));
+        std::memcpy(bytes.data() + header.stringsOffset, arena.data(),
+                    arena.size());
+        return bytes;
+    }
+
+  private:
+    /** @brief Get a string of the string arena */
+    std::string_view string(StringRef ref) const
+    {
+        return std::string_view(arena).substr(ref.offset, ref.length);
+    }
+
+    /** @brief Encode a D-Bus property value as an enumeration value */
+    uint64_t propertyValue(PropertyType type, const Json& value)
+    {
+        switch (type)
+        {
+            case PropertyType::Bool:
+                return value.get<bool>();
+            case PropertyType::Uint8:
+            case PropertyType::Uint16:
+            case PropertyType::Uint32:
+            case PropertyType::Uint64:
+                return value.get<uint64_t>();
+            case PropertyType::Int16:
+            case PropertyType::Int32:
+            case PropertyType::Int64:
+                return static_cast<uint64_t>(value.get<int64_t>());
+            case PropertyType::Double:
+            {
+                auto number = value.get<double>();
+                uint64_t bits = 0;
+                std::memcpy(&bits, &number, sizeof(bits));
+                return bits;
+            }
+            case PropertyType::String:
+                return pack(intern(value.get<std::string>()));
+            case PropertyType::Unknown:
+                break;
+        }
+        return 0;
+    }
+
+    std::vector<Attr> attrs;
+    std::vector<uint64_t> values;
+    std::string arena;
+    std::unordered_map<std::string, StringRef> strings;
+};
+
+} // namespace
+
+std::optional<Image> Image::load(const char* path)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return std::nullopt;
+    }
+    struct stat st
+    {
+    };
+    void* addr = MAP_FAILED;
+    size_t length = 0;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        length = st.st_size;
+        addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (addr == MAP_FAILED)
+    {
+        std::cerr << "Failed to map BIOS attribute image, FILE=" << path
+                  << "\n";
+        return std::nullopt;
+    }
+
+    std::shared_ptr<const void> mapping(addr, [length](const void* addr) {
+        munmap(const_cast<void*>(addr), length);
+    });
+    Image image(std::move(mapping), static_cast<const uint8_t*>(addr),
+                length);
+    if (!image.check())
+    {
+        std::cerr << "Unusable BIOS attribute image, FILE=" << path << "\n";
+        return std::nullopt;
+    }
+    return image;
+}
+
+std::optional<Image> Image::fromBytes(std::vector<uint8_t> bytes)
+{
+    auto held = std::make_shared<const std::vector<uint8_t>>(std::move(bytes));
+    Image image(held, held->data(), held->size());
+    if (!image.check())
+    {
+        return std::nullopt;
+    }
+    return image;
+}
+
+const Attr* Image::find(std::string_view name) const
+{
+    auto first = attrs();
+    auto last = first + header().attrCount;
+    auto found = std::lower_bound(
+        first, last, name, [this](const Attr& attr, std::string_view name) {
+            return string(attr.name) < name;
+        });
+    if (found == last || string(found->name) != name)
+    {
+        return nullptr;
+    }
+    return found;
+}
+
+bool Image::check() const
+{
+    if (length < sizeof(Header))
+    {
+        return false;
+    }
+    const auto& h = header();
+    if (std::memcmp(h.magic, magic, sizeof(magic)) ||
+        h.version != formatVersion || h.byteOrder != byteOrderMark ||
+        h.length != length)
+    {
+        return false;
+    }
+
+    auto within = [this](uint64_t offset, uint64_t size) {
+        return offset <= length && size <= length - offset;
+    };
+    if (h.attrsOffset % alignof(Attr) || h.valuesOffset % alignof(uint64_t) ||
+        !within(h.attrsOffset, uint64_t(h.attrCount) * sizeof(Attr)) ||
+        !within(h.valuesOffset, uint64_t(h.valueCount) * sizeof(uint64_t)) ||
+        !within(h.stringsOffset, h.stringsLength))
+    {
+        return false;
+    }
+
+    auto inArena = [&h](StringRef ref) {
+        return ref.offset <= h.stringsLength &&
+               ref.length <= h.stringsLength - ref.offset;
+    };
+    auto valuesInArena = [this, &h, &inArena](size_t first, size_t count) {
+        if (first > h.valueCount || count > h.valueCount - first)
+        {
+            return false;
+        }
+        for (size_t i = first; i < first + count; ++i)
+        {
+            if (!inArena(unpack(value(i))))
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (size_t i = 0; i < h.attrCount; ++i)
+    {
+        const auto& attr = attrs()[i];
+        if (!inArena(attr.name) || !inArena(attr.objectPath) ||
+            !inArena(attr.interface) || !inArena(attr.propertyName) ||
+            !inArena(attr.defaultString) ||
+            attr.kind > static_cast<uint8_t>(AttrKind::Integer) ||
+            attr.propertyType > static_cast<uint8_t>(PropertyType::String))
+        {
+            return false;
+        }
+        // Sorted by name, for find()
+        if (i && !(string(attrs()[i - 1].name) < string(attr.name)))
+        {
+            return false;
+        }
+        if (attr.kind != static_cast<uint8_t>(AttrKind::Enum))
+        {
+            continue;
+        }
+        auto type = static_cast<PropertyType>(attr.propertyType);
+        size_t count = attr.pvCount + attr.dvCount;
+        if (!valuesInArena(attr.values, count) ||
+            (type != PropertyType::Unknown &&
+             !(type == PropertyType::String
+                   ? valuesInArena(attr.values + count, attr.pvCount)
+                   : attr.values + count + attr.pvCount <= h.valueCount)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t hashJsons(const char* dirPath)
+{
+    // FNV-1a over the names and contents of the BIOS JSON files present
+    constexpr uint64_t offsetBasis = 0xcbf29ce484222325;
+    constexpr uint64_t prime = 0x100000001b3;
+    uint64_t hash = offsetBasis;
+    auto add = [&hash](char c) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= prime;
+    };
+    for (auto jsonName : bIOSConfigFiles)
+    {
+        std::ifstream stream(fs::path(dirPath) / jsonName, std::ios::binary);
+        if (!stream)
+        {
+            continue;
+        }
+        for (auto c : std::string_view(jsonName))
+        {
+            add(c);
+        }
+        add('\0');
+        std::istreambuf_iterator<char> it(stream), end;
+        for (; it != end; ++it)
+        {
+            add(*it);
+        }
+    }
+    return hash;
+}
+
+std::vector<uint8_t> compile(const char* dirPath)
+{
+    Builder builder;
+    for (size_t kind = 0; kind < std::size(bIOSConfigFiles); ++kind)
+    {
+        auto filePath = fs::path(dirPath) / bIOSConfigFiles[kind];
+        std::ifstream jsonFile(filePath);
+        if (!jsonFile.is_open())
+        {
+            std::cerr << "BIOS config file does not exist, FILE="
+                      << filePath.c_str() << "\n";
+            continue;
+        }
+        auto json = Json::parse(jsonFile, nullptr, false);
+        if (json.is_discarded())
+        {
+            std::cerr << "Parsing config file failed, FILE="
+                      << filePath.c_str() << "\n";
+            continue;
+        }
+
+        for (const auto& entry : json.value("entries", emptyJsonList))
+        {
+            try
+            {
+                builder.add(static_cast<AttrKind>(kind), entry);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Invalid BIOS attribute, FILE="
+                          << filePath.c_str() << " ATTRIBUTE_NAME="
+                          << entry.value("attribute_name", "")
+                          << " ERROR=" << e.what() << "\n";
+            }
+        }
+    }
+    return builder.build(hashJsons(dirPath));
+}
+
+} // namespace image
+
+} // namespace bios_parser
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace bios_parser
+{
+
+inline constexpr auto bIOSEnumJson = "enum_attrs.json";
+inline constexpr auto bIOSStrJson = "string_attrs.json";
+inline constexpr auto bIOSIntegerJson = "integer_attrs.json";
+
+/** @brief The BIOS JSON files, in the order they're read */
+inline constexpr const char* bIOSConfigFiles[] = {bIOSEnumJson, bIOSStrJson,
+                                                  bIOSIntegerJson};
+
+/*
+ * BIOS attribute image:
+ *
+ * The BIOS JSON files compiled at build time into one file, which pldmd maps
+ * read only instead of parsing the JSON files. The compiler is built for the
+ * machine pldmd runs on, and run through the exe_wrapper of a cross build,
+ * so the image is in that machine's byte order. It's a header followed by
+ * three sections:
+ *
+ * - the attribute records, fixed size and sorted by attribute name
+ * - the values of the enumeration attributes, 64 bits each
+ * - the string arena, holding each distinct string once, referred to by
+ *   offset and length
+ *
+ * An image of another format version or byte order isn't used, and neither
+ * is one that doesn't check out, so the JSON files are parsed instead.
+ */
+namespace image
+{
+
+/** @brief Name of the image in the BIOS JSON directory */
+inline constexpr auto fileName = "bios_attrs.img";
+
+/** @brief Version of the format of the image */
+inline constexpr uint16_t formatVersion = 1;
+
+/** @brief Written in the byte order of the machine compiling the image */
+inline constexpr uint16_t byteOrderMark = 0x0102;
+
+/** @brief The BIOS JSON file an attribute comes from */
+enum class AttrKind : uint8_t
+{
+    Enum,
+    String,
+    Integer,
+};
+
+/** @brief Type of the D-Bus property an attribute is mapped to, in the order
+ *         of the alternatives of pldm::utils::PropertyValue, after Unknown
+ */
+enum class PropertyType : uint8_t
+{
+    Unknown,
+    Bool,
+    Uint8,
+    Int16,
+    Uint16,
+    Int32,
+    Uint32,
+    Int64,
+    Uint64,
+    Double,
+    String,
+};
+
+/** @struct StringRef
+ *
+ *  @brief A string in the string arena
+ */
+struct StringRef
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+/** @struct Header
+ *
+ *  @brief Header of the image
+ */
+struct Header
+{
+    char magic[8];
+    uint16_t version;
+    uint16_t byteOrder;
+    uint32_t length;      //!< Length of the image
+    uint64_t inputsHash;  //!< Hash of the BIOS JSON files compiled
+    uint32_t attrsOffset; //!< Offset of the attribute records
+    uint32_t attrCount;
+    uint32_t valuesOffset; //!< Offset of the enumeration values
+    uint32_t valueCount;
+    uint32_t stringsOffset; //!< Offset of the string arena
+    uint32_t stringsLength;
+};
+
+/** @struct Attr
+ *
+ *  @brief An attribute record, with the fields of every kind of attribute
+ *
+ *  The values of an enumeration attribute are its possible values, its
+ *  default values and the D-Bus property values of its possible values, one
+ *  after the other from the value at index values. Strings are StringRefs
+ *  packed into 64 bits, offset in the low half.
+ */
+struct Attr
+{
+    uint64_t lowerBound; //!< Integer
+    uint64_t upperBound;
+    uint64_t defaultValue;
+    StringRef name;
+    StringRef objectPath; //!< D-Bus mapping, empty if there's none
+    StringRef interface;
+    StringRef propertyName;
+    StringRef defaultString; //!< String
+    uint32_t scalarIncrement; //!< Integer
+    uint32_t values;          //!< Enumeration
+    uint16_t minLength;       //!< String
+    uint16_t maxLength;
+    uint16_t defaultLength;
+    uint8_t kind;         //!< AttrKind
+    uint8_t readOnly;     //!< No D-Bus entry in the JSON file
+    uint8_t propertyType; //!< PropertyType
+    uint8_t stringType;   //!< String
+    uint8_t pvCount;      //!< Enumeration
+    uint8_t dvCount;
+    uint8_t reserved[4];
+};
+
+static_assert(sizeof(Header) == 48 && sizeof(Attr) == 88,
+              "the image format changed");
+
+/** @brief Pack a string reference into an enumeration value
+ *
+ *  @param[in] ref - the string
+ *
+ *  @return uint64_t - the value
+ */
+inline uint64_t pack(StringRef ref)
+{
+    return ref.offset | static_cast<uint64_t>(ref.length) << 32;
+}
+
+/** @brief Unpack a string reference from an enumeration value
+ *
+ *  @param[in] value - the value
+ *
+ *  @return StringRef - the string
+ */
+inline StringRef unpack(uint64_t value)
+{
+    return {static_cast<uint32_t>(value), static_cast<uint32_t>(value >> 32)};
+}
+
+/** @class Image
+ *
+ *  @brief A BIOS attribute image, mapped from its file or held in memory
+ */
+class Image
+{
+  public:
+    /** @brief Map the image file read only
+     *
+     *  @param[in] path - the image file
+     *
+     *  @return std::optional<Image> - the image, std::nullopt if there's no
+     *          image file or it isn't a usable image
+     */
+    static std::optional<Image> load(const char* path);
+
+    /** @brief Use an image held in memory
+     *
+     *  @param[in] bytes - the image
+     *
+     *  @return std::optional<Image> - the image, std::nullopt if it isn't a
+     *          usable image
+     */
+    static std::optional<Image> fromBytes(std::vector<uint8_t> bytes);
+
+    /** @brief Get the header
+     *
+     *  @return const Header& - the header
+     */
+    const Header& header() const
+    {
+        return *reinterpret_cast<const Header*>(data);
+    }
+
+    /** @brief Get the attribute records
+     *
+     *  @return const Attr* - the records, header().attrCount of them
+     */
+    const Attr* attrs() const
+    {
+        return reinterpret_cast<const Attr*>(data + header().attrsOffset);
+    }
+
+    /** @brief Find the record of an attribute
+     *
+     *  @param[in] name - name of the attribute
+     *
+     *  @return const Attr* - the record, nullptr if there's none
+     */
+    const Attr* find(std::string_view name) const;
+
+    /** @brief Get an enumeration value
+     *
+     *  @param[in] index - index of the value
+     *
+     *  @return uint64_t - the value
+     */
+    uint64_t value(size_t index) const
+    {
+        return reinterpret_cast<const uint64_t*>(
+            data + header().valuesOffset)[index];
+    }
+
+    /** @brief Get a string of the string arena
+     *
+     *  @param[in] ref - the string
+     *
+     *  @return std::string_view - the string
+     */
+    std::string_view string(StringRef ref) const
+    {
+        return {reinterpret_cast<const char*>(data + header().stringsOffset +
+                                              ref.offset),
+                ref.length};
+    }
+
+  private:
+    Image(std::shared_ptr<const void> storage, const uint8_t* data,
+          size_t length) :
+        storage(std::move(storage)),
+        data(data), length(length)
+    {
+    }
+
+    /** @brief Check the header, that the sections are within the image and
+     *         that the records refer to strings and values within them
+     *
+     *  @return bool - true if the image is usable
+     */
+    bool check() const;
+
+    /** @brief Keeps the mapping or the bytes of the image */
+    std::shared_ptr<const void> storage;
+
+    /** @brief The image */
+    const uint8_t* data;
+
+    /** @brief Length of the image */
+    size_t length;
+};
+
+/** @brief Hash the BIOS JSON files of a directory
+ *
+ *  @param[in] dirPath - the directory
+ *
+ *  @return uint64_t - the hash, the same for as long as the files don't
+ *          change
+ */
+uint64_t hashJsons(const char* dirPath);
+
+/** @brief Compile the BIOS JSON files of a directory into an image, files
+ *         that are missing or can't be parsed are skipped
+ *
+ *  @param[in] dirPath - the directory
+ *
+ *  @return std::vector<uint8_t> - the image
+ */
+std::vector<uint8_t> compile(const char* dirPath);
+
+} // namespace image
+
+} // namespace bios_parser
@@ -0,0 +1,40 @@
+#include "bios_image.hpp"
+
+#include <fstream>
+#include <iostream>
+
+/** @brief Compile the BIOS JSON files of a directory into a BIOS attribute
+ *         image, for pldmd to map instead of parsing the JSON files
+ *
+ *  Usage: bios-image-compiler <BIOS JSON directory> <image file>
+ */
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <BIOS JSON directory> <image file>\n";
+        return 1;
+    }
+
+    using namespace bios_parser::image;
+    auto bytes = compile(argv[1]);
+    auto image = Image::fromBytes(bytes);
+    if (!image || !image->header().attrCount)
+    {
+        std::cerr << "No attribute is found in the config directory, DIR="
+                  << argv[1] << "\n";
+        return 1;
+    }
+
+    std::ofstream file(argv[2], std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    file.close();
+    if (!file)
+    {
+        std::cerr << "Failed to write BIOS attribute image, FILE=" << argv[2]
+                  << "\n";
+        return 1;
+    }
+    return 0;
+}
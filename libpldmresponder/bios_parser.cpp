@@ -2,23 +2,21 @@
 
 #include "utils.hpp"
 
+#include <cstring>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
-#include <nlohmann/json.hpp>
+#include <map>
 #include <optional>
+#include <stdexcept>
+#include <type_traits>
 
 #include "libpldm/bios_table.h"
 
 namespace bios_parser
 {
 
-using Json = nlohmann::json;
 namespace fs = std::filesystem;
 
-const std::vector<Json> emptyJsonList{};
-const Json emptyJson{};
-
 struct DBusMapping
 {
     std::string objectPath;   //!< D-Bus object path
@@ -27,283 +25,440 @@ struct DBusMapping
 };
 
 using AttrName = std::string;
-using BIOSJsonName = std::string;
-using AttrLookup = std::map<AttrName, std::optional<DBusMapping>>;
-using BIOSStringHandler =
-    std::function<int(const Json& entry, Strings& strings)>;
-using AttrLookupHandler = std::function<int(const Json& entry, AttrLookup)>;
-using typeHandler = std::function<int(const Json& entry)>;
-
-Strings BIOSStrings;
-AttrLookup BIOSAttrLookup;
 
-const Strings& getStrings()
+/** @class Registry
+ *
+ *  @brief The BIOS attributes, a record each in the BIOS attribute image.
+ *
+ *  The records are sorted by attribute name, and the position of a record is
+ *  the index of its attribute. The strings the records refer to are in the
+ *  string arena of the image, and the values of the enumeration attributes
+ *  are stored together after the records. What's only known at runtime is
+ *  kept in arrays by attribute index.
+ */
+class Registry
 {
-    return BIOSStrings;
-}
+  public:
+    /** @brief Take the attributes of a BIOS attribute image
+     *
+     *  @param[in] image - the image
+     */
+    void load(image::Image image)
+    {
+        size_t count = image.header().attrCount;
+        attrImage.emplace(std::move(image));
+        taken.assign(count, true);
+        values.assign(count, std::nullopt);
+        unreadable.assign(count, false);
+    }
 
-int parseBiosJsonFile(const fs::path& dirPath, const std::string& fileName,
-                      Json& fileData)
-{
-    int rc = 0;
+    /** @brief Get the number of attributes
+     *
+     *  @return size_t - number of attributes
+     */
+    size_t size() const
+    {
+        return values.size();
+    }
 
-    fs::path filePath = dirPath / fileName;
+    /** @brief Get the BIOS attribute image
+     *
+     *  @return const image::Image& - the image
+     */
+    const image::Image& image() const
+    {
+        return *attrImage;
+    }
 
-    std::ifstream jsonFile(filePath);
-    if (!jsonFile.is_open())
+    /** @brief Get the record of an attribute
+     *
+     *  @param[in] index - index of the attribute
+     *
+     *  @return const image::Attr& - the record
+     */
+    const image::Attr& attr(size_t index) const
     {
-        std::cerr << "BIOS config file does not exist, FILE="
-                  << filePath.c_str() << "\n";
-        rc = -1;
+        return attrImage->attrs()[index];
     }
-    else
+
+    /** @brief Get a string of the string arena
+     *
+     *  @param[in] ref - the string
+     *
+     *  @return std::string_view - the string
+     */
+    std::string_view string(image::StringRef ref) const
     {
-        fileData = Json::parse(jsonFile, nullptr, false);
-        if (fileData.is_discarded())
+        return attrImage->string(ref);
+    }
+
+    /** @brief Get a string value of an enumeration attribute
+     *
+     *  @param[in] attr - record of the attribute
+     *  @param[in] index - index of the value, the possible values come first
+     *                     and then the default values
+     *
+     *  @return std::string_view - the value
+     */
+    std::string_view enumString(const image::Attr& attr, size_t index) const
+    {
+        return string(image::unpack(attrImage->value(attr.values + index)));
+    }
+
+    /** @brief Get the index of an attribute
+     *
+     *  @param[in] name - name of the attribute
+     *  @param[in] kind - type of the attribute
+     *
+     *  @return size_t - index of the attribute
+     *
+     *  @throw std::out_of_range if there's no attribute of the name and type
+     */
+    size_t indexOf(std::string_view name, image::AttrKind kind) const
+    {
+        auto found = attrImage ? attrImage->find(name) : nullptr;
+        if (!found || found->kind != static_cast<uint8_t>(kind) ||
+            !taken[found - attrImage->attrs()])
         {
-            std::cerr << "Parsing config file failed, FILE=" << filePath.c_str()
-                      << "\n";
-            rc = -1;
+            throw std::out_of_range("No BIOS attribute of the name and type");
         }
+        return found - attrImage->attrs();
     }
 
-    return rc;
-}
+    /** @brief Find the index of an attribute of any type
+     *
+     *  @param[in] name - name of the attribute
+     *
+     *  @return std::optional<size_t> - index of the attribute, std::nullopt
+     *          if there's no attribute of the name
+     */
+    std::optional<size_t> find(std::string_view name) const
+    {
+        auto found = attrImage ? attrImage->find(name) : nullptr;
+        if (!found || !taken[found - attrImage->attrs()])
+        {
+            return std::nullopt;
+        }
+        return found - attrImage->attrs();
+    }
 
-namespace bios_enum
-{
+    /** @brief Tell whether an attribute is mapped to a D-Bus object
+     *
+     *  @param[in] index - index of the attribute
+     *  @param[in] objectPath - object path of the D-Bus object
+     *  @param[in] interface - interface of the D-Bus object, any if empty
+     *
+     *  @return bool - true if it is
+     */
+    bool mapsTo(size_t index, std::string_view objectPath,
+                std::string_view interface = {}) const
+    {
+        const auto& record = attr(index);
+        return record.objectPath.length &&
+               string(record.objectPath) == objectPath &&
+               (interface.empty() || string(record.interface) == interface);
+    }
 
-namespace internal
-{
+    /** @brief Attributes of their type, false for those that didn't check out
+     */
+    std::vector<bool> taken;
 
-using PropertyValue =
-    std::variant<bool, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t,
-                 uint64_t, double, std::string>;
-using Value = std::string;
+    /** @brief Values of the D-Bus properties the attributes are mapped to, as
+     *         far as they're known
+     */
+    std::vector<std::optional<pldm::utils::PropertyValue>> values;
 
-/** @brief Map of DBus property value to attribute value
- */
-using DbusValToValMap = std::map<PropertyValue, Value>;
+    /** @brief Attributes whose D-Bus objects the last fetchProperties
+     *         couldn't read
+     */
+    std::vector<bool> unreadable;
 
-/** @brief Map containing the DBus property value to attribute value map for the
- * BIOS enumeration type attributes
- */
-std::map<AttrName, DbusValToValMap> dbusValToValMaps;
+  private:
+    std::optional<image::Image> attrImage;
+};
 
-/** @brief Map containing the possible and the default values for the BIOS
- *         enumeration type attributes.
- */
-AttrValuesMap valueMap;
+Strings BIOSStrings;
+Registry registry;
 
-/** @brief Populate the mapping between D-Bus property value and attribute value
- *         for the BIOS enumeration attribute.
+const Strings& getStrings()
+{
+    return BIOSStrings;
+}
+
+/** @brief Get the D-Bus property an attribute is mapped to, for D-Bus calls
  *
- *  @param[in] type - type of the D-Bus property
- *  @param[in] dBusValues - json array of D-Bus property values
- *  @param[in] pv - Possible values for the BIOS enumeration attribute
+ *  @param[in] attr - record of the attribute
+ *
+ *  @return the D-Bus property
+ */
+DBusMapping getDBusMapping(const image::Attr& attr)
+{
+    return {std::string(registry.string(attr.objectPath)),
+            std::string(registry.string(attr.interface)),
+            std::string(registry.string(attr.propertyName))};
+}
+
+/** @brief Keep the value of a D-Bus property, for the attributes mapped to it
  *
+ *  @param[in] attr - record of an attribute mapped to the property
+ *  @param[in] value - the value
  */
-DbusValToValMap populateMapping(const std::string& type, const Json& dBusValues,
-                                const PossibleValues& pv)
+void keepPropertyValue(const image::Attr& attr,
+                       const pldm::utils::PropertyValue& value)
 {
-    size_t pos = 0;
-    PropertyValue value;
-    DbusValToValMap valueMap;
-    for (auto it = dBusValues.begin(); it != dBusValues.end(); ++it, ++pos)
+    auto propertyName = registry.string(attr.propertyName);
+    for (size_t i = 0; i < registry.size(); ++i)
     {
-        if (type == "uint8_t")
+        if (registry.mapsTo(i, registry.string(attr.objectPath),
+                            registry.string(attr.interface)) &&
+            registry.string(registry.attr(i).propertyName) == propertyName)
         {
-            value = static_cast<uint8_t>(it.value());
-        }
-        else if (type == "uint16_t")
-        {
-            value = static_cast<uint16_t>(it.value());
-        }
-        else if (type == "uint32_t")
-        {
-            value = static_cast<uint32_t>(it.value());
-        }
-        else if (type == "uint64_t")
-        {
-            value = static_cast<uint64_t>(it.value());
-        }
-        else if (type == "int16_t")
-        {
-            value = static_cast<int16_t>(it.value());
-        }
-        else if (type == "int32_t")
-        {
-            value = static_cast<int32_t>(it.value());
-        }
-        else if (type == "int64_t")
-        {
-            value = static_cast<int64_t>(it.value());
-        }
-        else if (type == "bool")
-        {
-            value = static_cast<bool>(it.value());
-        }
-        else if (type == "double")
-        {
-            value = static_cast<double>(it.value());
-        }
-        else if (type == "string")
-        {
-            value = static_cast<std::string>(it.value());
-        }
-        else
-        {
-            std::cerr << "Unknown D-Bus property type, TYPE=" << type.c_str()
-                      << "\n";
+            registry.values[i] = value;
         }
+    }
+}
 
-        valueMap.emplace(value, pv[pos]);
+/** @brief Get the value of the D-Bus property an attribute is mapped to,
+ *         from the values kept, or else from D-Bus
+ *
+ *  @param[in] index - index of the attribute
+ *
+ *  @return the value of the property
+ */
+const pldm::utils::PropertyValue& getPropertyValue(size_t index)
+{
+    if (registry.values[index])
+    {
+        return *registry.values[index];
+    }
+    if (registry.unreadable[index])
+    {
+        // Not asked again per attribute
+        throw std::runtime_error("D-Bus object couldn't be read");
     }
 
-    return valueMap;
+    const auto& attr = registry.attr(index);
+    auto dBusMap = getDBusMapping(attr);
+    auto value =
+        pldm::utils::DBusHandler()
+            .getDbusPropertyVariant<pldm::utils::PropertyValue>(
+                dBusMap.objectPath.c_str(), dBusMap.propertyName.c_str(),
+                dBusMap.interface.c_str());
+    keepPropertyValue(attr, value);
+    return *registry.values[index];
 }
 
-} // namespace internal
-
-int setupBIOSStrings(const Json& entry, Strings& strings)
+/** @brief Set the D-Bus property an attribute is mapped to, and keep the
+ *         value set
+ *
+ *  @param[in] index - index of the attribute
+ *  @param[in] value - the value
+ */
+void setPropertyValue(size_t index, const pldm::utils::PropertyValue& value)
 {
-    Json pvs = entry.value("possible_values", emptyJsonList);
+    const auto& attr = registry.attr(index);
+    auto dBusMap = getDBusMapping(attr);
+    std::visit(
+        [&dBusMap](const auto& propValue) {
+            using Value = std::decay_t<decltype(propValue)>;
+            pldm::utils::DBusHandler().setDbusProperty(
+                dBusMap.objectPath.c_str(), dBusMap.propertyName.c_str(),
+                dBusMap.interface.c_str(), std::variant<Value>(propValue));
+        },
+        value);
+    keepPropertyValue(attr, value);
+}
 
-    for (auto& pv : pvs)
+/** @brief Check that an attribute is mapped to D-Bus, to set it
+ *
+ *  @param[in] index - index of the attribute
+ *
+ *  @throw std::invalid_argument if it isn't
+ */
+void checkWritable(size_t index)
+{
+    if (!registry.attr(index).objectPath.length)
     {
-        strings.emplace_back(std::move(pv.get<std::string>()));
+        throw std::invalid_argument("Attribute isn't mapped to D-Bus");
     }
+}
 
-    return 0;
+/** @brief Get a D-Bus property value kept in the BIOS attribute image
+ *
+ *  @param[in] image - the image
+ *  @param[in] type - type of the D-Bus property
+ *  @param[in] value - the value in the image
+ *
+ *  @return the D-Bus property value
+ */
+pldm::utils::PropertyValue propertyValue(const image::Image& image,
+                                         image::PropertyType type,
+                                         uint64_t value)
+{
+    using image::PropertyType;
+    switch (type)
+    {
+        case PropertyType::Bool:
+            return static_cast<bool>(value);
+        case PropertyType::Uint8:
+            return static_cast<uint8_t>(value);
+        case PropertyType::Int16:
+            return static_cast<int16_t>(value);
+        case PropertyType::Uint16:
+            return static_cast<uint16_t>(value);
+        case PropertyType::Int32:
+            return static_cast<int32_t>(value);
+        case PropertyType::Uint32:
+            return static_cast<uint32_t>(value);
+        case PropertyType::Int64:
+            return static_cast<int64_t>(value);
+        case PropertyType::Double:
+        {
+            double number = 0;
+            std::memcpy(&number, &value, sizeof(number));
+            return number;
+        }
+        case PropertyType::String:
+            return std::string(image.string(image::unpack(value)));
+        default:
+            break;
+    }
+    return value;
 }
 
-int setup(const Json& entry)
+namespace bios_enum
 {
-    PossibleValues possibleValues;
-    DefaultValues defaultValues;
 
-    std::string attrName = entry.value("attribute_name", "");
-    Json pv = entry["possible_values"];
-    for (auto& val : pv)
+/** @brief Get string values of an enumeration attribute
+ *
+ *  @param[in] attr - record of the attribute
+ *  @param[in] first - index of the first value
+ *  @param[in] count - number of values
+ *
+ *  @return the values
+ */
+std::vector<std::string> getStrings(const image::Attr& attr, size_t first,
+                                    size_t count)
+{
+    std::vector<std::string> strings;
+    strings.reserve(count);
+    for (size_t i = first; i < first + count; ++i)
     {
-        possibleValues.emplace_back(std::move(val));
+        strings.emplace_back(registry.enumString(attr, i));
     }
-    Json dv = entry["default_values"];
-    for (auto& val : dv)
+    return strings;
+}
+
+/** @brief Tell whether a D-Bus property value kept in the BIOS attribute
+ *         image is the value of a property
+ *
+ *  @param[in] type - type of the D-Bus property
+ *  @param[in] value - the value in the image
+ *  @param[in] propValue - the value of the property
+ *
+ *  @return bool - true if it is
+ */
+bool matches(image::PropertyType type, uint64_t value,
+             const pldm::utils::PropertyValue& propValue)
+{
+    // The property types are in the order of the alternatives
+    if (propValue.index() + 1 != static_cast<size_t>(type))
     {
-        defaultValues.emplace_back(std::move(val));
+        return false;
     }
-    if (entry.count("dbus") != 0)
+    if (auto str = std::get_if<std::string>(&propValue))
     {
-        auto dbusEntry = entry.value("dbus", emptyJson);
-        std::string propertyType = dbusEntry.value("property_type", "");
-        Json propValues = dbusEntry["property_values"];
-        internal::dbusValToValMaps.emplace(
-            attrName, internal::populateMapping(propertyType, propValues,
-                                                possibleValues));
+        return registry.string(image::unpack(value)) == *str;
     }
-    // Defaulting all the types of attributes to BIOSEnumeration
-    internal::valueMap.emplace(std::move(attrName),
-                               std::make_tuple(entry.count("dbus") == 0,
-                                               std::move(possibleValues),
-                                               std::move(defaultValues)));
-    return 0;
+    return propertyValue(registry.image(), type, value) == propValue;
 }
 
-const AttrValuesMap& getValues()
+AttrValuesMap getValues()
 {
-    return internal::valueMap;
+    AttrValuesMap valueMap;
+    for (size_t i = 0; i < registry.size(); ++i)
+    {
+        const auto& attr = registry.attr(i);
+        if (attr.kind != static_cast<uint8_t>(image::AttrKind::Enum))
+        {
+            continue;
+        }
+        // Defaulting all the types of attributes to BIOSEnumeration
+        valueMap.emplace(
+            registry.string(attr.name),
+            std::make_tuple(attr.readOnly != 0,
+                            getStrings(attr, 0, attr.pvCount),
+                            getStrings(attr, attr.pvCount, attr.dvCount)));
+    }
+    return valueMap;
 }
 
 CurrentValues getAttrValue(const AttrName& attrName)
 {
-    const auto& dBusMap = BIOSAttrLookup.at(attrName);
-    CurrentValues currentValues;
-    internal::PropertyValue propValue;
-
-    if (dBusMap == std::nullopt)
+    auto index = registry.indexOf(attrName, image::AttrKind::Enum);
+    const auto& attr = registry.attr(index);
+    if (!attr.objectPath.length)
     {
-        const auto& valueEntry = internal::valueMap.at(attrName);
-        const auto& [readOnly, possibleValues, currentValues] = valueEntry;
-        return currentValues;
+        return getStrings(attr, attr.pvCount, attr.dvCount);
     }
 
-    const auto& dbusValToValMap = internal::dbusValToValMaps.at(attrName);
-    propValue =
-        pldm::utils::DBusHandler()
-            .getDbusPropertyVariant<internal::PropertyValue>(
-                dBusMap->objectPath.c_str(), dBusMap->propertyName.c_str(),
-                dBusMap->interface.c_str());
-    auto iter = dbusValToValMap.find(propValue);
-    if (iter != dbusValToValMap.end())
+    CurrentValues currentValues;
+    const auto& propValue = getPropertyValue(index);
+    auto type = static_cast<image::PropertyType>(attr.propertyType);
+    auto dBusValues = attr.values + attr.pvCount + attr.dvCount;
+    for (size_t i = 0; type != image::PropertyType::Unknown && i < attr.pvCount;
+         ++i)
     {
-        currentValues.push_back(iter->second);
+        if (matches(type, registry.image().value(dBusValues + i), propValue))
+        {
+            currentValues.emplace_back(registry.enumString(attr, i));
+            break;
+        }
     }
 
     return currentValues;
 }
 
-} // namespace bios_enum
-
-namespace bios_string
+void setAttrValue(const AttrName& attrName, const std::string& value)
 {
+    auto index = registry.indexOf(attrName, image::AttrKind::Enum);
+    checkWritable(index);
+    const auto& attr = registry.attr(index);
+    auto type = static_cast<image::PropertyType>(attr.propertyType);
+    auto dBusValues = attr.values + attr.pvCount + attr.dvCount;
+    for (size_t i = 0; type != image::PropertyType::Unknown && i < attr.pvCount;
+         ++i)
+    {
+        if (registry.enumString(attr, i) == value)
+        {
+            setPropertyValue(
+                index, propertyValue(registry.image(), type,
+                                     registry.image().value(dBusValues + i)));
+            return;
+        }
+    }
+    throw std::invalid_argument("No D-Bus property value for the value");
+}
 
-/** @brief BIOS string types
- */
-enum BiosStringEncoding
-{
-    UNKNOWN = 0x00,
-    ASCII = 0x01,
-    HEX = 0x02,
-    UTF_8 = 0x03,
-    UTF_16LE = 0x04,
-    UTF_16BE = 0x05,
-    VENDOR_SPECIFIC = 0xFF
-};
-
-const std::map<std::string, uint8_t> strTypeMap{
-    {"Unknown", UNKNOWN},
-    {"ASCII", ASCII},
-    {"Hex", HEX},
-    {"UTF-8", UTF_8},
-    {"UTF-16LE", UTF_16LE},
-    {"UTF-16LE", UTF_16LE},
-    {"Vendor Specific", VENDOR_SPECIFIC}};
+} // namespace bios_enum
 
-namespace internal
+namespace bios_string
 {
 
-/** @brief Map containing the possible and the default values for the BIOS
- *         string type attributes.
+/** @brief Check a string attribute
+ *
+ *  @param[in] attr - record of the attribute
+ *
+ *  @return bool - true if it checks out
  */
-AttrValuesMap valueMap;
-
-} // namespace internal
-
-int setup(const Json& jsonEntry)
+bool check(const image::Attr& attr)
 {
-
-    std::string attr = jsonEntry.value("attribute_name", "");
-    // Transfer string type from string to enum
-    std::string strTypeTmp = jsonEntry.value("string_type", "Unknown");
-    auto iter = strTypeMap.find(strTypeTmp);
-    if (iter == strTypeMap.end())
-    {
-        std::cerr << "Wrong string type, STRING_TYPE=" << strTypeTmp.c_str()
-                  << " ATTRIBUTE_NAME=" << attr.c_str() << "\n";
-        return -1;
-    }
-    uint8_t strType = iter->second;
-
-    uint16_t minStrLen = jsonEntry.value("minimum_string_length", 0);
-    uint16_t maxStrLen = jsonEntry.value("maximum_string_length", 0);
-    uint16_t defaultStrLen = jsonEntry.value("default_string_length", 0);
-    std::string defaultStr = jsonEntry.value("default_string", "");
-
+    std::string defaultStr(registry.string(attr.defaultString));
     pldm_bios_table_attr_entry_string_info info = {
         0,     /* name handle */
         false, /* read only */
-        strType, minStrLen, maxStrLen, defaultStrLen, defaultStr.data(),
+        attr.stringType, attr.minLength, attr.maxLength, attr.defaultLength,
+        defaultStr.data(),
     };
 
     const char* errmsg;
@@ -311,42 +466,54 @@ int setup(const Json& jsonEntry)
     if (rc != PLDM_SUCCESS)
     {
         std::cerr << "Wrong filed for string attribute, ATTRIBUTE_NAME="
-                  << attr.c_str() << " ERRMSG=" << errmsg
-                  << " MINIMUM_STRING_LENGTH=" << minStrLen
-                  << " MAXIMUM_STRING_LENGTH=" << maxStrLen
-                  << " DEFAULT_STRING_LENGTH=" << defaultStrLen
+                  << registry.string(attr.name) << " ERRMSG=" << errmsg
+                  << " MINIMUM_STRING_LENGTH=" << attr.minLength
+                  << " MAXIMUM_STRING_LENGTH=" << attr.maxLength
+                  << " DEFAULT_STRING_LENGTH=" << attr.defaultLength
                   << " DEFAULT_STRING=" << defaultStr.data() << "\n";
-        return -1;
+        return false;
     }
-
-    // Defaulting all the types of attributes to BIOSString
-    internal::valueMap.emplace(
-        std::move(attr),
-        std::make_tuple(jsonEntry.count("dbus") == 0, strType, minStrLen,
-                        maxStrLen, defaultStrLen, std::move(defaultStr)));
-
-    return 0;
+    return true;
 }
 
-const AttrValuesMap& getValues()
+AttrValuesMap getValues()
 {
-    return internal::valueMap;
+    AttrValuesMap valueMap;
+    for (size_t i = 0; i < registry.size(); ++i)
+    {
+        const auto& attr = registry.attr(i);
+        if (attr.kind != static_cast<uint8_t>(image::AttrKind::String) ||
+            !registry.taken[i])
+        {
+            continue;
+        }
+        // Defaulting all the types of attributes to BIOSString
+        valueMap.emplace(
+            registry.string(attr.name),
+            std::make_tuple(attr.readOnly != 0, attr.stringType,
+                            attr.minLength, attr.maxLength, attr.defaultLength,
+                            std::string(registry.string(attr.defaultString))));
+    }
+    return valueMap;
 }
 
 std::string getAttrValue(const AttrName& attrName)
 {
-    const auto& dBusMap = BIOSAttrLookup.at(attrName);
-    std::variant<std::string> propValue;
-
-    if (dBusMap == std::nullopt)
+    auto index = registry.indexOf(attrName, image::AttrKind::String);
+    const auto& attr = registry.attr(index);
+    if (!attr.objectPath.length)
     { // return default string
-        const auto& valueEntry = internal::valueMap.at(attrName);
-        return std::get<DefaultStr>(valueEntry);
+        return std::string(registry.string(attr.defaultString));
     }
 
-    return pldm::utils::DBusHandler().getDbusProperty<std::string>(
-        dBusMap->objectPath.c_str(), dBusMap->propertyName.c_str(),
-        dBusMap->interface.c_str());
+    return std::get<std::string>(getPropertyValue(index));
+}
+
+void setAttrValue(const AttrName& attrName, const std::string& value)
+{
+    auto index = registry.indexOf(attrName, image::AttrKind::String);
+    checkWritable(index);
+    setPropertyValue(index, value);
 }
 
 } // namespace bios_string
@@ -354,165 +521,299 @@ std::string getAttrValue(const AttrName& attrName)
 namespace bios_integer
 {
 
-AttrValuesMap valueMap;
-
-int setup(const Json& jsonEntry)
+/** @brief Convert an attribute value to the type of the D-Bus property
+ *
+ *  @param[in] type - type of the D-Bus property
+ *  @param[in] value - the attribute value
+ *
+ *  @return the D-Bus property value
+ */
+pldm::utils::PropertyValue toPropertyValue(image::PropertyType type,
+                                           uint64_t value)
 {
+    switch (type)
+    {
+        case image::PropertyType::Uint8:
+            return static_cast<uint8_t>(value);
+        case image::PropertyType::Uint16:
+            return static_cast<uint16_t>(value);
+        case image::PropertyType::Uint32:
+            return static_cast<uint32_t>(value);
+        case image::PropertyType::Int16:
+            return static_cast<int16_t>(value);
+        case image::PropertyType::Int32:
+            return static_cast<int32_t>(value);
+        case image::PropertyType::Int64:
+            return static_cast<int64_t>(value);
+        default:
+            break;
+    }
+    return value;
+}
 
-    std::string attr = jsonEntry.value("attribute_name", "");
-    // Transfer string type from string to enum
-
-    uint64_t lowerBound = jsonEntry.value("lower_bound", 0);
-    uint64_t upperBound = jsonEntry.value("upper_bound", 0);
-    uint32_t scalarIncrement = jsonEntry.value("scalar_increment", 1);
-    uint64_t defaultValue = jsonEntry.value("default_value", 0);
+/** @brief Check an integer attribute
+ *
+ *  @param[in] attr - record of the attribute
+ *
+ *  @return bool - true if it checks out
+ */
+bool check(const image::Attr& attr)
+{
     pldm_bios_table_attr_entry_integer_info info = {
         0,     /* name handle*/
         false, /* read only */
-        lowerBound, upperBound, scalarIncrement, defaultValue,
+        attr.lowerBound,      attr.upperBound,
+        attr.scalarIncrement, attr.defaultValue,
     };
     const char* errmsg = nullptr;
     auto rc = pldm_bios_table_attr_entry_integer_info_check(&info, &errmsg);
     if (rc != PLDM_SUCCESS)
     {
         std::cerr << "Wrong filed for integer attribute, ATTRIBUTE_NAME="
-                  << attr.c_str() << " ERRMSG=" << errmsg
-                  << " LOWER_BOUND=" << lowerBound
-                  << " UPPER_BOUND=" << upperBound
-                  << " DEFAULT_VALUE=" << defaultValue
-                  << " SCALAR_INCREMENT=" << scalarIncrement << "\n";
-        return -1;
+                  << registry.string(attr.name) << " ERRMSG=" << errmsg
+                  << " LOWER_BOUND=" << attr.lowerBound
+                  << " UPPER_BOUND=" << attr.upperBound
+                  << " DEFAULT_VALUE=" << attr.defaultValue
+                  << " SCALAR_INCREMENT=" << attr.scalarIncrement << "\n";
+        return false;
     }
-
-    valueMap.emplace(std::move(attr),
-                     std::make_tuple(jsonEntry.count("dbus") == 0, lowerBound,
-                                     upperBound, scalarIncrement,
-                                     defaultValue));
-
-    return 0;
+    return true;
 }
 
-const AttrValuesMap& getValues()
+AttrValuesMap getValues()
 {
+    AttrValuesMap valueMap;
+    for (size_t i = 0; i < registry.size(); ++i)
+    {
+        const auto& attr = registry.attr(i);
+        if (attr.kind != static_cast<uint8_t>(image::AttrKind::Integer) ||
+            !registry.taken[i])
+        {
+            continue;
+        }
+        valueMap.emplace(registry.string(attr.name),
+                         std::make_tuple(attr.readOnly != 0, attr.lowerBound,
+                                         attr.upperBound, attr.scalarIncrement,
+                                         attr.defaultValue));
+    }
     return valueMap;
 }
 
 uint64_t getAttrValue(const AttrName& attrName)
 {
-    const auto& dBusMap = BIOSAttrLookup.at(attrName);
-    std::variant<std::string> propValue;
-
-    if (dBusMap == std::nullopt)
-    { // return default string
-        const auto& valueEntry = valueMap.at(attrName);
-        return std::get<AttrDefaultValue>(valueEntry);
+    auto index = registry.indexOf(attrName, image::AttrKind::Integer);
+    const auto& attr = registry.attr(index);
+    if (!attr.objectPath.length)
+    { // return default value
+        return attr.defaultValue;
     }
 
-    return pldm::utils::DBusHandler().getDbusProperty<uint64_t>(
-        dBusMap->objectPath.c_str(), dBusMap->propertyName.c_str(),
-        dBusMap->interface.c_str());
+    // Any integer property will do, whatever its width
+    return std::visit(
+        [](const auto& value) -> uint64_t {
+            using Value = std::decay_t<decltype(value)>;
+            if constexpr (std::is_integral_v<Value>)
+            {
+                return value;
+            }
+            else
+            {
+                throw std::invalid_argument("Not an integer property");
+            }
+        },
+        getPropertyValue(index));
 }
 
-} // namespace bios_integer
+void setAttrValue(const AttrName& attrName, uint64_t value)
+{
+    auto index = registry.indexOf(attrName, image::AttrKind::Integer);
+    checkWritable(index);
+    auto type =
+        static_cast<image::PropertyType>(registry.attr(index).propertyType);
+    setPropertyValue(index, toPropertyValue(type, value));
+}
 
-const std::map<BIOSJsonName, BIOSStringHandler> BIOSStringHandlers = {
-    {bIOSEnumJson, bios_enum::setupBIOSStrings},
-};
+} // namespace bios_integer
 
-const std::map<BIOSJsonName, typeHandler> BIOSTypeHandlers = {
-    {bIOSEnumJson, bios_enum::setup},
-    {bIOSStrJson, bios_string::setup},
-    {bIOSIntegerJson, bios_integer::setup},
-};
+/** @brief Set up the BIOS strings and the attributes of a BIOS attribute
+ *         image
+ *
+ *  @param[in] image - the image
+ */
+void setupAttrs(image::Image image)
+{
+    registry.load(std::move(image));
+    for (size_t i = 0; i < registry.size(); ++i)
+    {
+        const auto& attr = registry.attr(i);
+        BIOSStrings.emplace_back(registry.string(attr.name));
+        switch (static_cast<image::AttrKind>(attr.kind))
+        {
+            case image::AttrKind::Enum:
+                for (size_t pv = 0; pv < attr.pvCount; ++pv)
+                {
+                    BIOSStrings.emplace_back(registry.enumString(attr, pv));
+                }
+                break;
+            case image::AttrKind::String:
+                registry.taken[i] = bios_string::check(attr);
+                break;
+            case image::AttrKind::Integer:
+                registry.taken[i] = bios_integer::check(attr);
+                break;
+        }
+    }
+}
 
-void setupBIOSStrings(const BIOSJsonName& jsonName, const Json& entry,
-                      Strings& strings)
+int setupConfig(const char* dirPath)
 {
-    strings.emplace_back(entry.value("attribute_name", ""));
-    auto iter = BIOSStringHandlers.find(jsonName);
-    if (iter != BIOSStringHandlers.end())
+    if (!BIOSStrings.empty() && registry.size())
+    {
+        return 0;
+    }
+
+    fs::path dir(dirPath);
+    if (!fs::exists(dir) || fs::is_empty(dir))
+    {
+        std::cerr << "BIOS config directory does not exist or empty, DIR="
+                  << dirPath << "\n";
+        return -1;
+    }
+    auto image = image::Image::load((dir / image::fileName).c_str());
+    if (!image)
+    {
+        // No image was built for the directory, so the JSON files are
+        // compiled here
+        image = image::Image::fromBytes(image::compile(dirPath));
+    }
+    if (image)
     {
-        iter->second(entry, strings);
+        setupAttrs(std::move(*image));
     }
+    if (BIOSStrings.empty())
+    { // means there is no attribute
+        std::cerr << "No attribute is found in the config directory, DIR="
+                  << dirPath << "\n";
+        return -1;
+    }
+    return 0;
 }
 
-void setupBIOSAttrLookup(const Json& jsonEntry, AttrLookup& lookup)
+uint64_t hashConfig(const char* dirPath)
 {
-    std::optional<DBusMapping> dBusMap;
-    std::string attrName = jsonEntry.value("attribute_name", "");
+    static std::map<std::string, uint64_t> hashes;
+    auto found = hashes.find(dirPath);
+    if (found != hashes.end())
+    {
+        return found->second;
+    }
+
+    // An image is used instead of the JSON files, so it's what counts
+    auto image =
+        image::Image::load((fs::path(dirPath) / image::fileName).c_str());
+    auto hash = image ? image->header().inputsHash : image::hashJsons(dirPath);
+    hashes.emplace(dirPath, hash);
+    return hash;
+}
 
-    if (jsonEntry.count("dbus") != 0)
+std::set<DBusObject> getDBusObjects()
+{
+    std::set<DBusObject> objects;
+    for (size_t i = 0; i < registry.size(); ++i)
     {
-        auto dBusEntry = jsonEntry.value("dbus", emptyJson);
-        std::string objectPath = dBusEntry.value("object_path", "");
-        std::string interface = dBusEntry.value("interface", "");
-        std::string propertyName = dBusEntry.value("property_name", "");
-        if (!objectPath.empty() && !interface.empty() && !propertyName.empty())
+        const auto& attr = registry.attr(i);
+        if (attr.objectPath.length)
         {
-            dBusMap = std::optional<DBusMapping>(
-                {objectPath, interface, propertyName});
-        }
-        else
-        {
-            std::cerr << "Invalid dbus config, OBJPATH="
-                      << dBusMap->objectPath.c_str()
-                      << " INTERFACE=" << dBusMap->interface.c_str()
-                      << " PROPERTY_NAME=" << dBusMap->propertyName.c_str()
-                      << "\n";
+            objects.emplace(registry.string(attr.objectPath),
+                            registry.string(attr.interface));
         }
     }
-    lookup.emplace(attrName, dBusMap);
+    return objects;
 }
 
-int setupBIOSType(const BIOSJsonName& jsonName, const Json& entry)
+std::optional<size_t> getAttrIndex(const std::string& attrName)
 {
-    auto iter = BIOSTypeHandlers.find(jsonName);
-    if (iter != BIOSTypeHandlers.end())
+    return registry.find(attrName);
+}
+
+AttrIndices updateProperties(const DBusObject& object,
+                             const pldm::utils::PropertyMap& properties)
+{
+    AttrIndices attrIndices;
+    for (size_t i = 0; i < registry.size(); ++i)
     {
-        iter->second(entry);
+        if (!registry.mapsTo(i, object.first, object.second))
+        {
+            continue;
+        }
+        registry.unreadable[i] = false;
+
+        const auto& attr = registry.attr(i);
+        auto property =
+            properties.find(std::string(registry.string(attr.propertyName)));
+        if (property != properties.end())
+        {
+            registry.values[i] = property->second;
+            attrIndices.push_back(i);
+        }
     }
-    return 0;
+    return attrIndices;
 }
 
-const std::vector<BIOSJsonName> BIOSConfigFiles = {bIOSEnumJson, bIOSStrJson,
-                                                   bIOSIntegerJson};
-
-int setupConfig(const char* dirPath)
+void fetchProperties(std::chrono::microseconds timeout)
 {
-    if (!BIOSStrings.empty() && !BIOSAttrLookup.empty())
+    registry.unreadable.assign(registry.size(), false);
+    std::set<DBusObject> missing;
+    for (size_t i = 0; i < registry.size(); ++i)
     {
-        return 0;
+        const auto& attr = registry.attr(i);
+        if (attr.objectPath.length && !registry.values[i])
+        {
+            missing.emplace(registry.string(attr.objectPath),
+                            registry.string(attr.interface));
+        }
     }
-
-    fs::path dir(dirPath);
-    if (!fs::exists(dir) || fs::is_empty(dir))
+    if (missing.empty())
     {
-        std::cerr << "BIOS config directory does not exist or empty, DIR="
-                  << dirPath << "\n";
-        return -1;
+        return;
     }
-    for (auto jsonName : BIOSConfigFiles)
+
+    std::vector<DBusObject> objects(missing.begin(), missing.end());
+    auto properties = pldm::utils::DBusHandler().getDbusPropertiesConcurrently(
+        objects, timeout);
+    for (size_t i = 0; i < objects.size(); ++i)
     {
-        Json json;
-        if (parseBiosJsonFile(dir, jsonName, json) < 0)
+        if (properties[i])
         {
+            updateProperties(objects[i], *properties[i]);
             continue;
         }
-        auto entries = json.value("entries", emptyJsonList);
-        for (auto& entry : entries)
+        std::cerr << "Failed to read BIOS attribute object, PATH="
+                  << objects[i].first << " INTERFACE=" << objects[i].second
+                  << "\n";
+        for (size_t index = 0; index < registry.size(); ++index)
         {
-            setupBIOSStrings(jsonName, entry, BIOSStrings);
-            setupBIOSAttrLookup(entry, BIOSAttrLookup);
-            setupBIOSType(jsonName, entry);
+            if (registry.mapsTo(index, objects[i].first, objects[i].second))
+            {
+                registry.unreadable[index] = true;
+            }
         }
     }
-    if (BIOSStrings.empty())
-    { // means there is no attribute
-        std::cerr << "No attribute is found in the config directory, DIR="
-                  << dirPath << "\n";
-        return -1;
+}
+
+AttrIndices invalidateProperties(const std::string& objectPath)
+{
+    AttrIndices attrIndices;
+    for (size_t i = 0; i < registry.size(); ++i)
+    {
+        if (registry.mapsTo(i, objectPath))
+        {
+            registry.values[i].reset();
+            registry.unreadable[i] = false;
+            attrIndices.push_back(i);
+        }
     }
-    return 0;
+    return attrIndices;
 }
 
 } // namespace bios_parser
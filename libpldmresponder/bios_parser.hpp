@@ -1,8 +1,17 @@
 #pragma once
 
+#include "bios_image.hpp"
+#include "utils.hpp"
+
+#include <stdint.h>
+
+#include <chrono>
 #include <map>
+#include <optional>
+#include <set>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -15,7 +24,11 @@
  *
  * 2) bios_parser::setupConfig has to be invoked to setup the lookup data
  *    structure all the attributes of that type. This API needs to be invoked
- *    before invoking bios_enum::getValues and bios_enum::getAttrValue.
+ *    before invoking bios_enum::getValues and bios_enum::getAttrValue. The
+ *    attributes are read from the BIOS attribute image compiled at build
+ *    time, see bios_image.hpp, and from the JSON files if there's no image.
+ *    The attributes are looked up in the image, by the attribute index of
+ *    their record, rather than copied out of it.
  *
  * 3) bios_enum::getValues is invoked to populate the BIOS attribute table for
  *    BIOSEnumeration and BIOSEnumerationReadonly types.(similar API for other
@@ -25,26 +38,88 @@
  *    enumeration attribute. If there is no D-Bus mapping for the attribute then
  *    default value is returned.(similar API for other BIOS attribute types).
  *
+ * 5) bios_parser::updateProperties keeps the values of the D-Bus properties
+ *    the attributes are mapped to, as got from PropertiesChanged signals, so
+ *    getAttrValue doesn't have to get them from D-Bus.
+ *    bios_parser::fetchProperties gets the values not kept yet, one GetAll
+ *    per D-Bus object, all sent before waiting for any reply.
+ *
+ * 6) bios_enum::setAttrValue sets the D-Bus property an attribute is mapped
+ *    to, and keeps the value set.(similar API for other BIOS attribute types)
+ *
  */
 
 namespace bios_parser
 {
 
 using Strings = std::vector<std::string>;
-inline constexpr auto bIOSEnumJson = "enum_attrs.json";
-inline constexpr auto bIOSStrJson = "string_attrs.json";
-inline constexpr auto bIOSIntegerJson = "integer_attrs.json";
 
 /** @brief Get all the preconfigured strings
  *  @return all the preconfigurated strings
  */
 const Strings& getStrings();
-/** @brief Parse every BIOS Configuration JSON file in the directory path
+/** @brief Set up the attributes from the BIOS attribute image in the
+ *         directory path, or else from every BIOS Configuration JSON file in
+ *         it
  *  @param[in] dirPath - directory path where all the bios configuration JSON
  * files exist
  */
 int setupConfig(const char* dirPath);
 
+/** @brief Hash the BIOS Configuration JSON files in the directory path, or
+ *         get the hash of those the image in it was compiled from, to tell
+ *         whether the BIOS tables built from them are current
+ *  @param[in] dirPath - directory path where all the bios configuration JSON
+ * files exist
+ *  @return the hash, the same for as long as the files don't change
+ */
+uint64_t hashConfig(const char* dirPath);
+
+/** @brief D-Bus object path and interface */
+using DBusObject = std::pair<std::string, std::string>;
+
+/** @brief Indices of BIOS attributes, the attributes setupConfig set up
+ *         being numbered from 0
+ */
+using AttrIndices = std::vector<size_t>;
+
+/** @brief Get the index of an attribute
+ *  @param[in] attrName - name of the attribute
+ *  @return the index, std::nullopt if there's no attribute of the name
+ */
+std::optional<size_t> getAttrIndex(const std::string& attrName);
+
+/** @brief Get the D-Bus objects the BIOS attributes are mapped to
+ *  @return the objects, each once
+ */
+std::set<DBusObject> getDBusObjects();
+
+/** @brief Keep the values of properties of a D-Bus object, which the current
+ *         values of the attributes mapped to them are got from from then on,
+ *         rather than from D-Bus
+ *  @param[in] object - D-Bus object path and interface of the properties
+ *  @param[in] properties - the properties, all or only the ones that changed
+ *  @return indices of the attributes mapped to the properties
+ */
+AttrIndices updateProperties(const DBusObject& object,
+                         const pldm::utils::PropertyMap& properties);
+
+/** @brief Get the values of the D-Bus properties the attributes are mapped to
+ *         that aren't kept yet, with one GetAll per D-Bus object and
+ *         interface, all sent before waiting for any reply. The values got
+ *         are kept, and the attributes of objects that couldn't be read
+ *         have no current value until they're fetched again or change.
+ *  @param[in] timeout - timeout of each GetAll
+ */
+void fetchProperties(std::chrono::microseconds timeout);
+
+/** @brief Drop the values kept of the properties of a D-Bus object path, so
+ *         they're got from D-Bus again
+ *  @param[in] objectPath - D-Bus object path
+ *  @return indices of the attributes mapped to the object path
+ */
+AttrIndices invalidateProperties(const std::string& objectPath);
+
 namespace bios_enum
 {
 
@@ -61,7 +136,7 @@ using AttrValuesMap =
  *  @return information needed to build the BIOS attribute table specific to
  *         BIOSEnumeration and BIOSEnumerationReadOnly types
  */
-const AttrValuesMap& getValues();
+AttrValuesMap getValues();
 
 using CurrentValues = std::vector<std::string>;
 
@@ -73,6 +148,18 @@ using CurrentValues = std::vector<std::string>;
  */
 CurrentValues getAttrValue(const AttrName& attrName);
 
+/** @brief Set the current value of the BIOS attribute, writing it to the
+ *         D-Bus property the attribute is mapped to
+ *
+ *  @param[in] attrName - BIOS attribute name
+ *  @param[in] value - BIOS attribute value, one of the possible values
+ *
+ *  @throw std::invalid_argument if the attribute isn't mapped to D-Bus or
+ *         the value has no D-Bus property value, or the exception of the
+ *         D-Bus call if it fails
+ */
+void setAttrValue(const AttrName& attrName, const std::string& value);
+
 } // namespace bios_enum
 
 namespace bios_string
@@ -95,7 +182,7 @@ using AttrValuesMap =
  *  @return information needed to build the BIOS attribute table specific to
  *         BIOSString and BIOSStringReadOnly types
  */
-const AttrValuesMap& getValues();
+AttrValuesMap getValues();
 
 /** @brief Get the current values for the BIOS Attribute
  *
@@ -105,6 +192,17 @@ const AttrValuesMap& getValues();
  */
 std::string getAttrValue(const AttrName& attrName);
 
+/** @brief Set the current value of the BIOS attribute, writing it to the
+ *         D-Bus property the attribute is mapped to
+ *
+ *  @param[in] attrName - BIOS attribute name
+ *  @param[in] value - BIOS attribute value
+ *
+ *  @throw std::invalid_argument if the attribute isn't mapped to D-Bus, or
+ *         the exception of the D-Bus call if it fails
+ */
+void setAttrValue(const AttrName& attrName, const std::string& value);
+
 } // namespace bios_string
 
 namespace bios_integer
@@ -133,7 +231,7 @@ using AttrValuesMap = std::map<AttrName, AttrValues>;
  *  @return information needed to build the BIOS attribute table specific to
  *         BIOSInteger and BIOSIntegerReadOnly types
  */
-const AttrValuesMap& getValues();
+AttrValuesMap getValues();
 
 /** @brief Get the current values for the BIOS Attribute
  *
@@ -143,6 +241,17 @@ const AttrValuesMap& getValues();
  */
 uint64_t getAttrValue(const AttrName& attrName);
 
+/** @brief Set the current value of the BIOS attribute, writing it to the
+ *         D-Bus property the attribute is mapped to
+ *
+ *  @param[in] attrName - BIOS attribute name
+ *  @param[in] value - BIOS attribute value
+ *
+ *  @throw std::invalid_argument if the attribute isn't mapped to D-Bus, or
+ *         the exception of the D-Bus call if it fails
+ */
+void setAttrValue(const AttrName& attrName, uint64_t value);
+
 } // namespace bios_integer
 
 } // namespace bios_parser
@@ -1,6 +1,25 @@
 #include "bios_table.hpp"
 
+#include <endian.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
 #include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#include "libpldm/bios_table.h"
+#include "libpldm/utils.h"
 
 namespace pldm
 {
@@ -11,37 +30,945 @@ namespace responder
 namespace bios
 {
 
-BIOSTable::BIOSTable(const char* filePath) : filePath(filePath)
+namespace internal
+{
+
+/** @struct Header
+ *
+ *  @brief Header of a persisted table, little endian
+ */
+struct Header
+{
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t length;
+    uint64_t inputsHash;
+    uint32_t crc;
+} __attribute__((packed));
+
+/** @struct JournalRecord
+ *
+ *  @brief Header of a record of the journal of a persisted table, little
+ *         endian. The ranges the record writes follow it, each an offset in
+ *         the table and a length, 32 bits each, and then the bytes.
+ */
+struct JournalRecord
+{
+    /** @brief CRC32 of the table the record applies to */
+    uint32_t baseCrc;
+
+    /** @brief CRC32 of the table once the record is applied */
+    uint32_t crc;
+
+    /** @brief Bytes of ranges after the header */
+    uint32_t length;
+
+    /** @brief CRC32 of the bytes of ranges */
+    uint32_t rangesCrc;
+} __attribute__((packed));
+
+/** @struct Resident
+ *
+ *  @brief A table in memory and the hash of the inputs it's built from
+ */
+struct Resident
+{
+    std::shared_ptr<const Table> table;
+    uint64_t inputsHash;
+
+    /** @brief The table once attribute values are updated in it, in place
+     *         of table
+     */
+    std::shared_ptr<AttrValueTable> values;
+};
+
+/** @brief The tables in memory by file, a nullptr table for a removed one */
+std::map<fs::path, Resident> tables;
+
+/** @struct Write
+ *
+ *  @brief A write waiting for a file, of a table whole or of ranges of it
+ */
+struct Write
+{
+    /** @brief The table to write whole, nullptr to remove the file unless
+     *         there are ranges to write
+     */
+    std::shared_ptr<const Table> table;
+    uint64_t inputsHash;
+
+    /** @brief Bytes to write over the table in the file, by offset in the
+     *         table
+     */
+    std::map<size_t, Table> ranges;
+
+    /** @brief CRC32 of the table once the ranges are written */
+    uint32_t crc;
+
+    /** @brief CRC32 of the table before the ranges are written */
+    uint32_t baseCrc;
+};
+
+/** @brief Writes waiting by file */
+std::map<fs::path, Write> pending;
+std::mutex pendingMutex;
+
+/** @brief Held while pending tables are written */
+std::mutex writeMutex;
+std::atomic<bool> writing = false;
+
+/** @brief Queue the write of a table, in place of any write waiting for its
+ *         file
+ *
+ *  @param[in] filePath - file of the table
+ *  @param[in] table - the table, nullptr to remove the file
+ *  @param[in] inputsHash - hash of the inputs the table is built from
+ */
+void queue(const fs::path& filePath, std::shared_ptr<const Table> table,
+           uint64_t inputsHash)
+{
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pending[filePath] = {std::move(table), inputsHash, {}, 0, 0};
+}
+
+/** @brief Queue the write of ranges of an attribute value table to the
+ *         journal of its file
+ *
+ *  @param[in] filePath - file of the table
+ *  @param[in] values - the table, with the ranges updated
+ *  @param[in] inputsHash - hash of the inputs the table is built from
+ *  @param[in] ranges - the bytes to write, by offset in the table
+ *  @param[in] baseCrc - CRC32 of the table before the ranges were updated
+ */
+void queueRanges(const fs::path& filePath, const AttrValueTable& values,
+                 uint64_t inputsHash, std::map<size_t, Table>&& ranges,
+                 uint32_t baseCrc)
+{
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    auto found = pending.find(filePath);
+    if (found != pending.end() && found->second.ranges.empty())
+    {
+        // The table is written whole anyway, as it is by then
+        found->second.table = values.get();
+        return;
+    }
+
+    // Ranges written before are kept, unless written over, and go in the
+    // same record
+    auto& write = pending[filePath];
+    if (write.ranges.empty())
+    {
+        write.baseCrc = baseCrc;
+    }
+    write.inputsHash = inputsHash;
+    write.crc = values.crc();
+    for (auto& [offset, bytes] : ranges)
+    {
+        write.ranges[offset] = std::move(bytes);
+    }
+}
+
+/** @brief Get the file of the journal of a persisted table
+ *
+ *  @param[in] filePath - file of the table
+ *
+ *  @return fs::path - file of the journal
+ */
+fs::path journalPath(const fs::path& filePath)
+{
+    auto path = filePath;
+    path += ".journal";
+    return path;
+}
+
+/** @brief Read a persisted table, without its journal
+ *
+ *  @param[in] filePath - file of the table
+ *  @param[in] inputsHash - hash of the inputs the table must be built from
+ *  @param[out] crc - CRC32 of the table
+ *
+ *  @return std::shared_ptr<Table> - the table, nullptr if it's missing or
+ *          its header doesn't match
+ */
+std::shared_ptr<Table> readBase(const fs::path& filePath, uint64_t inputsHash,
+                                uint32_t& crc)
+{
+    std::ifstream stream(filePath.string(), std::ios::in | std::ios::binary);
+    Header header{};
+    if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        return nullptr;
+    }
+
+    std::error_code ec;
+    auto fileSize = fs::file_size(filePath, ec);
+    auto length = le32toh(header.length);
+    if (ec || le16toh(header.version) != tableFormatVersion ||
+        fileSize != sizeof(header) + length ||
+        le64toh(header.inputsHash) != inputsHash)
+    {
+        std::cerr << "Persisted BIOS table is out of date, FILE=" << filePath
+                  << "\n";
+        return nullptr;
+    }
+    auto table = std::make_shared<Table>(length);
+    stream.read(reinterpret_cast<char*>(table->data()), length);
+    if (!stream || crc32(table->data(), table->size()) != le32toh(header.crc))
+    {
+        std::cerr << "Persisted BIOS table is corrupt, FILE=" << filePath
+                  << "\n";
+        return nullptr;
+    }
+    crc = le32toh(header.crc);
+    return table;
+}
+
+/** @brief Apply the records of the journal of a persisted table to it, up
+ *         to the first that's torn or doesn't follow from the table
+ *
+ *  @param[in] filePath - file of the table
+ *  @param[in,out] table - the table
+ *  @param[in,out] crc - CRC32 of the table
+ *
+ *  @return bool - false if the journal has bytes after the records applied
+ */
+bool replay(const fs::path& filePath, Table& table, uint32_t& crc)
+{
+    std::ifstream stream(journalPath(filePath).string(),
+                         std::ios::in | std::ios::binary);
+    if (!stream)
+    {
+        return true;
+    }
+    Table journal((std::istreambuf_iterator<char>(stream)),
+                  std::istreambuf_iterator<char>());
+
+    size_t pos = 0;
+    while (pos + sizeof(JournalRecord) <= journal.size())
+    {
+        JournalRecord record{};
+        std::memcpy(&record, journal.data() + pos, sizeof(record));
+        auto ranges = journal.data() + pos + sizeof(record);
+        auto length = le32toh(record.length);
+        if (le32toh(record.baseCrc) != crc ||
+            length > journal.size() - pos - sizeof(record) ||
+            crc32(ranges, length) != le32toh(record.rangesCrc))
+        {
+            break;
+        }
+
+        // The record is applied to a copy, so one that doesn't give the
+        // table it names leaves the table as it was
+        auto patched = table;
+        size_t at = 0;
+        bool fits = true;
+        while (fits && at < length)
+        {
+            uint32_t range[2]{};
+            fits = length - at >= sizeof(range);
+            if (fits)
+            {
+                std::memcpy(range, ranges + at, sizeof(range));
+                at += sizeof(range);
+                size_t offset = le32toh(range[0]);
+                size_t size = le32toh(range[1]);
+                fits = size <= length - at && offset <= patched.size() &&
+                       size <= patched.size() - offset;
+                if (fits)
+                {
+                    std::memcpy(patched.data() + offset, ranges + at, size);
+                    at += size;
+                }
+            }
+        }
+        if (!fits || crc32(patched.data(), patched.size()) !=
+                         le32toh(record.crc))
+        {
+            break;
+        }
+        table = std::move(patched);
+        crc = le32toh(record.crc);
+        pos += sizeof(record) + length;
+    }
+    return pos == journal.size();
+}
+
+void writeAsync();
+
+/** @brief Read a persisted table and apply its journal. A journal that
+ *         doesn't apply to its end, as a crash part way through a record
+ *         leaves it, is dropped by writing the table whole.
+ *
+ *  @param[in] filePath - file of the table
+ *  @param[in] inputsHash - hash of the inputs the table must be built from
+ *
+ *  @return std::shared_ptr<const Table> - the table, nullptr if it's missing
+ *          or its header doesn't match
+ */
+std::shared_ptr<const Table> read(const fs::path& filePath,
+                                  uint64_t inputsHash)
+{
+    uint32_t crc = 0;
+    auto table = readBase(filePath, inputsHash, crc);
+    if (table && !replay(filePath, *table, crc))
+    {
+        std::cerr << "Journal of persisted BIOS table is torn, FILE="
+                  << filePath << "\n";
+        queue(filePath, table, inputsHash);
+        writeAsync();
+    }
+    return table;
+}
+
+/** @brief Write all of a buffer to a file
+ *
+ *  @param[in] fd - the file
+ *  @param[in] data - the buffer
+ *  @param[in] size - size of the buffer
+ *  @param[in] offset - offset in the file to write at
+ *
+ *  @return bool - false if the write failed
+ */
+bool writeAll(int fd, const void* data, size_t size, off_t offset)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+    while (size)
+    {
+        auto written = ::pwrite(fd, bytes, size, offset);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= written;
+        offset += written;
+    }
+    return true;
+}
+
+/** @brief Persist a table, replacing the file whole
+ *
+ *  @param[in] filePath - file of the table
+ *  @param[in] resident - the table
+ *
+ *  @return bool - false if the table couldn't be written
+ */
+bool write(const fs::path& filePath, const Write& resident)
+{
+    std::error_code ec;
+    fs::create_directories(filePath.parent_path(), ec);
+    auto tmpPath = filePath;
+    tmpPath += ".tmp";
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                    0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    const auto& table = *resident.table;
+    Header header{};
+    header.version = htole16(tableFormatVersion);
+    header.length = htole32(table.size());
+    header.inputsHash = htole64(resident.inputsHash);
+    header.crc = htole32(crc32(table.data(), table.size()));
+    bool written = writeAll(fd, &header, sizeof(header), 0) &&
+                   writeAll(fd, table.data(), table.size(), sizeof(header)) &&
+                   ::fsync(fd) == 0;
+    ::close(fd);
+    if (written)
+    {
+        fs::rename(tmpPath, filePath, ec);
+    }
+    if (!written || ec)
+    {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+
+    // The journal was of the table replaced
+    fs::remove(journalPath(filePath), ec);
+    return true;
+}
+
+/** @brief Append ranges of a table to the journal of its file, as one
+ *         record. The journal is compacted into the file, through a whole
+ *         write, once it's larger than the table.
+ *
+ *  @param[in] filePath - file of the table
+ *  @param[in] write - the ranges
+ *
+ *  @return bool - false if the ranges couldn't be written
+ *
+ *  @note A crash part way through leaves a record that's torn, which isn't
+ *        applied, so the table read back is the one before the ranges
+ */
+bool writeRanges(const fs::path& filePath, const Write& write)
+{
+    Table ranges;
+    for (const auto& [offset, bytes] : write.ranges)
+    {
+        uint32_t range[2]{htole32(offset), htole32(bytes.size())};
+        auto rangeBytes = reinterpret_cast<const uint8_t*>(range);
+        ranges.insert(ranges.end(), rangeBytes, rangeBytes + sizeof(range));
+        ranges.insert(ranges.end(), bytes.begin(), bytes.end());
+    }
+    JournalRecord record{};
+    record.baseCrc = htole32(write.baseCrc);
+    record.crc = htole32(write.crc);
+    record.length = htole32(ranges.size());
+    record.rangesCrc = htole32(crc32(ranges.data(), ranges.size()));
+
+    auto path = journalPath(filePath);
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    auto end = ::lseek(fd, 0, SEEK_END);
+    bool written = end >= 0 && writeAll(fd, &record, sizeof(record), end) &&
+                   writeAll(fd, ranges.data(), ranges.size(),
+                            end + sizeof(record)) &&
+                   ::fsync(fd) == 0;
+    ::close(fd);
+    if (!written)
+    {
+        return false;
+    }
+
+    // The journal is compacted once it outgrows the table
+    std::error_code ec;
+    auto fileSize = fs::file_size(filePath, ec);
+    size_t journalSize = end + sizeof(record) + ranges.size();
+    if (ec || journalSize <= fileSize - sizeof(Header))
+    {
+        return !ec;
+    }
+    uint32_t crc = 0;
+    auto table = readBase(filePath, write.inputsHash, crc);
+    if (!table || !replay(filePath, *table, crc))
+    {
+        return false;
+    }
+    return internal::write(filePath, {table, write.inputsHash, {}, 0, 0});
+}
+
+/** @brief Write the next pending table
+ *
+ *  @return bool - false if no table was pending
+ *
+ *  @note Caller is responsible for holding writeMutex
+ */
+bool writeNext()
+{
+    fs::path filePath;
+    Write resident;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        if (pending.empty())
+        {
+            return false;
+        }
+        auto next = pending.extract(pending.begin());
+        filePath = std::move(next.key());
+        resident = std::move(next.mapped());
+    }
+
+    if (!resident.ranges.empty())
+    {
+        if (!writeRanges(filePath, resident))
+        {
+            std::cerr << "Failed to update BIOS table, FILE=" << filePath
+                      << "\n";
+        }
+    }
+    else if (!resident.table)
+    {
+        std::error_code ec;
+        fs::remove(filePath, ec);
+        fs::remove(journalPath(filePath), ec);
+    }
+    else if (!write(filePath, resident))
+    {
+        std::cerr << "Failed to write BIOS table, FILE=" << filePath << "\n";
+    }
+    return true;
+}
+
+/** @brief Write the pending tables on a thread of their own, unless it's
+ *         already running
+ */
+void writeAsync()
+{
+    bool running = false;
+    if (!writing.compare_exchange_strong(running, true))
+    {
+        // The thread running will pick up the table queued
+        return;
+    }
+
+    std::thread([]() {
+        bool more = false;
+        do
+        {
+            {
+                std::lock_guard<std::mutex> lock(writeMutex);
+                while (writeNext())
+                {
+                }
+            }
+            writing = false;
+            {
+                std::lock_guard<std::mutex> lock(pendingMutex);
+                more = !pending.empty();
+            }
+        } while (more && !writing.exchange(true));
+    }).detach();
+}
+
+/** @brief Polynomial of CRC32, reflected */
+constexpr uint32_t crc32Polynomial = 0xedb88320;
+
+/** @brief A linear operator on a CRC32, as 32 columns of bits */
+using Operator = std::array<uint32_t, 32>;
+
+/** @brief Apply an operator to a CRC32
+ *
+ *  @param[in] op - the operator
+ *  @param[in] crc - the CRC
+ *
+ *  @return uint32_t - the CRC the operator gives
+ */
+uint32_t apply(const Operator& op, uint32_t crc)
+{
+    uint32_t result = 0;
+    for (size_t bit = 0; crc; ++bit, crc >>= 1)
+    {
+        if (crc & 1)
+        {
+            result ^= op[bit];
+        }
+    }
+    return result;
+}
+
+/** @brief Square an operator, so it's applied twice
+ *
+ *  @param[in] op - the operator
+ *
+ *  @return Operator - the operator squared
+ */
+Operator square(const Operator& op)
+{
+    Operator squared{};
+    for (size_t bit = 0; bit < op.size(); ++bit)
+    {
+        squared[bit] = apply(op, op[bit]);
+    }
+    return squared;
+}
+
+/** @brief Get the operators that run a CRC32 over 2^n zero bytes, by n
+ *
+ *  @return const std::array<Operator, 64>& - the operators
+ */
+const std::array<Operator, 64>& zeroOperators()
+{
+    static const auto operators = []() {
+        // One zero bit shifts the CRC, less the polynomial out of its low bit
+        Operator op{};
+        op[0] = crc32Polynomial;
+        for (size_t bit = 1; bit < op.size(); ++bit)
+        {
+            op[bit] = 1u << (bit - 1);
+        }
+        for (size_t bits = 1; bits < 8; bits *= 2)
+        {
+            op = square(op);
+        }
+
+        std::array<Operator, 64> byPowerOfTwo{};
+        for (auto& zeros : byPowerOfTwo)
+        {
+            zeros = op;
+            op = square(op);
+        }
+        return byPowerOfTwo;
+    }();
+    return operators;
+}
+
+/** @brief Update the CRC32 of a buffer for bytes of it that changed, without
+ *         running over the rest of it
+ *
+ *  @param[in] crc - CRC32 of the buffer before the change
+ *  @param[in] before - the bytes before the change
+ *  @param[in] after - the bytes after the change
+ *  @param[in] length - number of bytes changed
+ *  @param[in] tail - number of bytes of the buffer after them
+ *
+ *  @return uint32_t - CRC32 of the buffer after the change
+ */
+uint32_t crc32Update(uint32_t crc, const uint8_t* before, const uint8_t* after,
+                     size_t length, size_t tail)
+{
+    // CRC32 is linear, so the CRC changes by the CRC of the bytes XORed,
+    // less the initial value and final XOR, then run over the tail of zeros
+    uint32_t delta = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        delta ^= before[i] ^ after[i];
+        for (size_t bit = 0; bit < 8; ++bit)
+        {
+            delta = (delta >> 1) ^ ((delta & 1) ? crc32Polynomial : 0);
+        }
+    }
+    const auto& operators = zeroOperators();
+    for (size_t n = 0; tail; ++n, tail >>= 1)
+    {
+        if (tail & 1)
+        {
+            delta = apply(operators[n], delta);
+        }
+    }
+    return crc ^ delta;
+}
+
+/** @brief Get the length of an attribute value table entry
+ *
+ *  @param[in] entry - the entry
+ *
+ *  @return size_t - its length
+ */
+size_t attrValueEntryLength(const pldm_bios_attr_val_table_entry* entry)
+{
+    return offsetof(pldm_bios_attr_val_table_entry, value) +
+           pldm_bios_table_attr_value_entry_value_length(entry);
+}
+
+} // namespace internal
+
+BIOSTable::BIOSTable(const char* filePath, uint64_t inputsHash) :
+    filePath(filePath), inputsHash(inputsHash)
 {
 }
 
 bool BIOSTable::isEmpty() const noexcept
 {
-    bool empty = false;
     try
     {
-        empty = fs::is_empty(filePath);
+        auto table = get();
+        return !table || table->empty();
     }
-    catch (fs::filesystem_error& e)
+    catch (const std::exception& e)
     {
         return true;
     }
-    return empty;
 }
 
 void BIOSTable::store(const Table& table)
 {
-    std::ofstream stream(filePath.string(), std::ios::out | std::ios::binary);
-    stream.write(reinterpret_cast<const char*>(table.data()), table.size());
+    auto stored = std::make_shared<const Table>(table);
+    internal::tables[filePath] = {stored, inputsHash, nullptr};
+    internal::queue(filePath, std::move(stored), inputsHash);
+    internal::writeAsync();
 }
 
 void BIOSTable::load(Response& response) const
 {
-    auto currSize = response.size();
-    auto fileSize = fs::file_size(filePath);
-    response.resize(currSize + fileSize);
-    std::ifstream stream(filePath.string(), std::ios::in | std::ios::binary);
-    stream.read(reinterpret_cast<char*>(response.data() + currSize), fileSize);
+    auto table = get();
+    if (!table)
+    {
+        throw fs::filesystem_error(
+            "No BIOS table", filePath,
+            std::make_error_code(std::errc::no_such_file_or_directory));
+    }
+    response.insert(response.end(), table->begin(), table->end());
+}
+
+std::shared_ptr<const Table> BIOSTable::get() const
+{
+    auto found = internal::tables.find(filePath);
+    if (found != internal::tables.end())
+    {
+        const auto& resident = found->second;
+        if ((resident.table || resident.values) &&
+            resident.inputsHash != inputsHash)
+        {
+            return nullptr;
+        }
+        return resident.values ? resident.values->get() : resident.table;
+    }
+
+    // Only a valid table is kept, a missing file is looked for again
+    auto table = internal::read(filePath, inputsHash);
+    if (table)
+    {
+        internal::tables[filePath] = {table, inputsHash, nullptr};
+    }
+    return table;
+}
+
+void BIOSTable::remove()
+{
+    internal::tables[filePath] = {nullptr, inputsHash, nullptr};
+    internal::queue(filePath, nullptr, inputsHash);
+    internal::writeAsync();
+}
+
+void BIOSTable::forget()
+{
+    internal::tables.erase(filePath);
+}
+
+void BIOSTable::flush()
+{
+    std::lock_guard<std::mutex> lock(internal::writeMutex);
+    while (internal::writeNext())
+    {
+    }
+}
+
+AttrValueTable* BIOSTable::attrValues() const
+{
+    if (!get())
+    {
+        return nullptr;
+    }
+    auto& resident = internal::tables[filePath];
+    if (!resident.values)
+    {
+        resident.values = std::make_shared<AttrValueTable>(*resident.table);
+        resident.table = nullptr;
+    }
+    return resident.values.get();
+}
+
+bool BIOSTable::updateAttrValue(const uint8_t* entry, size_t length)
+{
+    auto values = attrValues();
+    if (!values)
+    {
+        return false;
+    }
+
+    auto baseCrc = values->crc();
+    auto patch = values->update(entry, length);
+    if (!patch)
+    {
+        return false;
+    }
+    auto table = values->get();
+    if (patch->spliced)
+    {
+        internal::queue(filePath, table, inputsHash);
+    }
+    else
+    {
+        auto checksumOffset = table->size() - sizeof(uint32_t);
+        std::map<size_t, Table> ranges;
+        ranges.emplace(patch->offset,
+                       Table(table->begin() + patch->offset,
+                             table->begin() + patch->offset + patch->length));
+        ranges.emplace(checksumOffset,
+                       Table(table->begin() + checksumOffset, table->end()));
+        table.reset();
+        internal::queueRanges(filePath, *values, inputsHash,
+                              std::move(ranges), baseCrc);
+    }
+    internal::writeAsync();
+    return true;
+}
+
+const Table* BIOSTable::findAttrValue(uint16_t attrHandle) const
+{
+    auto values = attrValues();
+    return values ? values->findValue(attrHandle) : nullptr;
+}
+
+BIOSStringIndex::BIOSStringIndex(const Table& stringTable)
+{
+    std::unique_ptr<pldm_bios_table_iter, decltype(&pldm_bios_table_iter_free)>
+        iter(pldm_bios_table_iter_create(stringTable.data(),
+                                         stringTable.size(),
+                                         PLDM_BIOS_STRING_TABLE),
+             pldm_bios_table_iter_free);
+    while (!pldm_bios_table_iter_is_end(iter.get()))
+    {
+        auto entry = pldm_bios_table_iter_string_entry_value(iter.get());
+        auto handle = pldm_bios_table_string_entry_decode_handle(entry);
+        std::string name(
+            entry->name,
+            pldm_bios_table_string_entry_decode_string_length(entry));
+        auto interned = handles.emplace(std::move(name), handle).first;
+        names.emplace(handle, &interned->first);
+        pldm_bios_table_iter_next(iter.get());
+    }
+}
+
+std::optional<uint16_t> BIOSStringIndex::findHandle(
+    const std::string& name) const
+{
+    auto found = handles.find(name);
+    if (found == handles.end())
+    {
+        return std::nullopt;
+    }
+    return found->second;
+}
+
+const std::string* BIOSStringIndex::findName(uint16_t handle) const
+{
+    auto found = names.find(handle);
+    if (found == names.end())
+    {
+        return nullptr;
+    }
+    return found->second;
+}
+
+AttrValueTable::AttrValueTable(Table table) :
+    table(std::make_shared<Table>(std::move(table)))
+{
+    const auto& bytes = *this->table;
+    std::unique_ptr<pldm_bios_table_iter, decltype(&pldm_bios_table_iter_free)>
+        iter(pldm_bios_table_iter_create(bytes.data(), bytes.size(),
+                                         PLDM_BIOS_ATTR_VAL_TABLE),
+             pldm_bios_table_iter_free);
+    while (!pldm_bios_table_iter_is_end(iter.get()))
+    {
+        auto entry = pldm_bios_table_iter_attr_value_entry_value(iter.get());
+        size_t offset = reinterpret_cast<const uint8_t*>(entry) - bytes.data();
+        offsets.emplace(pldm_bios_table_attr_value_entry_decode_handle(entry),
+                        offset);
+        entriesLength = offset + internal::attrValueEntryLength(entry);
+        pldm_bios_table_iter_next(iter.get());
+    }
+    tableCrc = crc32(bytes.data(), bytes.size());
+
+    // Handles are given out one after the other, so the array is dense
+    if (offsets.empty())
+    {
+        return;
+    }
+    auto [first, last] = std::minmax_element(
+        offsets.begin(), offsets.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    firstHandle = first->first;
+    values.resize(last->first - firstHandle + 1);
+    for (const auto& [handle, offset] : offsets)
+    {
+        keepValue(reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+            bytes.data() + offset));
+    }
+}
+
+void AttrValueTable::keepValue(const pldm_bios_attr_val_table_entry* entry)
+{
+    auto value = pldm_bios_table_attr_value_entry_value(entry);
+    values[pldm_bios_table_attr_value_entry_decode_handle(entry) -
+           firstHandle]
+        .assign(value,
+                value + pldm_bios_table_attr_value_entry_value_length(entry));
+}
+
+std::optional<AttrValueTable::Patch>
+    AttrValueTable::update(const uint8_t* entry, size_t length)
+{
+    if (length <= offsetof(pldm_bios_attr_val_table_entry, value))
+    {
+        return std::nullopt;
+    }
+    auto newEntry =
+        reinterpret_cast<const pldm_bios_attr_val_table_entry*>(entry);
+    auto found =
+        offsets.find(pldm_bios_table_attr_value_entry_decode_handle(newEntry));
+    if (found == offsets.end())
+    {
+        return std::nullopt;
+    }
+    auto offset = found->second;
+    auto oldEntry = reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+        table->data() + offset);
+    if (oldEntry->attr_type != newEntry->attr_type)
+    {
+        return std::nullopt;
+    }
+    auto oldLength = internal::attrValueEntryLength(oldEntry);
+
+    // A snapshot held elsewhere mustn't change
+    if (table.use_count() > 1)
+    {
+        table = std::make_shared<Table>(*table);
+    }
+    auto& bytes = *table;
+
+    if (length == oldLength)
+    {
+        auto checksumOffset = bytes.size() - sizeof(uint32_t);
+        uint32_t checksum = 0;
+        std::memcpy(&checksum, bytes.data() + checksumOffset,
+                    sizeof(checksum));
+        checksum = htole32(internal::crc32Update(
+            le32toh(checksum), bytes.data() + offset, entry, length,
+            checksumOffset - offset - length));
+        auto checksumBytes = reinterpret_cast<const uint8_t*>(&checksum);
+
+        tableCrc = internal::crc32Update(tableCrc, bytes.data() + offset,
+                                         entry, length,
+                                         bytes.size() - offset - length);
+        tableCrc =
+            internal::crc32Update(tableCrc, bytes.data() + checksumOffset,
+                                  checksumBytes, sizeof(checksum), 0);
+        std::copy(entry, entry + length, bytes.begin() + offset);
+        std::copy(checksumBytes, checksumBytes + sizeof(checksum),
+                  bytes.begin() + checksumOffset);
+        keepValue(newEntry);
+        return Patch{offset, length, false};
+    }
+
+    bytes.resize(entriesLength);
+    bytes.erase(bytes.begin() + offset, bytes.begin() + offset + oldLength);
+    bytes.insert(bytes.begin() + offset, entry, entry + length);
+    for (auto& [handle, entryOffset] : offsets)
+    {
+        if (entryOffset > offset)
+        {
+            entryOffset = entryOffset + length - oldLength;
+        }
+    }
+    entriesLength = entriesLength + length - oldLength;
+    bytes.resize(entriesLength +
+                 pldm_bios_table_pad_checksum_size(entriesLength));
+    pldm_bios_table_append_pad_checksum(bytes.data(), bytes.size(),
+                                        entriesLength);
+    tableCrc = crc32(bytes.data(), bytes.size());
+    keepValue(newEntry);
+    return Patch{offset, bytes.size() - offset, true};
+}
+
+std::shared_ptr<const Table> AttrValueTable::get() const
+{
+    return table;
+}
+
+const Table* AttrValueTable::findValue(uint16_t attrHandle) const
+{
+    size_t index = static_cast<uint16_t>(attrHandle - firstHandle);
+    if (index >= values.size() || values[index].empty())
+    {
+        return nullptr;
+    }
+    return &values[index];
+}
+
+uint32_t AttrValueTable::crc() const
+{
+    return tableCrc;
 }
 
 } // namespace bios
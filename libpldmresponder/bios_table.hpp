@@ -3,6 +3,10 @@
 #include <stdint.h>
 
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "libpldm/bios.h"
@@ -20,10 +24,33 @@ using Table = std::vector<uint8_t>;
 using Response = std::vector<uint8_t>;
 namespace fs = std::filesystem;
 
+/** @brief Version of the format of the persisted BIOS tables, tables
+ *         persisted in another format are rebuilt
+ */
+constexpr uint16_t tableFormatVersion = 1;
+
+class AttrValueTable;
+
 /** @class BIOSTable
  *
  *  @brief Provides APIs for storing and loading BIOS tables
  *
+ *  The tables are kept in memory, shared by all the BIOSTable objects of the
+ *  same file. A table is read from its file the first time it's used, and
+ *  stored tables are written to their files in the background.
+ *
+ *  A persisted table starts with a header giving the format version, a hash
+ *  of the inputs the table was built from and a CRC of the table. A table
+ *  with a header that doesn't match is taken as missing, so it's rebuilt.
+ *  Tables are written to a temporary file, synced and renamed over the
+ *  file, so a crash leaves either the old table or the new one. Attribute
+ *  values updated in place are appended to a journal next to the file
+ *  instead, as records naming the CRCs of the table before and after them,
+ *  and are applied when the table is read. A crash part way through a
+ *  record leaves it torn, so the table read is the one before it. The
+ *  journal is compacted into the file through a whole write once it's
+ *  larger than the table.
+ *
  *  Typical usage is as follows:
  *  BIOSTable table(BIOS_STRING_TABLE_FILE_PATH);
  *  if (table.isEmpty()) { // no persisted table
@@ -44,8 +71,10 @@ class BIOSTable
     /** @brief Ctor - set file path to persist BIOS table
      *
      *  @param[in] filePath - file where BIOS table should be persisted
+     *  @param[in] inputsHash - hash of the inputs the table is built from,
+     *                          a table built from other inputs isn't used
      */
-    BIOSTable(const char* filePath);
+    BIOSTable(const char* filePath, uint64_t inputsHash = 0);
 
     /** @brief Checks if there's a persisted BIOS table
      *
@@ -55,7 +84,10 @@ class BIOSTable
 
     /** @brief Persist a BIOS table(string/attribute/attribute value)
      *
-     *  @param[in] table - BIOS table
+     *  @param[in] table - BIOS table, padded and checksummed
+     *
+     *  @note The table is in memory once this returns, it's written to the
+     *        file in the background
      */
     void store(const Table& table);
 
@@ -66,9 +98,211 @@ class BIOSTable
      */
     void load(Response& response) const;
 
+    /** @brief Get the BIOS table, without copying it
+     *
+     *  @return std::shared_ptr<const Table> - the table, nullptr if there's
+     *          no persisted table
+     */
+    std::shared_ptr<const Table> get() const;
+
+    /** @brief Drop the BIOS table, from memory and from its file */
+    void remove();
+
+    /** @brief Drop the BIOS table from memory, it's read from its file when
+     *         it's next used
+     */
+    void forget();
+
+    /** @brief Wait for the tables stored so far to be written to their
+     *         files
+     */
+    static void flush();
+
+    /** @brief Update the entry of an attribute in the attribute value table
+     *
+     *  @param[in] entry - the attribute's new entry, encoded
+     *  @param[in] length - length of the entry
+     *
+     *  @return bool - false if there's no table, or no entry of the same type
+     *          for the attribute
+     *
+     *  @note An entry of the same length is appended to the journal of the
+     *        file, the table is written whole otherwise
+     */
+    bool updateAttrValue(const uint8_t* entry, size_t length);
+
+    /** @brief Find the current value of an attribute in the attribute value
+     *         table
+     *
+     *  @param[in] attrHandle - the attribute's handle
+     *
+     *  @return const Table* - the value field of the attribute's entry,
+     *          nullptr if there's no table or no entry for the attribute
+     *
+     *  @note The value is valid until the table next changes
+     */
+    const Table* findAttrValue(uint16_t attrHandle) const;
+
   private:
+    /** @brief Get the attribute value table, indexed by attribute handle
+     *
+     *  @return AttrValueTable* - the table, nullptr if there's none
+     */
+    AttrValueTable* attrValues() const;
+
     // file storing PLDM BIOS table
     fs::path filePath;
+
+    // hash of the inputs the table is built from
+    uint64_t inputsHash;
+};
+
+/** @class BIOSStringIndex
+ *
+ *  @brief Maps the strings of a BIOS string table to their handles and back,
+ *         each string kept once
+ */
+class BIOSStringIndex
+{
+  public:
+    /** @brief Build the index of a BIOS string table
+     *
+     *  @param[in] stringTable - the string table
+     */
+    explicit BIOSStringIndex(const Table& stringTable);
+
+    BIOSStringIndex(const BIOSStringIndex&) = delete;
+    BIOSStringIndex& operator=(const BIOSStringIndex&) = delete;
+    BIOSStringIndex(BIOSStringIndex&&) = default;
+    BIOSStringIndex& operator=(BIOSStringIndex&&) = default;
+
+    /** @brief Find the handle of a string
+     *
+     *  @param[in] name - the string
+     *
+     *  @return std::optional<uint16_t> - the handle, std::nullopt if the
+     *          table doesn't have the string
+     */
+    std::optional<uint16_t> findHandle(const std::string& name) const;
+
+    /** @brief Find the string of a handle
+     *
+     *  @param[in] handle - the handle
+     *
+     *  @return const std::string* - the string, nullptr if the table doesn't
+     *          have the handle
+     */
+    const std::string* findName(uint16_t handle) const;
+
+  private:
+    /** @brief Handles by string, holding the strings */
+    std::unordered_map<std::string, uint16_t> handles;
+
+    /** @brief Strings by handle, pointing at the keys of handles */
+    std::unordered_map<uint16_t, const std::string*> names;
+};
+
+/** @class AttrValueTable
+ *
+ *  @brief An attribute value table whose entries are replaced one at a time
+ *
+ *  Entries are found by attribute handle through an index of their offsets.
+ *  An entry replaced by one of the same length is patched in place, and the
+ *  checksum is updated from the bytes that changed rather than the whole
+ *  table, so the update costs the length of the entry. An entry of another
+ *  length is spliced in, moving the entries after it, and the pad and the
+ *  checksum are redone.
+ *
+ *  The table is copied before it's patched only while a snapshot from get()
+ *  is held elsewhere, so snapshots never change.
+ *
+ *  The value field of every entry is also kept on its own, in an array
+ *  indexed by attribute handle, so a current value is found with one lookup
+ *  and copied into a response as it is. A value is replaced whenever its
+ *  entry is.
+ */
+class AttrValueTable
+{
+  public:
+    /** @struct Patch
+     *
+     *  @brief The bytes of the table an update changed
+     */
+    struct Patch
+    {
+        size_t offset;
+        size_t length;
+
+        /** @brief Whether the entries after the one updated moved, so the
+         *         table changed from the offset to its end
+         */
+        bool spliced;
+    };
+
+    /** @brief Index an attribute value table
+     *
+     *  @param[in] table - the table, padded and checksummed
+     */
+    explicit AttrValueTable(Table table);
+
+    /** @brief Replace the entry of an attribute
+     *
+     *  @param[in] entry - the attribute's new entry, encoded
+     *  @param[in] length - length of the entry
+     *
+     *  @return std::optional<Patch> - the bytes changed besides the checksum,
+     *          std::nullopt if the table has no entry of the same type for
+     *          the attribute
+     */
+    std::optional<Patch> update(const uint8_t* entry, size_t length);
+
+    /** @brief Get the table, without copying it
+     *
+     *  @return std::shared_ptr<const Table> - the table
+     */
+    std::shared_ptr<const Table> get() const;
+
+    /** @brief Find the value field of an attribute's entry
+     *
+     *  @param[in] attrHandle - the attribute's handle
+     *
+     *  @return const Table* - the value, nullptr if the table has no entry
+     *          for the attribute
+     */
+    const Table* findValue(uint16_t attrHandle) const;
+
+    /** @brief Get the CRC32 of the whole table, checksum included
+     *
+     *  @return uint32_t - the CRC
+     */
+    uint32_t crc() const;
+
+  private:
+    /** @brief The table */
+    std::shared_ptr<Table> table;
+
+    /** @brief Offsets of the entries by attribute handle */
+    std::unordered_map<uint16_t, size_t> offsets;
+
+    /** @brief Length of the entries, without pad and checksum */
+    size_t entriesLength = 0;
+
+    /** @brief Value fields of the entries, at the attribute handle less
+     *         firstHandle, empty for a handle with no entry
+     */
+    std::vector<Table> values;
+
+    /** @brief Lowest attribute handle of the entries */
+    uint16_t firstHandle = 0;
+
+    /** @brief Keep the value field of an entry
+     *
+     *  @param[in] entry - the entry
+     */
+    void keepValue(const pldm_bios_attr_val_table_entry* entry);
+
+    /** @brief CRC32 of the whole table */
+    uint32_t tableCrc = 0;
 };
 
 } // namespace bios
@@ -1,6 +1,6 @@
 #include "effecters.hpp"
 
-#include <map>
+#include <atomic>
 
 namespace pldm
 {
@@ -11,10 +11,21 @@ namespace responder
 namespace effecter
 {
 
+namespace internal
+{
+
+Id id = 0;
+
+} // namespace internal
+
 Id nextId()
 {
-    static Id id = 0;
-    return ++id;
+    return ++internal::id;
+}
+
+void resetId()
+{
+    internal::id = 0;
 }
 
 namespace dbus_mapping
@@ -23,18 +34,32 @@ namespace dbus_mapping
 namespace internal
 {
 
-std::map<Id, Paths> idToDbus{};
+Map staged{};
+std::shared_ptr<const Map> idToDbus = std::make_shared<const Map>();
 
 } // namespace internal
 
 void add(Id id, Paths&& paths)
 {
-    internal::idToDbus.emplace(id, std::move(paths));
+    internal::staged.emplace(id, std::move(paths));
 }
 
 Paths get(Id id)
 {
-    return internal::idToDbus.at(id);
+    return std::atomic_load(&internal::idToDbus)->at(id);
+}
+
+std::shared_ptr<const Map> publish()
+{
+    auto published = std::make_shared<const Map>(std::move(internal::staged));
+    internal::staged.clear();
+    std::atomic_store(&internal::idToDbus, published);
+    return published;
+}
+
+void discard()
+{
+    internal::staged.clear();
 }
 
 } // namespace dbus_mapping
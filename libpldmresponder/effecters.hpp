@@ -2,6 +2,8 @@
 
 #include <stdint.h>
 
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -22,11 +24,17 @@ using Id = uint16_t;
  */
 Id nextId();
 
+/** @brief Restart effecter id assignment, used when the PDR is regenerated
+ */
+void resetId();
+
 namespace dbus_mapping
 {
 using Paths = std::vector<std::string>;
+using Map = std::map<Id, Paths>;
 
-/** @brief Add an effecter id -> D-Bus objects mapping
+/** @brief Add an effecter id -> D-Bus objects mapping. The mapping is staged
+ *         until the next call to publish().
  *
  *  @param[in] id - effecter id
  *  @param[in] paths - list of D-Bus object paths
@@ -40,6 +48,16 @@ void add(Id id, Paths&& paths);
  *  @return Paths - list of D-Bus object paths
  */
 Paths get(Id id);
+
+/** @brief Replace the current mappings with the ones staged by add()
+ *
+ *  @return std::shared_ptr<const Map> - the published mappings
+ */
+std::shared_ptr<const Map> publish();
+
+/** @brief Drop the mappings staged by add() without publishing them
+ */
+void discard();
 } // namespace dbus_mapping
 
 } // namespace effecter
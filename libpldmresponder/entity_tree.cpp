@@ -0,0 +1,287 @@
+#include "entity_tree.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace entity
+{
+
+namespace
+{
+
+/** @brief Maximum number of children in one entity association PDR */
+constexpr size_t maxChildrenPerPdr = UINT8_MAX;
+
+uint64_t key(const pldm_entity& entity)
+{
+    return (static_cast<uint64_t>(entity.entity_type) << 32) |
+           (static_cast<uint64_t>(entity.entity_instance_num) << 16) |
+           entity.entity_container_id;
+}
+
+/** @brief Get the entity a PDR describes
+ *
+ *  @param[in] e - PDR entry
+ *
+ *  @return std::optional<pldm_entity> - the entity, if the PDR type has one
+ */
+std::optional<pldm_entity> describedEntity(const pdr::Entry& e)
+{
+    auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(e.data());
+    switch (hdr->type)
+    {
+        case PLDM_NUMERIC_SENSOR_PDR:
+        {
+            auto pdr = reinterpret_cast<const pldm_numeric_sensor_pdr*>(hdr);
+            return pldm_entity{pdr->entity_type, pdr->entity_instance,
+                               pdr->container_id};
+        }
+        case PLDM_STATE_SENSOR_PDR:
+        {
+            auto pdr = reinterpret_cast<const pldm_state_sensor_pdr*>(hdr);
+            return pldm_entity{pdr->entity_type, pdr->entity_instance,
+                               pdr->container_id};
+        }
+        case PLDM_STATE_EFFECTER_PDR:
+        {
+            auto pdr = reinterpret_cast<const pldm_state_effecter_pdr*>(hdr);
+            return pldm_entity{pdr->entity_type, pdr->entity_instance,
+                               pdr->container_id};
+        }
+        case PLDM_PDR_FRU_RECORD_SET:
+        {
+            auto pdr = reinterpret_cast<const pldm_pdr_fru_record_set*>(hdr);
+            return pldm_entity{pdr->entity_type, pdr->entity_instance_num,
+                               pdr->container_id};
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+} // namespace
+
+std::shared_ptr<const Tree> Tree::build(const pdr::Repo& repo)
+{
+    auto tree = std::make_shared<Tree>();
+    auto& nodes = tree->nodes;
+    nodes.reserve(repo.numEntries() + 1);
+    nodes.emplace_back();
+    tree->listed.emplace_back(false);
+
+    auto addNode = [&tree, &nodes](const pldm_entity& entity) {
+        auto [it, inserted] =
+            tree->entityToNode.emplace(key(entity), nodes.size());
+        if (inserted)
+        {
+            nodes.emplace_back();
+            nodes.back().entity = entity;
+            tree->listed.emplace_back(false);
+        }
+        return it->second;
+    };
+
+    // (node, record handle, PDR type) for every PDR that describes a node
+    struct Owned
+    {
+        NodeIndex node;
+        pdr::RecordHandle handle;
+        pdr::Type pdrType;
+    };
+    std::vector<Owned> owned;
+    owned.reserve(repo.numEntries());
+
+    pdr::RecordHandle handle = 0;
+    while (!repo.empty())
+    {
+        auto e = repo.at(handle);
+        auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(e.data());
+        if (hdr->type == PLDM_PDR_ENTITY_ASSOCIATION)
+        {
+            auto pdr =
+                reinterpret_cast<const pldm_pdr_entity_association*>(hdr);
+            auto c = addNode(pdr->container);
+            nodes[c].containerId = pdr->container_id;
+            tree->containerToNode[pdr->container_id] = c;
+            owned.push_back({c, hdr->record_handle, hdr->type});
+            for (size_t i = 0; i < pdr->num_children; ++i)
+            {
+                tree->listed[addNode(pdr->children[i])] = true;
+            }
+        }
+        else if (auto entity = describedEntity(e))
+        {
+            owned.push_back({addNode(*entity), hdr->record_handle, hdr->type});
+        }
+
+        handle = repo.getNextRecordHandle(hdr->record_handle);
+        if (!handle)
+        {
+            break;
+        }
+    }
+
+    // Attach each entity to the entity providing its container id
+    for (NodeIndex i = 1; i < nodes.size(); ++i)
+    {
+        auto containerId = nodes[i].entity.entity_container_id;
+        auto it = tree->containerToNode.find(containerId);
+        if (containerId && it != tree->containerToNode.end() &&
+            it->second != i)
+        {
+            nodes[i].parent = it->second;
+        }
+    }
+
+    // Inconsistent PDRs could describe a containment cycle, break it by
+    // moving the entity to the root
+    for (NodeIndex i = 1; i < nodes.size(); ++i)
+    {
+        NodeIndex n = nodes[i].parent;
+        for (size_t depth = 0; n != root && depth < nodes.size(); ++depth)
+        {
+            n = nodes[n].parent;
+        }
+        if (n != root)
+        {
+            nodes[i].parent = root;
+        }
+    }
+
+    // Lay the children and the record handles out contiguously per node
+    for (NodeIndex i = 1; i < nodes.size(); ++i)
+    {
+        ++nodes[nodes[i].parent].numChildren;
+    }
+    for (const auto& o : owned)
+    {
+        ++nodes[o.node].numRecords;
+    }
+    uint32_t children = 0;
+    uint32_t records = 0;
+    for (auto& n : nodes)
+    {
+        n.firstChild = children;
+        n.firstRecord = records;
+        children += n.numChildren;
+        records += n.numRecords;
+        n.numChildren = 0;
+        n.numRecords = 0;
+    }
+
+    tree->childIndices.resize(children);
+    for (NodeIndex i = 1; i < nodes.size(); ++i)
+    {
+        auto& parent = nodes[nodes[i].parent];
+        tree->childIndices[parent.firstChild + parent.numChildren++] = i;
+    }
+    tree->recordHandles.resize(records);
+    tree->recordTypes.resize(records);
+    for (const auto& o : owned)
+    {
+        auto& n = nodes[o.node];
+        auto slot = n.firstRecord + n.numRecords++;
+        tree->recordHandles[slot] = o.handle;
+        tree->recordTypes[slot] = o.pdrType;
+    }
+
+    return tree;
+}
+
+std::optional<NodeIndex> Tree::find(const pldm_entity& entity) const
+{
+    auto it = entityToNode.find(key(entity));
+    if (it == entityToNode.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::optional<NodeIndex> Tree::container(uint16_t containerId) const
+{
+    auto it = containerToNode.find(containerId);
+    if (it == containerToNode.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::vector<pdr::RecordHandle> Tree::recordsUnder(NodeIndex index,
+                                                  pdr::Type pdrType) const
+{
+    std::vector<pdr::RecordHandle> handles;
+    std::vector<NodeIndex> pending{index};
+    while (!pending.empty())
+    {
+        const auto& n = nodes.at(pending.back());
+        pending.pop_back();
+        for (auto i = n.firstRecord; i < n.firstRecord + n.numRecords; ++i)
+        {
+            if (recordTypes[i] == pdrType)
+            {
+                handles.emplace_back(recordHandles[i]);
+            }
+        }
+        // Push in reverse so that children are visited in order
+        auto [begin, end] = children(&n - nodes.data());
+        pending.insert(pending.end(), std::make_reverse_iterator(end),
+                       std::make_reverse_iterator(begin));
+    }
+    return handles;
+}
+
+pdr::Pdr Tree::associationPdrs() const
+{
+    pdr::Pdr pdrs;
+    for (NodeIndex i = 1; i < nodes.size(); ++i)
+    {
+        const auto& n = nodes[i];
+        if (!n.containerId)
+        {
+            continue;
+        }
+
+        auto [begin, end] = children(i);
+        std::vector<NodeIndex> unlisted;
+        std::copy_if(begin, end, std::back_inserter(unlisted),
+                     [this](NodeIndex c) { return !listed[c]; });
+
+        for (size_t first = 0; first < unlisted.size();
+             first += maxChildrenPerPdr)
+        {
+            auto count =
+                std::min(maxChildrenPerPdr, unlisted.size() - first);
+            pdr::Entry entry(sizeof(pldm_pdr_entity_association) -
+                             sizeof(pldm_entity) +
+                             (sizeof(pldm_entity) * count));
+            auto pdr =
+                reinterpret_cast<pldm_pdr_entity_association*>(entry.data());
+            pdr->hdr.version = 1;
+            pdr->hdr.type = PLDM_PDR_ENTITY_ASSOCIATION;
+            pdr->hdr.record_change_num = 0;
+            pdr->hdr.length = entry.size() - sizeof(pldm_pdr_hdr);
+            pdr->container_id = n.containerId;
+            pdr->association_type = PLDM_ENTITY_ASSOCIATION_PHYSICAL;
+            pdr->container = n.entity;
+            pdr->num_children = count;
+            for (size_t c = 0; c < count; ++c)
+            {
+                pdr->children[c] = nodes[unlisted[first + c]].entity;
+            }
+            pdrs.emplace_back(std::move(entry));
+        }
+    }
+    return pdrs;
+}
+
+} // namespace entity
+} // namespace responder
+} // namespace pldm
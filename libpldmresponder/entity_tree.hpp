@@ -0,0 +1,174 @@
+#pragma once
+
+#include "pdr.hpp"
+
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "libpldm/platform.h"
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace entity
+{
+
+using NodeIndex = uint32_t;
+
+/** @struct Node
+ *
+ *  @brief An entity in the association tree. Nodes live in a single pool
+ *         and refer to each other by index; the children and the PDR record
+ *         handles of a node are contiguous ranges of flat arrays.
+ */
+struct Node
+{
+    pldm_entity entity{};     //!< entity type, instance and container id
+    NodeIndex parent = 0;     //!< the root is its own parent
+    uint16_t containerId = 0; //!< container id this entity provides, if any
+    uint32_t firstChild = 0;  //!< offset into the children array
+    uint32_t numChildren = 0; //!< number of children
+    uint32_t firstRecord = 0; //!< offset into the record handles array
+    uint32_t numRecords = 0;  //!< number of PDRs describing the entity
+};
+
+/** @class Tree
+ *
+ *  @brief The entity association hierarchy described by a PDR repository.
+ *
+ *  Entities are taken from the sensor, effecter and FRU record set PDRs, and
+ *  the entity association PDRs name the entity that provides each container
+ *  id. An entity is a child of the entity that provides its container id,
+ *  entities in the system container (or in a container that no association
+ *  PDR names) are children of the root. The tree is immutable once built.
+ */
+class Tree
+{
+  public:
+    /** @brief Index of the root node, which represents the overall system */
+    static constexpr NodeIndex root = 0;
+
+    /** @brief Build the tree from the PDRs in a repository
+     *
+     *  @param[in] repo - PDR repository
+     *
+     *  @return std::shared_ptr<const Tree> - the tree
+     */
+    static std::shared_ptr<const Tree> build(const pdr::Repo& repo);
+
+    /** @brief Look up the node of an entity
+     *
+     *  @param[in] entity - entity type, instance and container id
+     *
+     *  @return std::optional<NodeIndex> - node of the entity, if known
+     */
+    std::optional<NodeIndex> find(const pldm_entity& entity) const;
+
+    /** @brief Look up the node that provides a container id
+     *
+     *  @param[in] containerId - container id
+     *
+     *  @return std::optional<NodeIndex> - the container, if known
+     */
+    std::optional<NodeIndex> container(uint16_t containerId) const;
+
+    /** @brief Access a node
+     *
+     *  @param[in] index - node index
+     *
+     *  @return const Node& - the node
+     */
+    const Node& node(NodeIndex index) const
+    {
+        return nodes.at(index);
+    }
+
+    /** @brief Get the parent of a node, the root is its own parent
+     *
+     *  @param[in] index - node index
+     *
+     *  @return NodeIndex - the parent
+     */
+    NodeIndex parent(NodeIndex index) const
+    {
+        return nodes.at(index).parent;
+    }
+
+    /** @brief Get the children of a node
+     *
+     *  @param[in] index - node index
+     *
+     *  @return std::pair<const NodeIndex*, const NodeIndex*> - begin and end
+     *          of the children of the node
+     */
+    std::pair<const NodeIndex*, const NodeIndex*>
+        children(NodeIndex index) const
+    {
+        const auto& n = nodes.at(index);
+        const auto begin = childIndices.data() + n.firstChild;
+        return {begin, begin + n.numChildren};
+    }
+
+    /** @brief Get the PDRs that describe a node
+     *
+     *  @param[in] index - node index
+     *
+     *  @return std::pair<const pdr::RecordHandle*, const pdr::RecordHandle*>
+     *          - begin and end of the record handles of the node
+     */
+    std::pair<const pdr::RecordHandle*, const pdr::RecordHandle*>
+        records(NodeIndex index) const
+    {
+        const auto& n = nodes.at(index);
+        const auto begin = recordHandles.data() + n.firstRecord;
+        return {begin, begin + n.numRecords};
+    }
+
+    /** @brief Collect the PDRs of a type that describe a node or any entity
+     *         below it, for example all the effecters of a chassis
+     *
+     *  @param[in] index - node index
+     *  @param[in] pdrType - PDR type
+     *
+     *  @return std::vector<pdr::RecordHandle> - record handles in tree order
+     */
+    std::vector<pdr::RecordHandle> recordsUnder(NodeIndex index,
+                                                pdr::Type pdrType) const;
+
+    /** @brief Encode entity association PDRs for the children that no
+     *         entity association PDR in the repository lists yet. The record
+     *         handles are left for the repository to assign.
+     *
+     *  @return pdr::Pdr - the entity association PDRs
+     */
+    pdr::Pdr associationPdrs() const;
+
+    /** @brief Get the number of nodes, including the root
+     *
+     *  @return size_t - number of nodes
+     */
+    size_t size() const
+    {
+        return nodes.size();
+    }
+
+  private:
+    std::vector<Node> nodes;
+    std::vector<NodeIndex> childIndices;
+    std::vector<pdr::RecordHandle> recordHandles;
+    std::vector<pdr::Type> recordTypes; //!< PDR type of each record handle
+    std::vector<bool> listed; //!< node is listed in an association PDR
+    std::unordered_map<uint64_t, NodeIndex> entityToNode;
+    std::unordered_map<uint16_t, NodeIndex> containerToNode;
+};
+
+} // namespace entity
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,155 @@
+#include "events.hpp"
+
+#include "utils.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <tuple>
+
+#include "libpldm/platform.h"
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace events
+{
+
+bool Queue::push(uint8_t tid, uint8_t eventClass, const uint8_t* data,
+                 size_t length)
+{
+    RawEvent event{tid, eventClass, static_cast<uint8_t>(length), {}};
+    std::memcpy(event.data.data(), data, length);
+    if (!events.push(event))
+    {
+        overflows.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+std::vector<SensorEvent> Queue::drain()
+{
+    using Key = std::tuple<uint8_t, uint16_t, uint8_t, uint8_t>;
+    std::map<Key, SensorEvent> latest;
+
+    RawEvent event{};
+    while (events.pop(event))
+    {
+        SensorEvent sensorEvent{};
+        sensorEvent.tid = event.tid;
+        size_t offset = 0;
+        auto rc = decode_sensor_event_data(
+            event.data.data(), event.length, &sensorEvent.sensorId,
+            &sensorEvent.sensorEventClass, &offset);
+        if (rc == PLDM_SUCCESS)
+        {
+            auto classData = event.data.data() + offset;
+            auto classLength = event.length - offset;
+            switch (sensorEvent.sensorEventClass)
+            {
+                case PLDM_SENSOR_OP_STATE:
+                    rc = decode_sensor_op_data(
+                        classData, classLength, &sensorEvent.eventState,
+                        &sensorEvent.previousEventState);
+                    break;
+                case PLDM_STATE_SENSOR_STATE:
+                    rc = decode_state_sensor_data(
+                        classData, classLength, &sensorEvent.sensorOffset,
+                        &sensorEvent.eventState,
+                        &sensorEvent.previousEventState);
+                    break;
+                default:
+                    rc = decode_numeric_sensor_data(
+                        classData, classLength, &sensorEvent.eventState,
+                        &sensorEvent.previousEventState,
+                        &sensorEvent.sensorDataSize,
+                        &sensorEvent.presentReading);
+                    break;
+            }
+        }
+        if (rc != PLDM_SUCCESS)
+        {
+            ++decodeErrors;
+            continue;
+        }
+
+        sensorEvent.coalesced = 1;
+        Key key{sensorEvent.tid, sensorEvent.sensorId,
+                sensorEvent.sensorEventClass, sensorEvent.sensorOffset};
+        auto [it, added] = latest.emplace(key, sensorEvent);
+        if (!added)
+        {
+            // Keep where the sensor started from, report where it is now
+            auto& coalesced = it->second;
+            coalesced.eventState = sensorEvent.eventState;
+            coalesced.sensorDataSize = sensorEvent.sensorDataSize;
+            coalesced.presentReading = sensorEvent.presentReading;
+            ++coalesced.coalesced;
+        }
+    }
+
+    std::vector<SensorEvent> batch;
+    batch.reserve(latest.size());
+    for (const auto& [key, sensorEvent] : latest)
+    {
+        batch.push_back(sensorEvent);
+    }
+    return batch;
+}
+
+void publish(const SensorEvent& event)
+{
+    static constexpr auto eventPath = "/xyz/openbmc_project/pldm";
+    static constexpr auto eventInterface = "xyz.openbmc_project.PLDM.Event";
+
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    try
+    {
+        switch (event.sensorEventClass)
+        {
+            case PLDM_SENSOR_OP_STATE:
+            {
+                auto msg = bus.new_signal(eventPath, eventInterface,
+                                          "SensorOpStateEvent");
+                msg.append(event.tid, event.sensorId, event.eventState,
+                           event.previousEventState);
+                msg.signal_send();
+                break;
+            }
+            case PLDM_STATE_SENSOR_STATE:
+            {
+                auto msg = bus.new_signal(eventPath, eventInterface,
+                                          "StateSensorEvent");
+                msg.append(event.tid, event.sensorId, event.sensorOffset,
+                           event.eventState, event.previousEventState);
+                msg.signal_send();
+                break;
+            }
+            default:
+            {
+                auto msg = bus.new_signal(eventPath, eventInterface,
+                                          "NumericSensorEvent");
+                msg.append(event.tid, event.sensorId, event.eventState,
+                           event.previousEventState, event.sensorDataSize,
+                           event.presentReading);
+                msg.signal_send();
+                break;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to publish sensor event, TID="
+                  << static_cast<unsigned>(event.tid)
+                  << " SENSOR_ID=" << event.sensorId
+                  << " ERROR=" << e.what() << "\n";
+    }
+}
+
+} // namespace events
+} // namespace responder
+} // namespace pldm
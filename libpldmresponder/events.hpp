@@ -0,0 +1,186 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace events
+{
+
+/** @brief Longest event data queued, sensor events need at most 10 bytes */
+constexpr size_t maxEventDataLength = 32;
+
+/** @brief Number of events the queue holds */
+constexpr size_t queueCapacity = 1024;
+
+/** @class RingBuffer
+ *
+ *  @brief Bounded lock-free queue with a single producer and a single
+ *         consumer. Pushing to a full queue fails instead of blocking.
+ *
+ *  @tparam T - the queued item, copy assignable
+ *  @tparam Capacity - number of items the queue holds, a power of two
+ */
+template <typename T, size_t Capacity>
+class RingBuffer
+{
+    static_assert(Capacity && !(Capacity & (Capacity - 1)),
+                  "Capacity must be a power of two");
+
+  public:
+    /** @brief Append an item, called by the producer only
+     *
+     *  @param[in] item - the item
+     *
+     *  @return bool - false if the queue is full
+     */
+    bool push(const T& item)
+    {
+        auto tail = this->tail.load(std::memory_order_relaxed);
+        if (tail - head.load(std::memory_order_acquire) == Capacity)
+        {
+            return false;
+        }
+        items[tail & (Capacity - 1)] = item;
+        this->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief Remove the oldest item, called by the consumer only
+     *
+     *  @param[out] item - the item
+     *
+     *  @return bool - false if the queue is empty
+     */
+    bool pop(T& item)
+    {
+        auto head = this->head.load(std::memory_order_relaxed);
+        if (head == tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        item = items[head & (Capacity - 1)];
+        this->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    /** @brief Index of the next item to pop, written by the consumer */
+    alignas(64) std::atomic<size_t> head{0};
+
+    /** @brief Index of the next item to push, written by the producer */
+    alignas(64) std::atomic<size_t> tail{0};
+
+    /** @brief The items */
+    std::unique_ptr<T[]> items = std::make_unique<T[]>(Capacity);
+};
+
+/** @struct RawEvent
+ *
+ *  @brief An event as received, decoded when the queue is drained
+ */
+struct RawEvent
+{
+    uint8_t tid;        //!< terminus that sent the event
+    uint8_t eventClass; //!< PLDM event class
+    uint8_t length;     //!< length of the event data
+    std::array<uint8_t, maxEventDataLength> data; //!< event data
+};
+
+/** @struct SensorEvent
+ *
+ *  @brief A sensor event, standing for all the events the same sensor sent
+ *         since the queue was last drained
+ */
+struct SensorEvent
+{
+    uint8_t tid;                //!< terminus that sent the event
+    uint16_t sensorId;          //!< sensor the event is from
+    uint8_t sensorEventClass;   //!< pldm_sensor_event_message_types
+    uint8_t sensorOffset;       //!< composite sensor, for state sensors
+    uint8_t eventState;         //!< state in the latest event
+    uint8_t previousEventState; //!< previous state in the earliest event
+    uint8_t sensorDataSize;     //!< format of presentReading
+    uint32_t presentReading;    //!< reading in the latest numeric event
+    uint32_t coalesced;         //!< number of events this one stands for
+};
+
+/** @class Queue
+ *
+ *  @brief Queue of received platform events. Events are queued as received,
+ *         without decoding them, so that the responder can acknowledge them
+ *         right away. Draining the queue decodes the events and coalesces
+ *         them into one event per sensor.
+ */
+class Queue
+{
+  public:
+    /** @brief Queue an event
+     *
+     *  @param[in] tid - terminus that sent the event
+     *  @param[in] eventClass - PLDM event class
+     *  @param[in] data - event data
+     *  @param[in] length - length of the event data, at most
+     *                      maxEventDataLength
+     *
+     *  @return bool - false if the event was dropped because the queue is
+     *          full, the drop is counted
+     */
+    bool push(uint8_t tid, uint8_t eventClass, const uint8_t* data,
+              size_t length);
+
+    /** @brief Empty the queue
+     *
+     *  @return std::vector<SensorEvent> - the queued sensor events, one per
+     *          sensor, ordered by terminus and sensor
+     */
+    std::vector<SensorEvent> drain();
+
+    /** @brief Get the number of events dropped because the queue was full
+     *
+     *  @return uint64_t - number of dropped events
+     */
+    uint64_t getOverflows() const
+    {
+        return overflows.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Get the number of queued events that couldn't be decoded
+     *
+     *  @return uint64_t - number of malformed events
+     */
+    uint64_t getDecodeErrors() const
+    {
+        return decodeErrors;
+    }
+
+  private:
+    /** @brief The queued events */
+    RingBuffer<RawEvent, queueCapacity> events;
+
+    /** @brief Number of events dropped */
+    std::atomic<uint64_t> overflows{0};
+
+    /** @brief Number of malformed events, updated by the consumer */
+    uint64_t decodeErrors = 0;
+};
+
+/** @brief Publish a sensor event as a signal on D-Bus, a signal that can't
+ *         be sent is logged
+ *
+ *  @param[in] event - the sensor event
+ */
+void publish(const SensorEvent& event);
+
+} // namespace events
+} // namespace responder
+} // namespace pldm
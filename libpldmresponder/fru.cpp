@@ -207,19 +207,41 @@ Response Handler::getFRURecordTable(const pldm_msg* request,
         return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
     }
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    uint32_t transferHandle = 0;
+    uint8_t transferOpFlag = 0;
+    auto rc = decode_get_fru_record_table_req(
+        request, payloadLength, &transferHandle, &transferOpFlag);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
 
-    auto rc =
-        encode_get_fru_record_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                         0, PLDM_START_AND_END, responsePtr);
+    transfer::Part part;
+    rc = getTablePart(request, 0, transferHandle, transferOpFlag,
+                      [this](std::shared_ptr<const transfer::Table>& table) {
+                          auto fruTable = std::make_shared<transfer::Table>();
+                          impl.getFRUTable(*fruTable);
+                          table = std::move(fruTable);
+                          return static_cast<uint8_t>(PLDM_SUCCESS);
+                      },
+                      part);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
     }
 
-    impl.getFRUTable(response);
+    Response response(sizeof(pldm_msg_hdr) +
+                          PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES,
+                      0);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    rc = encode_get_fru_record_table_resp(
+        request->hdr.instance_id, PLDM_SUCCESS, part.nextTransferHandle,
+        part.transferFlag, responsePtr);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+    response.insert(response.end(), part.data, part.data + part.length);
 
     return response;
 }
@@ -1,5 +1,15 @@
 #include "pdr.hpp"
 
+#include "entity_tree.hpp"
+#include "pdr_generator.hpp"
+#include "sensors.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
 namespace pldm
 {
 
@@ -9,16 +19,272 @@ namespace responder
 namespace pdr
 {
 
-Repo& get(const std::string& dir)
+namespace internal
+{
+
+/** @brief The published snapshot, only ever accessed with atomic loads and
+ *         stores
+ */
+std::shared_ptr<const Snapshot> current{};
+
+/** @brief Serialises rebuilds, readers never take this lock */
+std::mutex buildMutex{};
+
+std::atomic<bool> rebuildRequested{false};
+std::atomic<bool> rebuildRunning{false};
+
+/** @brief Files that failed to parse in background rebuilds, not reported
+ *         yet
+ */
+std::atomic<size_t> asyncFailures{0};
+
+/** @brief PDRs fetched from each remote terminus, guarded by buildMutex */
+std::map<uint8_t, std::vector<Entry>> remoteEntries{};
+
+/** @brief Append the remote PDRs to a repository, with local record handles
+ *
+ *  @param[in,out] repo - the repository
+ *
+ *  @return std::shared_ptr<const RemoteRecords> - origin of the appended PDRs
+ */
+std::shared_ptr<const RemoteRecords> appendRemote(IndexedRepo& repo)
+{
+    auto origins = std::make_shared<RemoteRecords>();
+    for (const auto& [eid, entries] : remoteEntries)
+    {
+        for (auto entry : entries)
+        {
+            auto hdr = reinterpret_cast<pldm_pdr_hdr*>(entry.data());
+            auto handle = repo.getNextRecordHandle();
+            origins->emplace(handle, RemoteRecord{eid, hdr->record_handle});
+            hdr->record_handle = handle;
+            repo.add(std::move(entry));
+        }
+    }
+    return origins;
+}
+
+/** @brief Publish a snapshot with the local PDRs of the current one and the
+ *         remote PDRs, called with buildMutex held
+ */
+void republishRemote()
+{
+    auto prev = std::atomic_load(&current);
+    if (!prev)
+    {
+        // The first build picks up the remote PDRs
+        return;
+    }
+
+    auto repo = std::make_shared<IndexedRepo>(prev->repo->getSignature() + 1);
+    auto localEntries = prev->repo->numEntries() -
+                        (prev->remote ? prev->remote->size() : 0);
+    for (RecordHandle handle = 1; handle <= localEntries; ++handle)
+    {
+        repo->add(prev->repo->at(handle));
+    }
+    auto remote = appendRemote(*repo);
+    std::atomic_store(&current, std::make_shared<const Snapshot>(Snapshot{
+                                    repo, prev->effecterPaths, prev->entities,
+                                    prev->sensorMappings, remote}));
+}
+
+/** @brief Parse and encode one PDR JSON file
+ *
+ *  @param[in] path - path of the PDR JSON file
+ *
+ *  @return ParsedFile - the encoded PDRs and any error to report
+ */
+ParsedFile parseFile(const fs::path& path)
+{
+    static const auto eraseLen = strlen(".json");
+    ParsedFile parsed{};
+    try
+    {
+        auto json = readJson(path.string());
+        if (!json.empty())
+        {
+            auto fileName = path.filename().string();
+            fileName.erase(fileName.end() - eraseLen);
+            parsed.pdrType = stoi(fileName);
+            Generators::parse(parsed.pdrType, json, parsed.records);
+        }
+    }
+    catch (const InternalFailure& e)
+    {
+    }
+    catch (const std::exception& e)
+    {
+        parsed.error = e.what();
+    }
+
+    return parsed;
+}
+
+void merge(Record& record)
+{
+    Generators::merge(record);
+}
+
+} // namespace internal
+
+namespace internal
+{
+
+std::vector<ParsedFile> parse(const std::vector<fs::path>& files)
+{
+    std::vector<ParsedFile> parsed(files.size());
+    std::atomic<size_t> next{0};
+    auto worker = [&files, &parsed, &next]() {
+        for (size_t i = next++; i < files.size(); i = next++)
+        {
+            parsed[i] = parseFile(files[i]);
+        }
+    };
+
+    size_t numThreads =
+        std::min<size_t>(std::thread::hardware_concurrency(), files.size());
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < numThreads; ++i)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool)
+    {
+        thread.join();
+    }
+
+    return parsed;
+}
+
+} // namespace internal
+
+std::shared_ptr<const Snapshot> getSnapshot(const std::string& dir)
+{
+    auto snapshot = std::atomic_load(&internal::current);
+    if (!snapshot || snapshot->repo->empty())
+    {
+        rebuild(dir);
+        snapshot = std::atomic_load(&internal::current);
+    }
+
+    return snapshot;
+}
+
+namespace internal
+{
+
+/** @brief Regenerate the PDR and publish it as a new snapshot
+ *
+ *  @param[in] dir - directory housing platform specific PDR JSON files
+ *
+ *  @return size_t - number of PDR JSON files that failed to parse
+ */
+size_t build(const std::string& dir)
+{
+    std::lock_guard<std::mutex> lock(buildMutex);
+
+    auto prev = std::atomic_load(&current);
+    uint32_t signature = prev ? prev->repo->getSignature() + 1 : 1;
+    auto repo = std::make_shared<IndexedRepo>(signature);
+
+    effecter::resetId();
+    sensor::resetId();
+    size_t failures = 0;
+    try
+    {
+        failures = generate(dir, *repo);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to generate PDR, DIR=" << dir
+                  << " ERROR=" << e.what() << "\n";
+        if (prev)
+        {
+            // Keep serving the previous snapshot
+            effecter::dbus_mapping::discard();
+            sensor::dbus_mapping::discard();
+            return failures;
+        }
+    }
+
+    // Entities found in the sensor, effecter and FRU PDRs that no entity
+    // association PDR lists yet get association PDRs of their own
+    auto entities = entity::Tree::build(*repo);
+    auto associations = entities->associationPdrs();
+    if (!associations.empty())
+    {
+        for (auto& e : associations)
+        {
+            auto hdr = reinterpret_cast<pldm_pdr_hdr*>(e.data());
+            hdr->record_handle = repo->getNextRecordHandle();
+            repo->add(std::move(e));
+        }
+        entities = entity::Tree::build(*repo);
+    }
+
+    auto remote = appendRemote(*repo);
+    auto effecterPaths = effecter::dbus_mapping::publish();
+    auto sensorMappings = sensor::dbus_mapping::publish();
+    std::atomic_store(&current, std::make_shared<const Snapshot>(Snapshot{
+                                    repo, effecterPaths, entities,
+                                    sensorMappings, remote}));
+    return failures;
+}
+
+} // namespace internal
+
+void rebuild(const std::string& dir)
+{
+    internal::reportErrors(internal::build(dir));
+}
+
+void rebuildAsync(const std::string& dir, std::function<void()> notify)
 {
     using namespace internal;
-    static IndexedRepo repo;
-    if (repo.empty())
+    rebuildRequested = true;
+    bool running = false;
+    if (!rebuildRunning.compare_exchange_strong(running, true))
     {
-        generate(dir, repo);
+        // The rebuild in progress will pick up this request
+        return;
     }
 
-    return repo;
+    std::thread([dir, notify = std::move(notify)]() {
+        do
+        {
+            while (rebuildRequested.exchange(false))
+            {
+                asyncFailures += build(dir);
+                notify();
+            }
+            rebuildRunning = false;
+        } while (rebuildRequested && !rebuildRunning.exchange(true));
+    }).detach();
+}
+
+void finishRebuilds()
+{
+    internal::reportErrors(internal::asyncFailures.exchange(0));
+}
+
+void mergeRemote(uint8_t eid, std::vector<Entry>&& records)
+{
+    using namespace internal;
+    std::lock_guard<std::mutex> lock(buildMutex);
+    remoteEntries[eid] = std::move(records);
+    republishRemote();
+}
+
+void removeRemote(uint8_t eid)
+{
+    using namespace internal;
+    std::lock_guard<std::mutex> lock(buildMutex);
+    if (remoteEntries.erase(eid))
+    {
+        republishRemote();
+    }
 }
 
 } // namespace pdr
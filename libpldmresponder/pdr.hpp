@@ -1,6 +1,7 @@
 #pragma once
 
 #include "effecters.hpp"
+#include "sensors.hpp"
 #include "utils.hpp"
 
 #include <stdint.h>
@@ -10,6 +11,7 @@
 #include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
@@ -27,6 +29,11 @@ namespace pldm
 namespace responder
 {
 
+namespace entity
+{
+class Tree;
+} // namespace entity
+
 namespace pdr
 {
 
@@ -92,6 +99,58 @@ class Repo
     /** @brief Empty the PDR
      */
     virtual void makeEmpty() = 0;
+
+    /** @brief Get the repository signature, which changes every time the
+     *         repository is regenerated
+     *
+     *  @return uint32_t - repository signature
+     */
+    virtual uint32_t getSignature() const = 0;
+};
+
+/** @struct RemoteRecord
+ *
+ *  @brief Where a PDR fetched from a remote terminus came from
+ */
+struct RemoteRecord
+{
+    uint8_t eid;         //!< MCTP endpoint of the terminus
+    RecordHandle handle; //!< record handle in the terminus's repository
+};
+
+/** @brief Origin of the remote PDRs, by local record handle */
+using RemoteRecords = std::map<RecordHandle, RemoteRecord>;
+
+/** @struct Snapshot
+ *
+ *  @brief An immutable view of the PDR repository along with the effecter
+ *         and sensor D-Bus mappings and the entity association tree generated
+ *         from the same PDR JSONs. A new snapshot is published with an atomic
+ *         pointer swap each time the repository is rebuilt, readers keep
+ *         their snapshot alive for as long as they need a consistent view.
+ *
+ *  The PDRs fetched from remote termini follow the local PDRs in the
+ *  repository. The mappings and the entity tree only describe the local
+ *  PDRs.
+ */
+struct Snapshot
+{
+    std::shared_ptr<const Repo> repo;
+    std::shared_ptr<const effecter::dbus_mapping::Map> effecterPaths;
+    std::shared_ptr<const entity::Tree> entities;
+    std::shared_ptr<const sensor::dbus_mapping::Map> sensorMappings;
+    std::shared_ptr<const RemoteRecords> remote;
+
+    /** @brief Check if a PDR was fetched from a remote terminus
+     *
+     *  @param[in] handle - record handle
+     *
+     *  @return bool - true for a remote PDR
+     */
+    bool isRemote(RecordHandle handle) const
+    {
+        return remote && remote->count(handle);
+    }
 };
 
 namespace internal
@@ -126,6 +185,14 @@ inline Json readJson(const std::string& path)
 class IndexedRepo : public Repo
 {
   public:
+    /** @brief Constructor
+     *
+     *  @param[in] signature - repository signature
+     */
+    explicit IndexedRepo(uint32_t signature = 0) : signature(signature)
+    {
+    }
+
     void add(Entry&& entry)
     {
         repo.emplace_back(std::move(entry));
@@ -173,153 +240,168 @@ class IndexedRepo : public Repo
         repo.clear();
     }
 
+    uint32_t getSignature() const
+    {
+        return signature;
+    }
+
   private:
     Pdr repo{};
+    uint32_t signature = 0;
 };
 
+/** @struct Record
+ *
+ *  @brief A PDR encoded by the parse phase of generate(). The fields that
+ *         depend on the order of all the records, the record handle and the
+ *         sensor or effecter id, are filled in by the merge phase.
+ */
+struct Record
+{
+    Entry entry;                            //!< encoded PDR
+    effecter::dbus_mapping::Paths paths;    //!< D-Bus objects of an effecter
+    sensor::dbus_mapping::Mappings sensors; //!< D-Bus properties of a sensor
+};
+
+/** @struct ParsedFile
+ *
+ *  @brief Outcome of parsing one platform specific PDR JSON file
+ */
+struct ParsedFile
+{
+    Type pdrType{};              //!< PDR type named by the file
+    std::vector<Record> records; //!< records encoded before any error
+    std::string error;           //!< error to report, empty on success
+};
+
+/** @brief Parse and encode the PDR JSON files, one task per file on a pool
+ *         of worker threads
+ *
+ *  @param[in] files - paths of the PDR JSON files
+ *
+ *  @return std::vector<ParsedFile> - one result per file, in input order
+ */
+std::vector<ParsedFile> parse(const std::vector<fs::path>& files);
+
+/** @brief Assign the fields of an encoded PDR that depend on the order of all
+ *         the records, such as the sensor and effecter ids
+ *
+ *  @param[in,out] record - encoded PDR
+ */
+void merge(Record& record);
+
 /** @brief Parse PDR JSONs and build PDR repository
+ *
+ *  The JSON files are parsed and encoded in parallel, the records are then
+ *  merged into the repository in directory order, which assigns the record
+ *  handles and the sensor and effecter ids exactly as a sequential build
+ *  would.
+ *
+ *  Files that fail to parse are logged but not reported, generate() may run
+ *  off the event loop and reporting an error takes D-Bus calls. The caller
+ *  reports them with reportErrors() from the event loop.
  *
  *  @param[in] dir - directory housing platform specific PDR JSON files
  *  @tparam[in] repo - instance of concrete implementation of Repo
+ *
+ *  @return size_t - number of files that failed to parse
  */
 template <typename T>
-void generate(const std::string& dir, T& repo)
+size_t generate(const std::string& dir, T& repo)
 {
-    using namespace internal;
-    // A map of PDR type to a lambda that handles creation of that PDR type.
-    // The lambda essentially would parse the platform specific PDR JSONs to
-    // generate the PDR structures. This function iterates through the map to
-    // invoke all lambdas, so that all PDR types can be created.
-    std::map<Type, std::function<void(const Json& json, T& repo)>> generators =
-        {{PLDM_STATE_EFFECTER_PDR, [](const auto& json, T& repo) {
-              static const std::vector<Json> emptyList{};
-              static const Json empty{};
-              auto entries = json.value("entries", emptyList);
-              for (const auto& e : entries)
-              {
-                  size_t pdrSize = 0;
-                  auto effecters = e.value("effecters", emptyList);
-                  static const Json empty{};
-                  for (const auto& effecter : effecters)
-                  {
-                      auto set = effecter.value("set", empty);
-                      auto statesSize = set.value("size", 0);
-                      if (!statesSize)
-                      {
-                          std::cerr
-                              << "Malformed PDR JSON - no state set info, TYPE="
-                              << PLDM_STATE_EFFECTER_PDR << "\n";
-                          throw InternalFailure();
-                      }
-                      pdrSize += sizeof(state_effecter_possible_states) -
-                                 sizeof(bitfield8_t) +
-                                 (sizeof(bitfield8_t) * statesSize);
-                  }
-                  pdrSize += sizeof(pldm_state_effecter_pdr) - sizeof(uint8_t);
-
-                  Entry pdrEntry{};
-                  pdrEntry.resize(pdrSize);
-
-                  pldm_state_effecter_pdr* pdr =
-                      reinterpret_cast<pldm_state_effecter_pdr*>(
-                          pdrEntry.data());
-                  pdr->hdr.record_handle = repo.getNextRecordHandle();
-                  pdr->hdr.version = 1;
-                  pdr->hdr.type = PLDM_STATE_EFFECTER_PDR;
-                  pdr->hdr.record_change_num = 0;
-                  pdr->hdr.length = pdrSize - sizeof(pldm_pdr_hdr);
-
-                  pdr->terminus_handle = 0;
-                  pdr->effecter_id = effecter::nextId();
-                  pdr->entity_type = e.value("type", 0);
-                  pdr->entity_instance = e.value("instance", 0);
-                  pdr->container_id = e.value("container", 0);
-                  pdr->effecter_semantic_id = 0;
-                  pdr->effecter_init = PLDM_NO_INIT;
-                  pdr->has_description_pdr = false;
-                  pdr->composite_effecter_count = effecters.size();
-
-                  using namespace effecter::dbus_mapping;
-                  Paths paths{};
-                  uint8_t* start = pdrEntry.data() +
-                                   sizeof(pldm_state_effecter_pdr) -
-                                   sizeof(uint8_t);
-                  for (const auto& effecter : effecters)
-                  {
-                      auto set = effecter.value("set", empty);
-                      state_effecter_possible_states* possibleStates =
-                          reinterpret_cast<state_effecter_possible_states*>(
-                              start);
-                      possibleStates->state_set_id = set.value("id", 0);
-                      possibleStates->possible_states_size =
-                          set.value("size", 0);
-
-                      start += sizeof(possibleStates->state_set_id) +
-                               sizeof(possibleStates->possible_states_size);
-                      static const std::vector<uint8_t> emptyStates{};
-                      auto states = set.value("states", emptyStates);
-                      for (const auto& state : states)
-                      {
-                          auto index = state / 8;
-                          auto bit = state - (index * 8);
-                          bitfield8_t* bf =
-                              reinterpret_cast<bitfield8_t*>(start + index);
-                          bf->byte |= 1 << bit;
-                      }
-                      start += possibleStates->possible_states_size;
-
-                      auto dbus = effecter.value("dbus", empty);
-                      paths.emplace_back(std::move(dbus));
-                  }
-                  add(pdr->effecter_id, std::move(paths));
-                  repo.add(std::move(pdrEntry));
-              }
-          }}};
-
-    auto eraseLen = strlen(".json");
-    Type pdrType{};
+    std::vector<fs::path> files;
     for (const auto& dirEntry : fs::directory_iterator(dir))
     {
-        try
-        {
-            auto json = readJson(dirEntry.path().string());
-            if (!json.empty())
-            {
-                auto fileName = dirEntry.path().filename().string();
-                fileName.erase(fileName.end() - eraseLen);
-                pdrType = stoi(fileName);
-                generators.at(pdrType)(json, repo);
-            }
-        }
-        catch (const InternalFailure& e)
-        {
-        }
-        catch (const Json::exception& e)
+        files.emplace_back(dirEntry.path());
+    }
+
+    size_t failures = 0;
+    for (auto& file : parse(files))
+    {
+        for (auto& record : file.records)
         {
-            std::cerr << "Failed parsing PDR JSON file, TYPE= " << pdrType
-                      << " ERROR=" << e.what() << "\n";
-            pldm::utils::reportError(
-                "xyz.openbmc_project.bmc.pldm.InternalFailure");
+            auto hdr = reinterpret_cast<pldm_pdr_hdr*>(record.entry.data());
+            hdr->record_handle = repo.getNextRecordHandle();
+            merge(record);
+            repo.add(std::move(record.entry));
         }
-        catch (const std::exception& e)
+
+        if (!file.error.empty())
         {
-            std::cerr << "Failed parsing PDR JSON file, TYPE= " << pdrType
-                      << " ERROR=" << e.what() << "\n";
-            pldm::utils::reportError(
-                "xyz.openbmc_project.bmc.pldm.InternalFailure");
+            std::cerr << "Failed parsing PDR JSON file, TYPE= " << file.pdrType
+                      << " ERROR=" << file.error << "\n";
+            ++failures;
         }
     }
+
+    return failures;
+}
+
+/** @brief Report PDR JSON files that failed to parse, with D-Bus calls
+ *
+ *  @param[in] failures - number of files that failed to parse
+ */
+inline void reportErrors(size_t failures)
+{
+    for (size_t i = 0; i < failures; ++i)
+    {
+        pldm::utils::reportError(
+            "xyz.openbmc_project.bmc.pldm.InternalFailure");
+    }
 }
 
 } // namespace internal
 
-/** @brief Build (if not built already) and retrieve PDR
+/** @brief Build (if not built already) and retrieve the current PDR snapshot
  *
  *  @param[in] dir - directory housing platform specific PDR JSON files
  *
- *  @return Repo& - Reference to instance of pdr::Repo
+ *  @return std::shared_ptr<const Snapshot> - the published snapshot
+ */
+std::shared_ptr<const Snapshot> getSnapshot(const std::string& dir);
+
+/** @brief Regenerate the PDR from the JSON files and publish it as a new
+ *         snapshot. Readers never block and never see a partially built
+ *         repository; concurrent rebuilds are serialised.
+ *
+ *  @param[in] dir - directory housing platform specific PDR JSON files
+ */
+void rebuild(const std::string& dir);
+
+/** @brief Rebuild the PDR on a background thread. Requests that arrive while
+ *         a rebuild is in progress are coalesced into a single follow-up
+ *         rebuild.
+ *
+ *  The bus isn't thread safe, so nothing on the background thread makes a
+ *  D-Bus call. Once a snapshot is published notify wakes the event loop,
+ *  which calls finishRebuilds().
+ *
+ *  @param[in] dir - directory housing platform specific PDR JSON files
+ *  @param[in] notify - wakes the event loop, called on the background thread
+ */
+void rebuildAsync(const std::string& dir, std::function<void()> notify);
+
+/** @brief Report the PDR JSON files that failed to parse in the background
+ *         rebuilds so far, called from the event loop
+ */
+void finishRebuilds();
+
+/** @brief Merge the PDRs fetched from a remote terminus into the repository,
+ *         replacing the ones fetched from it before, and publish a new
+ *         snapshot. The PDRs get local record handles following the local
+ *         PDRs, the snapshot maps them back to the terminus's handles.
+ *
+ *  @param[in] eid - MCTP endpoint of the terminus
+ *  @param[in] records - the terminus's PDRs, in its record handle order
+ */
+void mergeRemote(uint8_t eid, std::vector<Entry>&& records);
+
+/** @brief Remove the PDRs fetched from a remote terminus and publish a new
+ *         snapshot
+ *
+ *  @param[in] eid - MCTP endpoint of the terminus
  */
-Repo& get(const std::string& dir);
+void removeRemote(uint8_t eid);
 
 } // namespace pdr
 } // namespace responder
@@ -0,0 +1,562 @@
+#include "pdr_generator.hpp"
+
+#include "sensors.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace pdr
+{
+
+namespace internal
+{
+
+namespace
+{
+
+const std::vector<Json> emptyList{};
+const Json empty{};
+
+/** @brief Length of the possible states fields of a state sensor or state
+ *         effecter PDR. The layout is the same for both.
+ *
+ *  @param[in] composites - the "sensors" or "effecters" JSON list
+ *  @param[in] pdrType - PDR type, for error reporting
+ *
+ *  @return size_t - length of the possible states fields
+ */
+size_t possibleStatesSize(const std::vector<Json>& composites, Type pdrType)
+{
+    size_t size = 0;
+    for (const auto& composite : composites)
+    {
+        auto set = composite.value("set", empty);
+        auto statesSize = set.value("size", 0);
+        if (!statesSize)
+        {
+            std::cerr << "Malformed PDR JSON - no state set info, TYPE="
+                      << static_cast<int>(pdrType) << "\n";
+            throw InternalFailure();
+        }
+        size += sizeof(state_effecter_possible_states) - sizeof(bitfield8_t) +
+                (sizeof(bitfield8_t) * statesSize);
+    }
+    return size;
+}
+
+/** @brief Encode the possible states fields of a state sensor or state
+ *         effecter PDR
+ *
+ *  @param[in] composites - the "sensors" or "effecters" JSON list
+ *  @param[in] start - where the possible states fields begin
+ */
+void encodePossibleStates(const std::vector<Json>& composites, uint8_t* start)
+{
+    static const std::vector<uint8_t> emptyStates{};
+    for (const auto& composite : composites)
+    {
+        auto set = composite.value("set", empty);
+        state_effecter_possible_states* possibleStates =
+            reinterpret_cast<state_effecter_possible_states*>(start);
+        possibleStates->state_set_id = set.value("id", 0);
+        possibleStates->possible_states_size = set.value("size", 0);
+
+        start += sizeof(possibleStates->state_set_id) +
+                 sizeof(possibleStates->possible_states_size);
+        auto states = set.value("states", emptyStates);
+        for (const auto& state : states)
+        {
+            auto index = state / 8;
+            auto bit = state - (index * 8);
+            bitfield8_t* bf = reinterpret_cast<bitfield8_t*>(start + index);
+            bf->byte |= 1 << bit;
+        }
+        start += possibleStates->possible_states_size;
+    }
+}
+
+/** @brief Convert a JSON value to a D-Bus property value
+ *
+ *  @param[in] type - type of the D-Bus property
+ *  @param[in] value - JSON value
+ *
+ *  @return pldm::utils::PropertyValue - the D-Bus property value
+ */
+pldm::utils::PropertyValue toPropertyValue(const std::string& type,
+                                           const Json& value)
+{
+    if (type == "uint8_t")
+    {
+        return value.get<uint8_t>();
+    }
+    else if (type == "uint16_t")
+    {
+        return value.get<uint16_t>();
+    }
+    else if (type == "uint32_t")
+    {
+        return value.get<uint32_t>();
+    }
+    else if (type == "uint64_t")
+    {
+        return value.get<uint64_t>();
+    }
+    else if (type == "int16_t")
+    {
+        return value.get<int16_t>();
+    }
+    else if (type == "int32_t")
+    {
+        return value.get<int32_t>();
+    }
+    else if (type == "int64_t")
+    {
+        return value.get<int64_t>();
+    }
+    else if (type == "bool")
+    {
+        return value.get<bool>();
+    }
+    else if (type == "double")
+    {
+        return value.get<double>();
+    }
+    return value.get<std::string>();
+}
+
+/** @brief Parse the D-Bus property a sensor reads. A sensor without a
+ *         "dbus" section has an empty mapping and is reported unavailable.
+ *
+ *  @param[in] dbus - the "dbus" JSON of a sensor
+ *  @param[in] states - the states, in the order of the property values
+ *
+ *  @return sensor::dbus_mapping::Mapping - the D-Bus mapping
+ */
+sensor::dbus_mapping::Mapping parseSensorMapping(const Json& dbus,
+                                                 const std::vector<int>& states)
+{
+    sensor::dbus_mapping::Mapping mapping{};
+    if (dbus.is_null())
+    {
+        return mapping;
+    }
+    mapping.objectPath = dbus.value("object_path", "");
+    mapping.interface = dbus.value("interface", "");
+    mapping.propertyName = dbus.value("property_name", "");
+
+    auto type = dbus.value("property_type", "string");
+    auto values = dbus.value("property_values", emptyList);
+    if (values.size() != states.size())
+    {
+        std::cerr << "Malformed PDR JSON - property values don't match the "
+                     "states, TYPE="
+                  << static_cast<int>(PLDM_STATE_SENSOR_PDR)
+                  << " PATH=" << mapping.objectPath << "\n";
+        throw InternalFailure();
+    }
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        mapping.states.emplace(toPropertyValue(type, values[i]), states[i]);
+    }
+    return mapping;
+}
+
+/** @brief Numeric sensor field formats, shared by the sensor data size and
+ *         the range field format, which use the same values for integers
+ */
+const std::map<std::string, uint8_t> numericFormats = {
+    {"uint8", PLDM_RANGE_FIELD_FORMAT_UINT8},
+    {"sint8", PLDM_RANGE_FIELD_FORMAT_SINT8},
+    {"uint16", PLDM_RANGE_FIELD_FORMAT_UINT16},
+    {"sint16", PLDM_RANGE_FIELD_FORMAT_SINT16},
+    {"uint32", PLDM_RANGE_FIELD_FORMAT_UINT32},
+    {"sint32", PLDM_RANGE_FIELD_FORMAT_SINT32},
+    {"real32", PLDM_RANGE_FIELD_FORMAT_REAL32}};
+
+/** @brief Look up a numeric sensor field format
+ *
+ *  @param[in] entry - numeric sensor PDR JSON entry
+ *  @param[in] key - "data_size" or "range_field_format"
+ *  @param[in] max - largest format allowed for the key
+ *
+ *  @return uint8_t - the field format
+ */
+uint8_t numericFormat(const Json& entry, const char* key, uint8_t max)
+{
+    auto name = entry.value(key, "uint8");
+    auto it = numericFormats.find(name);
+    if (it == numericFormats.end() || it->second > max)
+    {
+        std::cerr << "Malformed PDR JSON - invalid numeric format, TYPE="
+                  << PLDM_NUMERIC_SENSOR_PDR << " " << key << "=" << name
+                  << "\n";
+        throw InternalFailure();
+    }
+    return it->second;
+}
+
+/** @brief Width in bytes of a numeric sensor field
+ *
+ *  @param[in] format - the field format
+ *
+ *  @return size_t - width of the field
+ */
+size_t numericWidth(uint8_t format)
+{
+    switch (format)
+    {
+        case PLDM_RANGE_FIELD_FORMAT_UINT8:
+        case PLDM_RANGE_FIELD_FORMAT_SINT8:
+            return sizeof(uint8_t);
+        case PLDM_RANGE_FIELD_FORMAT_UINT16:
+        case PLDM_RANGE_FIELD_FORMAT_SINT16:
+            return sizeof(uint16_t);
+        default:
+            return sizeof(uint32_t);
+    }
+}
+
+/** @brief Convert a JSON number to the type of a numeric sensor field
+ *
+ *  @param[in] number - the JSON number
+ *
+ *  @return T - the number
+ *
+ *  @throw std::out_of_range if the field can't hold the number
+ */
+template <typename T>
+T fieldValue(const Json& number)
+{
+    // Every field format is exact in a double
+    auto value = number.get<double>();
+    if (value < std::numeric_limits<T>::lowest() ||
+        value > std::numeric_limits<T>::max())
+    {
+        throw std::out_of_range("Numeric sensor field out of range, VALUE=" +
+                                number.dump());
+    }
+    return number.get<T>();
+}
+
+/** @brief Write a numeric sensor field and advance past it
+ *
+ *  @param[in] format - the field format
+ *  @param[in] value - JSON number to write
+ *  @param[in,out] pos - where the field is written
+ *
+ *  @throw std::out_of_range if the field can't hold the number
+ */
+void writeNumeric(uint8_t format, const Json& value, uint8_t*& pos)
+{
+    auto write = [&pos](auto v) {
+        std::memcpy(pos, &v, sizeof(v));
+        pos += sizeof(v);
+    };
+    auto number = value.is_number() ? value : Json(0);
+
+    switch (format)
+    {
+        case PLDM_RANGE_FIELD_FORMAT_UINT8:
+            write(fieldValue<uint8_t>(number));
+            break;
+        case PLDM_RANGE_FIELD_FORMAT_SINT8:
+            write(fieldValue<int8_t>(number));
+            break;
+        case PLDM_RANGE_FIELD_FORMAT_UINT16:
+            write(fieldValue<uint16_t>(number));
+            break;
+        case PLDM_RANGE_FIELD_FORMAT_SINT16:
+            write(fieldValue<int16_t>(number));
+            break;
+        case PLDM_RANGE_FIELD_FORMAT_UINT32:
+            write(fieldValue<uint32_t>(number));
+            break;
+        case PLDM_RANGE_FIELD_FORMAT_SINT32:
+            write(fieldValue<int32_t>(number));
+            break;
+        default:
+            write(fieldValue<float>(number));
+            break;
+    }
+}
+
+/** @brief The range fields of a numeric sensor PDR, in PDR order, along with
+ *         their bit in the range field support bitfield. The warning limits
+ *         are advertised through the supported thresholds instead.
+ */
+constexpr std::pair<const char*, uint8_t> rangeFields[] = {
+    {"nominal_value", 1 << 0}, {"normal_max", 1 << 1},
+    {"normal_min", 1 << 2},    {"warning_high", 0},
+    {"warning_low", 0},        {"critical_high", 1 << 3},
+    {"critical_low", 1 << 4},  {"fatal_high", 1 << 5},
+    {"fatal_low", 1 << 6}};
+
+/** @brief Length of the fields of a numeric sensor PDR that follow the sensor
+ *         data size, excluding the ones that depend on the sensor data size
+ *         and the range field format
+ */
+constexpr size_t numericFixedTail =
+    sizeof(float) + sizeof(float) + sizeof(uint16_t) + sizeof(uint8_t) +
+    sizeof(uint8_t) + sizeof(bitfield8_t) + sizeof(bitfield8_t) +
+    sizeof(float) + sizeof(float) + sizeof(uint8_t) + sizeof(bitfield8_t);
+
+/** @brief Encode a PLDM entity
+ *
+ *  @param[in] json - entity JSON, with "type", "instance" and "container"
+ *  @param[out] entity - encoded entity
+ */
+void encodeEntity(const Json& json, pldm_entity& entity)
+{
+    entity.entity_type = json.value("type", 0);
+    entity.entity_instance_num = json.value("instance", 0);
+    entity.entity_container_id = json.value("container", 0);
+}
+
+} // namespace
+
+size_t Generator<PLDM_NUMERIC_SENSOR_PDR>::size(const Json& entry)
+{
+    auto dataWidth = numericWidth(numericFormat(
+        entry, "data_size", PLDM_SENSOR_DATA_SIZE_SINT32));
+    auto rangeWidth = numericWidth(numericFormat(
+        entry, "range_field_format", PLDM_RANGE_FIELD_FORMAT_REAL32));
+
+    return sizeof(pldm_numeric_sensor_pdr) - sizeof(uint8_t) +
+           numericFixedTail + (3 * dataWidth) +
+           (std::size(rangeFields) * rangeWidth);
+}
+
+void Generator<PLDM_NUMERIC_SENSOR_PDR>::encode(const Json& entry,
+                                                Record& record)
+{
+    auto pdr =
+        reinterpret_cast<pldm_numeric_sensor_pdr*>(record.entry.data());
+    pdr->terminus_handle = 0;
+    pdr->entity_type = entry.value("type", 0);
+    pdr->entity_instance = entry.value("instance", 0);
+    pdr->container_id = entry.value("container", 0);
+    pdr->sensor_init = PLDM_SENSOR_NO_INIT;
+    pdr->sensor_auxiliary_names_pdr = false;
+    pdr->base_unit = entry.value("base_unit", 0);
+    pdr->unit_modifier = entry.value("unit_modifier", 0);
+    pdr->rate_unit = entry.value("rate_unit", 0);
+    pdr->base_oem_unit_handle = 0;
+    pdr->aux_unit = 0;
+    pdr->aux_unit_modifier = 0;
+    pdr->aux_rate_unit = 0;
+    pdr->rel = 0;
+    pdr->aux_oem_unit_handle = 0;
+    pdr->is_linear = entry.value("is_linear", true);
+
+    auto dataSize =
+        numericFormat(entry, "data_size", PLDM_SENSOR_DATA_SIZE_SINT32);
+    auto rangeFormat = numericFormat(entry, "range_field_format",
+                                     PLDM_RANGE_FIELD_FORMAT_REAL32);
+    pdr->sensor_data_size = dataSize;
+
+    uint8_t* pos = pdr->variable_fields;
+    writeNumeric(PLDM_RANGE_FIELD_FORMAT_REAL32,
+                 entry.value("resolution", Json(1)), pos);
+    writeNumeric(PLDM_RANGE_FIELD_FORMAT_REAL32, entry.value("offset", empty),
+                 pos);
+    writeNumeric(PLDM_RANGE_FIELD_FORMAT_UINT16,
+                 entry.value("accuracy", empty), pos);
+    writeNumeric(PLDM_RANGE_FIELD_FORMAT_UINT8,
+                 entry.value("plus_tolerance", empty), pos);
+    writeNumeric(PLDM_RANGE_FIELD_FORMAT_UINT8,
+                 entry.value("minus_tolerance", empty), pos);
+    writeNumeric(dataSize, entry.value("hysteresis", empty), pos);
+    writeNumeric(PLDM_RANGE_FIELD_FORMAT_UINT8,
+                 entry.value("supported_thresholds", empty), pos);
+    writeNumeric(PLDM_RANGE_FIELD_FORMAT_UINT8,
+                 entry.value("threshold_and_hysteresis_volatility", empty),
+                 pos);
+    writeNumeric(PLDM_RANGE_FIELD_FORMAT_REAL32,
+                 entry.value("state_transition_interval", empty), pos);
+    writeNumeric(PLDM_RANGE_FIELD_FORMAT_REAL32,
+                 entry.value("update_interval", empty), pos);
+    writeNumeric(dataSize, entry.value("max_readable", empty), pos);
+    writeNumeric(dataSize, entry.value("min_readable", empty), pos);
+    *pos++ = rangeFormat;
+
+    bitfield8_t rangeSupport{};
+    for (const auto& [field, bit] : rangeFields)
+    {
+        if (entry.contains(field))
+        {
+            rangeSupport.byte |= bit;
+        }
+    }
+    *pos++ = rangeSupport.byte;
+    for (const auto& [field, bit] : rangeFields)
+    {
+        writeNumeric(rangeFormat, entry.value(field, empty), pos);
+    }
+
+    auto dbus = entry.value("dbus", empty);
+    if (!dbus.is_null())
+    {
+        sensor::dbus_mapping::Mapping mapping{};
+        mapping.objectPath = dbus.value("object_path", "");
+        mapping.interface =
+            dbus.value("interface", "xyz.openbmc_project.Sensor.Value");
+        mapping.propertyName = dbus.value("property_name", "Value");
+        record.sensors.emplace_back(std::move(mapping));
+    }
+}
+
+void Generator<PLDM_NUMERIC_SENSOR_PDR>::merge(Record& record)
+{
+    auto pdr =
+        reinterpret_cast<pldm_numeric_sensor_pdr*>(record.entry.data());
+    pdr->sensor_id = sensor::nextId();
+    if (!record.sensors.empty())
+    {
+        sensor::dbus_mapping::add(pdr->sensor_id, std::move(record.sensors));
+    }
+}
+
+size_t Generator<PLDM_STATE_SENSOR_PDR>::size(const Json& entry)
+{
+    return sizeof(pldm_state_sensor_pdr) - sizeof(uint8_t) +
+           possibleStatesSize(entry.value("sensors", emptyList),
+                              PLDM_STATE_SENSOR_PDR);
+}
+
+void Generator<PLDM_STATE_SENSOR_PDR>::encode(const Json& entry,
+                                              Record& record)
+{
+    auto sensors = entry.value("sensors", emptyList);
+    auto pdr = reinterpret_cast<pldm_state_sensor_pdr*>(record.entry.data());
+    pdr->terminus_handle = 0;
+    pdr->entity_type = entry.value("type", 0);
+    pdr->entity_instance = entry.value("instance", 0);
+    pdr->container_id = entry.value("container", 0);
+    pdr->sensor_init = PLDM_SENSOR_NO_INIT;
+    pdr->sensor_auxiliary_names_pdr = false;
+    pdr->composite_sensor_count = sensors.size();
+
+    encodePossibleStates(sensors, pdr->possible_states);
+
+    static const std::vector<int> emptyStates{};
+    record.sensors.reserve(sensors.size());
+    for (const auto& sensor : sensors)
+    {
+        auto set = sensor.value("set", empty);
+        record.sensors.emplace_back(
+            parseSensorMapping(sensor.value("dbus", empty),
+                               set.value("states", emptyStates)));
+    }
+}
+
+void Generator<PLDM_STATE_SENSOR_PDR>::merge(Record& record)
+{
+    auto pdr = reinterpret_cast<pldm_state_sensor_pdr*>(record.entry.data());
+    pdr->sensor_id = sensor::nextId();
+    sensor::dbus_mapping::add(pdr->sensor_id, std::move(record.sensors));
+}
+
+size_t Generator<PLDM_STATE_EFFECTER_PDR>::size(const Json& entry)
+{
+    return sizeof(pldm_state_effecter_pdr) - sizeof(uint8_t) +
+           possibleStatesSize(entry.value("effecters", emptyList),
+                              PLDM_STATE_EFFECTER_PDR);
+}
+
+void Generator<PLDM_STATE_EFFECTER_PDR>::encode(const Json& entry,
+                                                Record& record)
+{
+    auto effecters = entry.value("effecters", emptyList);
+    auto pdr =
+        reinterpret_cast<pldm_state_effecter_pdr*>(record.entry.data());
+    pdr->terminus_handle = 0;
+    pdr->entity_type = entry.value("type", 0);
+    pdr->entity_instance = entry.value("instance", 0);
+    pdr->container_id = entry.value("container", 0);
+    pdr->effecter_semantic_id = 0;
+    pdr->effecter_init = PLDM_NO_INIT;
+    pdr->has_description_pdr = false;
+    pdr->composite_effecter_count = effecters.size();
+
+    encodePossibleStates(effecters, pdr->possible_states);
+
+    record.paths.reserve(effecters.size());
+    for (const auto& effecter : effecters)
+    {
+        auto dbus = effecter.value("dbus", empty);
+        record.paths.emplace_back(std::move(dbus));
+    }
+}
+
+void Generator<PLDM_STATE_EFFECTER_PDR>::merge(Record& record)
+{
+    auto pdr =
+        reinterpret_cast<pldm_state_effecter_pdr*>(record.entry.data());
+    pdr->effecter_id = effecter::nextId();
+    effecter::dbus_mapping::add(pdr->effecter_id, std::move(record.paths));
+}
+
+size_t Generator<PLDM_PDR_ENTITY_ASSOCIATION>::size(const Json& entry)
+{
+    auto children = entry.value("children", emptyList);
+    if (children.empty())
+    {
+        std::cerr << "Malformed PDR JSON - no child entities, TYPE="
+                  << PLDM_PDR_ENTITY_ASSOCIATION << "\n";
+        throw InternalFailure();
+    }
+    return sizeof(pldm_pdr_entity_association) - sizeof(pldm_entity) +
+           (sizeof(pldm_entity) * children.size());
+}
+
+void Generator<PLDM_PDR_ENTITY_ASSOCIATION>::encode(const Json& entry,
+                                                    Record& record)
+{
+    auto children = entry.value("children", emptyList);
+    auto pdr =
+        reinterpret_cast<pldm_pdr_entity_association*>(record.entry.data());
+    pdr->container_id = entry.value("container_id", 0);
+    pdr->association_type =
+        entry.value("association_type", "physical") == "logical"
+            ? PLDM_ENTITY_ASSOCIATION_LOGICAL
+            : PLDM_ENTITY_ASSOCIATION_PHYSICAL;
+    encodeEntity(entry.value("container", empty), pdr->container);
+    pdr->num_children = children.size();
+
+    auto child = pdr->children;
+    for (const auto& c : children)
+    {
+        encodeEntity(c, *child++);
+    }
+}
+
+size_t Generator<PLDM_PDR_FRU_RECORD_SET>::size(const Json& /*entry*/)
+{
+    return sizeof(pldm_pdr_fru_record_set);
+}
+
+void Generator<PLDM_PDR_FRU_RECORD_SET>::encode(const Json& entry,
+                                                Record& record)
+{
+    auto pdr = reinterpret_cast<pldm_pdr_fru_record_set*>(record.entry.data());
+    pdr->terminus_handle = 0;
+    pdr->fru_rsi = entry.value("fru_rsi", 0);
+    pdr->entity_type = entry.value("type", 0);
+    pdr->entity_instance_num = entry.value("instance", 0);
+    pdr->container_id = entry.value("container", 0);
+}
+
+} // namespace internal
+} // namespace pdr
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "pdr.hpp"
+
+#include <stdexcept>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace pdr
+{
+
+namespace internal
+{
+
+/** @struct Generator
+ *
+ *  @brief Encodes the PDRs of one PDR type from a platform specific PDR JSON.
+ *         Specialise this for each PDR type that can be described in JSON
+ *         and list the type in Generators. A specialisation provides:
+ *
+ *  static size_t size(const Json& entry) - length of the PDR that encodes
+ *      entry, the record is sized exactly once with this
+ *  static void encode(const Json& entry, Record& record) - encode the
+ *      fields following the common PDR header into record.entry
+ *  static void merge(Record& record) - assign the fields that depend on the
+ *      order of all records, such as sensor and effecter ids
+ */
+template <Type pdrType>
+struct Generator;
+
+template <>
+struct Generator<PLDM_NUMERIC_SENSOR_PDR>
+{
+    static size_t size(const Json& entry);
+    static void encode(const Json& entry, Record& record);
+    static void merge(Record& record);
+};
+
+template <>
+struct Generator<PLDM_STATE_SENSOR_PDR>
+{
+    static size_t size(const Json& entry);
+    static void encode(const Json& entry, Record& record);
+    static void merge(Record& record);
+};
+
+template <>
+struct Generator<PLDM_STATE_EFFECTER_PDR>
+{
+    static size_t size(const Json& entry);
+    static void encode(const Json& entry, Record& record);
+    static void merge(Record& record);
+};
+
+template <>
+struct Generator<PLDM_PDR_ENTITY_ASSOCIATION>
+{
+    static size_t size(const Json& entry);
+    static void encode(const Json& entry, Record& record);
+    static void merge(Record& /*record*/)
+    {
+    }
+};
+
+template <>
+struct Generator<PLDM_PDR_FRU_RECORD_SET>
+{
+    static size_t size(const Json& entry);
+    static void encode(const Json& entry, Record& record);
+    static void merge(Record& /*record*/)
+    {
+    }
+};
+
+/** @struct Registry
+ *
+ *  @brief Dispatches a PDR type known only at runtime to the Generator of
+ *         that type, out of the PDR types the registry is instantiated with
+ */
+template <Type... pdrTypes>
+struct Registry
+{
+    /** @brief Encode the PDRs described by a PDR JSON
+     *
+     *  @param[in] pdrType - PDR type named by the JSON file
+     *  @param[in] json - PDR JSON
+     *  @param[out] records - encoded PDRs are appended here
+     *
+     *  @throw std::out_of_range if there's no generator for pdrType
+     */
+    static void parse(Type pdrType, const Json& json,
+                      std::vector<Record>& records)
+    {
+        if (!((pdrType == pdrTypes && (parseAll<pdrTypes>(json, records), 1)) ||
+              ...))
+        {
+            throw std::out_of_range("No PDR generator for the PDR type");
+        }
+    }
+
+    /** @brief Assign the order dependent fields of an encoded PDR
+     *
+     *  @param[in,out] record - encoded PDR
+     */
+    static void merge(Record& record)
+    {
+        auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(record.entry.data());
+        ((hdr->type == pdrTypes && (Generator<pdrTypes>::merge(record), 1)) ||
+         ...);
+    }
+
+  private:
+    template <Type pdrType>
+    static void parseAll(const Json& json, std::vector<Record>& records)
+    {
+        static const std::vector<Json> emptyList{};
+        auto entries = json.value("entries", emptyList);
+        records.reserve(records.size() + entries.size());
+        for (const auto& e : entries)
+        {
+            auto pdrSize = Generator<pdrType>::size(e);
+
+            Record record{};
+            record.entry.resize(pdrSize);
+            auto hdr = reinterpret_cast<pldm_pdr_hdr*>(record.entry.data());
+            hdr->version = 1;
+            hdr->type = pdrType;
+            hdr->record_change_num = 0;
+            hdr->length = pdrSize - sizeof(pldm_pdr_hdr);
+
+            Generator<pdrType>::encode(e, record);
+            records.emplace_back(std::move(record));
+        }
+    }
+};
+
+/** @brief The PDR types that can be generated from PDR JSONs */
+using Generators =
+    Registry<PLDM_NUMERIC_SENSOR_PDR, PLDM_STATE_SENSOR_PDR,
+             PLDM_STATE_EFFECTER_PDR, PLDM_PDR_ENTITY_ASSOCIATION,
+             PLDM_PDR_FRU_RECORD_SET>;
+
+} // namespace internal
+} // namespace pdr
+} // namespace responder
+} // namespace pldm
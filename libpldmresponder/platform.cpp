@@ -3,6 +3,9 @@
 
 #include "utils.hpp"
 
+#include <cstring>
+#include <set>
+
 namespace pldm
 {
 namespace responder
@@ -12,6 +15,338 @@ namespace platform
 
 using namespace pldm::responder::effecter::dbus_mapping;
 
+namespace
+{
+
+/** @brief Build the D-Bus action of a state set
+ *
+ *  @param[in] interface - D-Bus interface
+ *  @param[in] property - D-Bus property
+ *  @param[in] keepsState - whether the property holds the state, rather
+ *                          than requests a transition
+ *  @param[in] values - D-Bus property value for each state that has one
+ *
+ *  @return StateSetAction - the action
+ */
+StateSetAction
+    makeAction(const char* interface, const char* property, bool keepsState,
+               std::initializer_list<std::pair<uint8_t, const char*>> values)
+{
+    StateSetAction action{interface, property, {}, {}, {}, keepsState};
+    for (const auto& [state, value] : values)
+    {
+        action.values.emplace_back(std::string(value));
+        action.valueIndex[state] = action.values.size();
+        action.states.emplace(value, state);
+    }
+    return action;
+}
+
+/** @brief Get the D-Bus action of a state set
+ *
+ *  @param[in] stateSetId - state set id
+ *
+ *  @return const StateSetAction* - the action, nullptr if the state set has
+ *          no D-Bus mapping
+ */
+const StateSetAction* getStateSetAction(uint16_t stateSetId)
+{
+    static const std::map<uint16_t, StateSetAction> actions = {
+        {PLDM_BOOT_PROGRESS_STATE,
+         makeAction(
+             "xyz.openbmc_project.State.OperatingSystem.Status",
+             "OperatingSystemState", true,
+             {{PLDM_BOOT_NOT_ACTIVE,
+               "xyz.openbmc_project.State.OperatingSystem.Status.OSStatus."
+               "Standby"},
+              {PLDM_BOOT_COMPLETED,
+               "xyz.openbmc_project.State.OperatingSystem.Status.OSStatus."
+               "BootComplete"}})},
+        {PLDM_SYSTEM_POWER_STATE,
+         makeAction("xyz.openbmc_project.State.Chassis",
+                    "RequestedPowerTransition", false,
+                    {{PLDM_OFF_SOFT_GRACEFUL,
+                      "xyz.openbmc_project.State.Chassis.Transition.Off"}})}};
+
+    auto iter = actions.find(stateSetId);
+    return iter == actions.end() ? nullptr : &iter->second;
+}
+
+} // namespace
+
+EffecterPlans compileEffecterPlans(const pdr::Snapshot& snapshot)
+{
+    EffecterPlans plans;
+    const auto& pdrRepo = *snapshot.repo;
+    if (pdrRepo.empty())
+    {
+        return plans;
+    }
+
+    pdr::RecordHandle recordHndl = 0;
+    do
+    {
+        auto pdrEntry = pdrRepo.at(recordHndl);
+        auto header = reinterpret_cast<const pldm_pdr_hdr*>(pdrEntry.data());
+        recordHndl = header->record_handle;
+        if (header->type != PLDM_STATE_EFFECTER_PDR ||
+            snapshot.isRemote(recordHndl))
+        {
+            continue;
+        }
+
+        auto pdr =
+            reinterpret_cast<const pldm_state_effecter_pdr*>(pdrEntry.data());
+        auto paths = snapshot.effecterPaths->find(pdr->effecter_id);
+        if (pdr->effecter_id >= plans.size())
+        {
+            plans.resize(pdr->effecter_id + 1);
+        }
+        auto& composites = plans[pdr->effecter_id].composites;
+        composites.resize(pdr->composite_effecter_count);
+
+        auto states = reinterpret_cast<const state_effecter_possible_states*>(
+            pdr->possible_states);
+        for (size_t i = 0; i < composites.size(); ++i)
+        {
+            auto& composite = composites[i];
+            composite.stateSetId = states->state_set_id;
+            composite.action = getStateSetAction(states->state_set_id);
+            // computation is based on table 79 from DSP0248 v1.1.1
+            for (size_t index = 0; index < states->possible_states_size &&
+                                   index < composite.possibleStates.size() / 8;
+                 ++index)
+            {
+                for (size_t bit = 0; bit < 8; ++bit)
+                {
+                    if (states->states[index].byte & (1 << bit))
+                    {
+                        composite.possibleStates.set(index * 8 + bit);
+                    }
+                }
+            }
+            if (paths != snapshot.effecterPaths->end() &&
+                i < paths->second.size())
+            {
+                composite.path = paths->second[i];
+            }
+
+            auto nextState =
+                reinterpret_cast<const uint8_t*>(states) +
+                sizeof(state_effecter_possible_states) -
+                sizeof(states->states) +
+                (states->possible_states_size * sizeof(states->states));
+            states = reinterpret_cast<const state_effecter_possible_states*>(
+                nextState);
+        }
+    } while ((recordHndl = pdrRepo.getNextRecordHandle(recordHndl)));
+
+    return plans;
+}
+
+std::shared_ptr<const EffecterPlans> Handler::getEffecterPlans()
+{
+    auto snapshot = pdr::getSnapshot(PDR_JSONS_DIR);
+    if (snapshot != plannedSnapshot)
+    {
+        effecterPlans = std::make_shared<const EffecterPlans>(
+            compileEffecterPlans(*snapshot));
+        plannedSnapshot = std::move(snapshot);
+
+        effecterStates.clear();
+        for (const auto& plan : *effecterPlans)
+        {
+            effecterStates.emplace_back(plan.composites.size(), unknownState);
+        }
+    }
+    return effecterPlans;
+}
+
+void Handler::watchEffecterStates()
+{
+    getEffecterPlans();
+    if (watchedSnapshot == plannedSnapshot)
+    {
+        return;
+    }
+    watchedSnapshot = plannedSnapshot;
+    effecterMatches.clear();
+
+    std::set<std::string> paths;
+    for (const auto& plan : *effecterPlans)
+    {
+        for (const auto& composite : plan.composites)
+        {
+            if (composite.action && !composite.path.empty())
+            {
+                paths.emplace(composite.path);
+            }
+        }
+    }
+
+    namespace rules = sdbusplus::bus::match::rules;
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    for (const auto& path : paths)
+    {
+        try
+        {
+            effecterMatches.emplace_back(
+                std::make_unique<sdbusplus::bus::match::match>(
+                    bus,
+                    rules::type_signal() + rules::member("PropertiesChanged") +
+                        rules::path(path) +
+                        rules::interface(pldm::utils::dbusProperties),
+                    [this, path](sdbusplus::message::message& msg) {
+                        effecterPropertiesChanged(path, msg);
+                    }));
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to watch effecter object, PATH=" << path
+                      << " ERROR=" << e.what() << "\n";
+        }
+    }
+}
+
+void Handler::effecterPropertiesChanged(const std::string& path,
+                                        sdbusplus::message::message& msg)
+{
+    std::string interface;
+    pldm::utils::PropertyMap properties;
+    bool decoded = true;
+    try
+    {
+        msg.read(interface, properties);
+    }
+    catch (const std::exception& e)
+    {
+        decoded = false;
+    }
+
+    for (size_t id = 0; id < effecterStates.size(); ++id)
+    {
+        const auto& composites = (*effecterPlans)[id].composites;
+        for (size_t i = 0; i < composites.size(); ++i)
+        {
+            const auto action = composites[i].action;
+            if (!action || composites[i].path != path)
+            {
+                continue;
+            }
+            if (!decoded)
+            {
+                // Can't tell what changed, so forget what we knew
+                effecterStates[id][i] = unknownState;
+                continue;
+            }
+            if (interface != action->interface)
+            {
+                continue;
+            }
+            auto property = properties.find(action->property);
+            if (property == properties.end())
+            {
+                continue;
+            }
+            auto value = std::get_if<std::string>(&property->second);
+            auto state = value ? action->states.find(*value)
+                               : action->states.end();
+            effecterStates[id][i] =
+                state == action->states.end() ? unknownState : state->second;
+        }
+    }
+}
+
+void Handler::watchSensors()
+{
+    // The remote PDRs come and go without changing the local sensors
+    auto snapshot = pdr::getSnapshot(PDR_JSONS_DIR);
+    if (sensorSnapshot &&
+        snapshot->sensorMappings == sensorSnapshot->sensorMappings)
+    {
+        sensorSnapshot = std::move(snapshot);
+        return;
+    }
+    sensorMatches.clear();
+    auto states = std::make_unique<sensor::StateTable>(*snapshot);
+    auto numerics = std::make_unique<sensor::NumericTable>(*snapshot);
+
+    auto objects = states->objects();
+    auto numericObjects = numerics->objects();
+    objects.insert(objects.end(), numericObjects.begin(),
+                   numericObjects.end());
+
+    // Subscribe before reading, so no change falls in between
+    namespace rules = sdbusplus::bus::match::rules;
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    std::set<std::string> paths;
+    for (const auto& object : objects)
+    {
+        const auto& path = object.first;
+        if (!paths.emplace(path).second)
+        {
+            continue;
+        }
+
+        try
+        {
+            sensorMatches.emplace_back(
+                std::make_unique<sdbusplus::bus::match::match>(
+                    bus,
+                    rules::type_signal() + rules::member("PropertiesChanged") +
+                        rules::path(path) +
+                        rules::interface(pldm::utils::dbusProperties),
+                    [this, path](sdbusplus::message::message& msg) {
+                        sensorPropertiesChanged(path, msg);
+                    }));
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to watch sensor object, PATH=" << path
+                      << " ERROR=" << e.what() << "\n";
+        }
+    }
+
+    const pldm::utils::DBusHandler dBusIntf;
+    auto properties =
+        dBusIntf.getDbusPropertiesConcurrently(objects, dbusTimeout);
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        const auto& [path, interface] = objects[i];
+        if (!properties[i])
+        {
+            std::cerr << "Failed to read sensor object, PATH=" << path
+                      << " INTERFACE=" << interface << "\n";
+            continue;
+        }
+        states->update(path, interface, *properties[i]);
+        numerics->update(path, interface, *properties[i]);
+    }
+
+    stateSensors = std::move(states);
+    numericSensors = std::move(numerics);
+    sensorSnapshot = std::move(snapshot);
+}
+
+void Handler::sensorPropertiesChanged(const std::string& path,
+                                      sdbusplus::message::message& msg)
+{
+    std::string interface;
+    pldm::utils::PropertyMap properties;
+    try
+    {
+        msg.read(interface, properties);
+    }
+    catch (const std::exception& e)
+    {
+        stateSensors->invalidate(path);
+        numericSensors->invalidate(path);
+        return;
+    }
+    stateSensors->update(path, interface, properties);
+    numericSensors->update(path, interface, properties);
+}
+
 Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
 {
     Response response(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_MIN_RESP_BYTES, 0);
@@ -41,7 +376,8 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
     uint8_t* recordData = nullptr;
     try
     {
-        pdr::Repo& pdrRepo = pdr::get(PDR_JSONS_DIR);
+        auto snapshot = pdr::getSnapshot(PDR_JSONS_DIR);
+        const pdr::Repo& pdrRepo = *snapshot->repo;
         nextRecordHandle = pdrRepo.getNextRecordHandle(recordHandle);
         pdr::Entry e;
         if (reqSizeBytes)
@@ -109,6 +445,7 @@ Response Handler::setStateEffecterStates(const pldm_msg* request,
     }
 
     stateField.resize(compEffecterCnt);
+    watchEffecterStates();
     const pldm::utils::DBusHandler dBusIntf;
     rc = setStateEffecterStatesHandler<pldm::utils::DBusHandler>(
         dBusIntf, effecterId, stateField);
@@ -127,6 +464,183 @@ Response Handler::setStateEffecterStates(const pldm_msg* request,
     return response;
 }
 
+Response Handler::platformEventMessage(const pldm_msg* request,
+                                       size_t payloadLength)
+{
+    uint8_t formatVersion{};
+    uint8_t tid{};
+    uint8_t eventClass{};
+    size_t offset{};
+
+    auto rc = decode_platform_event_message_req(
+        request, payloadLength, &formatVersion, &tid, &eventClass, &offset);
+    if (rc != PLDM_SUCCESS)
+    {
+        return CmdHandler::ccOnlyResponse(request, rc);
+    }
+
+    if (eventClass != PLDM_SENSOR_EVENT)
+    {
+        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+    }
+    if (payloadLength - offset > events::maxEventDataLength)
+    {
+        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+    }
+
+    // The event is decoded when the queue is drained, a full queue drops it
+    // rather than holding up the responder
+    uint8_t status = PLDM_EVENT_NO_LOGGING;
+    if (!eventQueue.push(tid, eventClass, request->payload + offset,
+                         payloadLength - offset))
+    {
+        status = PLDM_EVENT_LOGGING_REJECTED;
+    }
+    else
+    {
+        if (!eventTimer)
+        {
+            eventTimer = std::make_unique<sdeventplus::utility::Timer<
+                sdeventplus::ClockId::Monotonic>>(
+                sdeventplus::Event::get_default(),
+                [this](auto& /*timer*/) { publishEvents(); });
+        }
+        if (!eventTimer->isEnabled())
+        {
+            eventTimer->restartOnce(eventBatchWindow);
+        }
+    }
+
+    Response response(
+        sizeof(pldm_msg_hdr) + PLDM_PLATFORM_EVENT_MESSAGE_RESP_BYTES, 0);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    rc = encode_platform_event_message_resp(request->hdr.instance_id,
+                                            PLDM_SUCCESS, status, responsePtr);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+
+    return response;
+}
+
+void Handler::publishEvents()
+{
+    for (const auto& event : eventQueue.drain())
+    {
+        events::publish(event);
+    }
+}
+
+Response Handler::getSensorReading(const pldm_msg* request,
+                                   size_t payloadLength)
+{
+    uint16_t sensorId{};
+    bool8_t rearmEventState{};
+
+    if (payloadLength != PLDM_GET_SENSOR_READING_REQ_BYTES)
+    {
+        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+    }
+
+    int rc = decode_get_sensor_reading_req(request, payloadLength, &sensorId,
+                                           &rearmEventState);
+    if (rc != PLDM_SUCCESS)
+    {
+        return CmdHandler::ccOnlyResponse(request, rc);
+    }
+
+    // Sensors don't generate events, so there is no event state to rearm
+    if (!numericSensors)
+    {
+        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+    }
+    sensor::NumericReading reading{};
+    rc = numericSensors->getReading(sensorId, reading);
+    if (rc != PLDM_SUCCESS)
+    {
+        return CmdHandler::ccOnlyResponse(request, rc);
+    }
+
+    // Data sizes come in unsigned and signed pairs of 1, 2 and 4 bytes. The
+    // leading bytes of the little endian 32 bit reading are the narrower
+    // reading.
+    size_t width = size_t(1) << (reading.dataSize / 2);
+    uint32_t presentReading = htole32(static_cast<uint32_t>(reading.raw));
+
+    size_t responseLength = PLDM_GET_SENSOR_READING_MIN_RESP_BYTES - 1 + width;
+    Response response(sizeof(pldm_msg_hdr) + responseLength, 0);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    rc = encode_get_sensor_reading_resp(
+        request->hdr.instance_id, PLDM_SUCCESS, reading.dataSize,
+        reading.opState, PLDM_NO_EVENT_GENERATION, reading.presentState,
+        reading.previousState, reading.presentState,
+        reinterpret_cast<const uint8_t*>(&presentReading), responsePtr,
+        responseLength);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+
+    return response;
+}
+
+Response Handler::getStateSensorReadings(const pldm_msg* request,
+                                         size_t payloadLength)
+{
+    uint16_t sensorId{};
+    bitfield8_t sensorRearm{};
+    uint8_t reserved{};
+
+    if (payloadLength != PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES)
+    {
+        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+    }
+
+    int rc = decode_get_state_sensor_readings_req(
+        request, payloadLength, &sensorId, &sensorRearm, &reserved);
+    if (rc != PLDM_SUCCESS)
+    {
+        return CmdHandler::ccOnlyResponse(request, rc);
+    }
+
+    // Sensors aren't latched, so there is nothing to rearm
+    if (!stateSensors)
+    {
+        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+    }
+    std::vector<get_sensor_state_field> stateField;
+    rc = stateSensors->getReadings(sensorId, stateField);
+    if (rc != PLDM_SUCCESS)
+    {
+        return CmdHandler::ccOnlyResponse(request, rc);
+    }
+
+    constexpr auto maxCompositeSensorCnt = 8;
+    if (stateField.size() > maxCompositeSensorCnt)
+    {
+        std::cerr << "Too many composite sensors, SENSOR_ID=" << sensorId
+                  << " COMP_SENSOR_CNT=" << stateField.size() << "\n";
+        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR);
+    }
+
+    Response response(sizeof(pldm_msg_hdr) +
+                          PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
+                          sizeof(get_sensor_state_field) *
+                              (stateField.size() - 1),
+                      0);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    rc = encode_get_state_sensor_readings_resp(
+        request->hdr.instance_id, PLDM_SUCCESS, stateField.size(),
+        stateField.data(), responsePtr);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+
+    return response;
+}
+
 } // namespace platform
 } // namespace responder
 } // namespace pldm
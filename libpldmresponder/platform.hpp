@@ -3,12 +3,24 @@
 #include "config.h"
 
 #include "handler.hpp"
+#include "libpldmresponder/events.hpp"
 #include "libpldmresponder/pdr.hpp"
+#include "libpldmresponder/sensor_readings.hpp"
 #include "utils.hpp"
 
 #include <stdint.h>
 
+#include <array>
+#include <bitset>
+#include <chrono>
 #include <map>
+#include <memory>
+#include <sdbusplus/bus/match.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/utility/timer.hpp>
+#include <string>
+#include <variant>
+#include <vector>
 
 #include "libpldm/platform.h"
 #include "libpldm/states.h"
@@ -20,10 +32,81 @@ namespace responder
 namespace platform
 {
 
+/** @struct StateSetAction
+ *
+ *  @brief How the states of a state set are written to D-Bus
+ */
+struct StateSetAction
+{
+    const char* interface; //!< D-Bus interface
+    const char* property;  //!< D-Bus property
+    /** @brief 1 + index into values for each state, 0 if the state has no
+     *         D-Bus value */
+    std::array<uint8_t, 256> valueIndex{};
+    std::vector<std::variant<std::string>> values; //!< property values
+    std::map<std::string, uint8_t> states; //!< state of each property value
+
+    /** @brief Whether the property holds the state the object is in, so
+     *         writing the state it holds changes nothing. A requested
+     *         transition keeps its value once it's carried out, so it's
+     *         written every time.
+     */
+    bool keepsState = false;
+};
+
+/** @struct CompositePlan
+ *
+ *  @brief Everything needed to set one composite state effecter, resolved
+ *         from the PDR and the D-Bus mapping when the PDR is loaded
+ */
+struct CompositePlan
+{
+    std::bitset<256> possibleStates; //!< states allowed by the PDR
+    uint16_t stateSetId = 0;         //!< state set id from the PDR
+    /** @brief D-Bus action for the state set, nullptr if the state set has
+     *         no D-Bus mapping */
+    const StateSetAction* action = nullptr;
+    std::string path; //!< D-Bus object path
+};
+
+/** @struct EffecterPlan
+ *
+ *  @brief Precompiled plan to execute SetStateEffecterStates on an effecter
+ */
+struct EffecterPlan
+{
+    std::vector<CompositePlan> composites; //!< empty if there's no effecter
+};
+
+/** @brief Effecter plans indexed by effecter id */
+using EffecterPlans = std::vector<EffecterPlan>;
+
+/** @brief Compile the effecter plans for the state effecter PDRs in a PDR
+ *         snapshot
+ *
+ *  @param[in] snapshot - PDR snapshot
+ *
+ *  @return EffecterPlans - the effecter plans
+ */
+EffecterPlans compileEffecterPlans(const pdr::Snapshot& snapshot);
+
 class Handler : public CmdHandler
 {
   public:
-    Handler()
+    /** @brief Constructor
+     *
+     *  @param[in] dbusTimeout - timeout of each D-Bus property write made
+     *                           for SetStateEffecterStates
+     *  @param[in] eventBatchWindow - time over which received platform
+     *                                events are coalesced before they are
+     *                                published
+     */
+    explicit Handler(std::chrono::milliseconds dbusTimeout =
+                         std::chrono::milliseconds(DBUS_SET_TIMEOUT_MS),
+                     std::chrono::milliseconds eventBatchWindow =
+                         std::chrono::milliseconds(EVENT_BATCH_WINDOW_MS)) :
+        dbusTimeout(dbusTimeout),
+        eventBatchWindow(eventBatchWindow)
     {
         handlers.emplace(PLDM_GET_PDR,
                          [this](const pldm_msg* request, size_t payloadLength) {
@@ -34,6 +117,21 @@ class Handler : public CmdHandler
                              return this->setStateEffecterStates(request,
                                                                  payloadLength);
                          });
+        handlers.emplace(PLDM_PLATFORM_EVENT_MESSAGE,
+                         [this](const pldm_msg* request, size_t payloadLength) {
+                             return this->platformEventMessage(request,
+                                                               payloadLength);
+                         });
+        handlers.emplace(PLDM_GET_SENSOR_READING,
+                         [this](const pldm_msg* request, size_t payloadLength) {
+                             return this->getSensorReading(request,
+                                                           payloadLength);
+                         });
+        handlers.emplace(PLDM_GET_STATE_SENSOR_READINGS,
+                         [this](const pldm_msg* request, size_t payloadLength) {
+                             return this->getStateSensorReadings(request,
+                                                                 payloadLength);
+                         });
     }
 
     /** @brief Handler for GetPDR
@@ -53,6 +151,74 @@ class Handler : public CmdHandler
     Response setStateEffecterStates(const pldm_msg* request,
                                     size_t payloadLength);
 
+    /** @brief Handler for PlatformEventMessage. Sensor events are queued
+     *         and acknowledged right away, the queue is drained and the
+     *         events published on D-Bus once per batch window.
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request payload length
+     *  @return Response - PLDM Response message
+     */
+    Response platformEventMessage(const pldm_msg* request,
+                                  size_t payloadLength);
+
+    /** @brief Decode, coalesce and publish the queued platform events
+     */
+    void publishEvents();
+
+    /** @brief Get the queue of received platform events
+     *
+     *  @return const events::Queue& - the event queue
+     */
+    const events::Queue& getEventQueue() const
+    {
+        return eventQueue;
+    }
+
+    /** @brief Handler for GetSensorReading. The reading is answered from the
+     *         numeric sensor table, which follows the D-Bus sensor values.
+     *         PLDM_ERROR_NOT_READY is returned until watchSensors() builds
+     *         the table.
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request payload length
+     *  @return Response - PLDM Response message
+     */
+    Response getSensorReading(const pldm_msg* request, size_t payloadLength);
+
+    /** @brief Handler for GetStateSensorReadings. The readings are answered
+     *         from the state table, which follows the D-Bus properties the
+     *         sensors read. PLDM_ERROR_NOT_READY is returned until
+     *         watchSensors() builds the table.
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request payload length
+     *  @return Response - PLDM Response message
+     */
+    Response getStateSensorReadings(const pldm_msg* request,
+                                    size_t payloadLength);
+
+    /** @brief Build the sensor tables of the current PDR snapshot, subscribe
+     *         to the changes of the sensors' D-Bus objects and read them
+     *         all concurrently. Done again only when the local sensors
+     *         changed since the last time.
+     *
+     *  Called from the event loop at startup and whenever a PDR snapshot is
+     *  published, the sensor reading handlers only read the tables.
+     */
+    void watchSensors();
+
+    /** @brief Get the number of effecter state writes skipped because the
+     *         effecter was known to be in the requested state already. The
+     *         count is kept in memory only, it isn't published.
+     *
+     *  @return uint64_t - number of redundant writes
+     */
+    uint64_t getRedundantWrites() const
+    {
+        return redundantWrites;
+    }
+
     /** @brief Function to set the effecter requested by pldm requester
      *  @param[in] dBusIntf - The interface object
      *  @param[in] effecterId - Effecter ID sent by the requester to act on
@@ -60,218 +226,195 @@ class Handler : public CmdHandler
      * equal to composite effecter count in number
      *  @return - Success or failure in setting the states. Returns failure in
      * terms of PLDM completion codes if atleast one state fails to be set
+     *
+     *  All the state fields are validated before any is set, the D-Bus writes
+     *  for the composite effecters are then made concurrently. States the
+     *  effecter is known to be in already are not written again, if the
+     *  property written holds the state rather than requests a transition.
      */
     template <class DBusInterface>
     int setStateEffecterStatesHandler(
         const DBusInterface& dBusIntf, effecter::Id effecterId,
         const std::vector<set_effecter_state_field>& stateField)
     {
-        using namespace std::string_literals;
-        using DBusProperty = std::variant<std::string, bool>;
-        using StateSetId = uint16_t;
-        using StateSetNum = uint8_t;
-        using PropertyMap =
-            std::map<StateSetId, std::map<StateSetNum, DBusProperty>>;
-        static const PropertyMap stateNumToDbusProp = {
-            {PLDM_BOOT_PROGRESS_STATE,
-             {{PLDM_BOOT_NOT_ACTIVE,
-               "xyz.openbmc_project.State.OperatingSystem.Status.OSStatus."
-               "Standby"s},
-              {PLDM_BOOT_COMPLETED,
-               "xyz.openbmc_project.State.OperatingSystem.Status.OSStatus."
-               "BootComplete"s}}},
-            {PLDM_SYSTEM_POWER_STATE,
-             {{PLDM_OFF_SOFT_GRACEFUL,
-               "xyz.openbmc_project.State.Chassis.Transition.Off"s}}}};
-        using namespace pldm::responder::pdr;
-        using namespace pldm::responder::effecter::dbus_mapping;
-
-        state_effecter_possible_states* states = nullptr;
-        pldm_state_effecter_pdr* pdr = nullptr;
-        uint8_t compEffecterCnt = stateField.size();
-        uint32_t recordHndl{};
-        Repo& pdrRepo = get(PDR_JSONS_DIR);
-        pdr::Entry pdrEntry{};
-
-        while (!pdr)
+        auto plans = getEffecterPlans();
+        if (effecterId >= plans->size() ||
+            (*plans)[effecterId].composites.empty())
         {
-            pdrEntry = pdrRepo.at(recordHndl);
-            pldm_pdr_hdr* header =
-                reinterpret_cast<pldm_pdr_hdr*>(pdrEntry.data());
-            if (header->type != PLDM_STATE_EFFECTER_PDR)
-            {
-                recordHndl = pdrRepo.getNextRecordHandle(recordHndl);
-                if (recordHndl)
-                {
-                    continue;
-                }
-                return PLDM_PLATFORM_INVALID_EFFECTER_ID;
-            }
-            pdr = reinterpret_cast<pldm_state_effecter_pdr*>(pdrEntry.data());
-            recordHndl = pdr->hdr.record_handle;
-            if (pdr->effecter_id == effecterId)
-            {
-                states = reinterpret_cast<state_effecter_possible_states*>(
-                    pdr->possible_states);
-                if (compEffecterCnt > pdr->composite_effecter_count)
-                {
-                    std::cerr
-                        << "The requester sent wrong composite effecter"
-                        << " count for the effecter, EFFECTER_ID=" << effecterId
-                        << "COMP_EFF_CNT=" << compEffecterCnt << "\n";
-                    return PLDM_ERROR_INVALID_DATA;
-                }
-                break;
-            }
-            recordHndl = pdrRepo.getNextRecordHandle(recordHndl);
-            if (!recordHndl)
-            {
-                return PLDM_PLATFORM_INVALID_EFFECTER_ID;
-            }
-            pdr = nullptr;
+            return PLDM_PLATFORM_INVALID_EFFECTER_ID;
         }
+        const auto& plan = (*plans)[effecterId];
 
-        std::map<StateSetId, std::function<int(const std::string& objPath,
-                                               const uint8_t currState)>>
-            effecterToDbusEntries = {
-                {PLDM_BOOT_PROGRESS_STATE,
-                 [&](const std::string& objPath, const uint8_t currState) {
-                     auto stateSet =
-                         stateNumToDbusProp.find(PLDM_BOOT_PROGRESS_STATE);
-                     if (stateSet == stateNumToDbusProp.end())
-                     {
-                         std::cerr << "Couldn't find D-Bus mapping for "
-                                   << "PLDM_BOOT_PROGRESS_STATE, EFFECTER_ID="
-                                   << effecterId << "\n";
-                         return PLDM_ERROR;
-                     }
-                     auto iter = stateSet->second.find(
-                         stateField[currState].effecter_state);
-                     if (iter == stateSet->second.end())
-                     {
-                         std::cerr << "Invalid state field passed or field not "
-                                   << "found for PLDM_BOOT_PROGRESS_STATE, "
-                                      "EFFECTER_ID="
-                                   << effecterId << " FIELD="
-                                   << stateField[currState].effecter_state
-                                   << " OBJECT_PATH=" << objPath.c_str()
-                                   << "\n";
-                         return PLDM_ERROR_INVALID_DATA;
-                     }
-                     auto dbusProp = "OperatingSystemState";
-                     std::variant<std::string> value{
-                         std::get<std::string>(iter->second)};
-                     auto dbusInterface =
-                         "xyz.openbmc_project.State.OperatingSystem.Status";
-                     try
-                     {
-                         dBusIntf.setDbusProperty(objPath.c_str(), dbusProp,
-                                                  dbusInterface, value);
-                     }
-                     catch (const std::exception& e)
-                     {
-                         std::cerr
-                             << "Error setting property, ERROR=" << e.what()
-                             << " PROPERTY=" << dbusProp
-                             << " INTERFACE=" << dbusInterface
-                             << " PATH=" << objPath.c_str() << "\n";
-                         return PLDM_ERROR;
-                     }
-                     return PLDM_SUCCESS;
-                 }},
-                {PLDM_SYSTEM_POWER_STATE,
-                 [&](const std::string& objPath, const uint8_t currState) {
-                     auto stateSet =
-                         stateNumToDbusProp.find(PLDM_SYSTEM_POWER_STATE);
-                     if (stateSet == stateNumToDbusProp.end())
-                     {
-                         std::cerr << "Couldn't find D-Bus mapping for "
-                                   << "PLDM_SYSTEM_POWER_STATE, EFFECTER_ID="
-                                   << effecterId << "\n";
-                         return PLDM_ERROR;
-                     }
-                     auto iter = stateSet->second.find(
-                         stateField[currState].effecter_state);
-                     if (iter == stateSet->second.end())
-                     {
-                         std::cerr << "Invalid state field passed or field not "
-                                   << "found for PLDM_SYSTEM_POWER_STATE, "
-                                      "EFFECTER_ID="
-                                   << effecterId << " FIELD="
-                                   << stateField[currState].effecter_state
-                                   << " OBJECT_PATH=" << objPath.c_str()
-                                   << "\n";
-                         return PLDM_ERROR_INVALID_DATA;
-                     }
-                     auto dbusProp = "RequestedPowerTransition";
-                     std::variant<std::string> value{
-                         std::get<std::string>(iter->second)};
-                     auto dbusInterface = "xyz.openbmc_project.State.Chassis";
-                     try
-                     {
-                         dBusIntf.setDbusProperty(objPath.c_str(), dbusProp,
-                                                  dbusInterface, value);
-                     }
-                     catch (const std::exception& e)
-                     {
-                         std::cerr
-                             << "Error setting property, ERROR=" << e.what()
-                             << " PROPERTY=" << dbusProp
-                             << " INTERFACE=" << dbusInterface
-                             << " PATH=" << objPath.c_str() << "\n";
-                         return PLDM_ERROR;
-                     }
-                     return PLDM_SUCCESS;
-                 }}};
+        uint8_t compEffecterCnt = stateField.size();
+        if (compEffecterCnt > plan.composites.size())
+        {
+            std::cerr << "The requester sent wrong composite effecter"
+                      << " count for the effecter, EFFECTER_ID=" << effecterId
+                      << "COMP_EFF_CNT=" << compEffecterCnt << "\n";
+            return PLDM_ERROR_INVALID_DATA;
+        }
 
-        int rc = PLDM_SUCCESS;
-        auto paths = get(effecterId);
+        using Value = std::variant<std::string>;
+        std::vector<pldm::utils::PropertyWrite<std::string>> writes;
+        std::vector<uint8_t> written; // composite effecter of each write
+        writes.reserve(compEffecterCnt);
+        written.reserve(compEffecterCnt);
+        auto& states = effecterStates[effecterId];
         for (uint8_t currState = 0; currState < compEffecterCnt; ++currState)
         {
-            std::vector<StateSetNum> allowed{};
-            // computation is based on table 79 from DSP0248 v1.1.1
-            uint8_t bitfieldIndex = stateField[currState].effecter_state / 8;
-            uint8_t bit =
-                stateField[currState].effecter_state - (8 * bitfieldIndex);
-            if (states->possible_states_size < bitfieldIndex ||
-                !(states->states[bitfieldIndex].byte & (1 << bit)))
+            const auto& composite = plan.composites[currState];
+            auto state = stateField[currState].effecter_state;
+            if (!composite.possibleStates.test(state))
             {
                 std::cerr << "Invalid state set value, EFFECTER_ID="
                           << effecterId
-                          << " VALUE=" << stateField[currState].effecter_state
+                          << " VALUE=" << static_cast<unsigned>(state)
                           << " COMPOSITE_EFFECTER_ID=" << currState
-                          << " DBUS_PATH=" << paths[currState].c_str() << "\n";
-                rc = PLDM_PLATFORM_SET_EFFECTER_UNSUPPORTED_SENSORSTATE;
-                break;
+                          << " DBUS_PATH=" << composite.path << "\n";
+                return PLDM_PLATFORM_SET_EFFECTER_UNSUPPORTED_SENSORSTATE;
             }
-            auto iter = effecterToDbusEntries.find(states->state_set_id);
-            if (iter == effecterToDbusEntries.end())
+            const auto action = composite.action;
+            if (!action)
             {
-                uint16_t setId = states->state_set_id;
                 std::cerr << "Did not find the state set for the"
-                          << " state effecter pdr, STATE=" << setId
+                          << " state effecter pdr, STATE="
+                          << composite.stateSetId
                           << " EFFECTER_ID=" << effecterId << "\n";
-                rc = PLDM_PLATFORM_INVALID_STATE_VALUE;
-                break;
+                return PLDM_PLATFORM_INVALID_STATE_VALUE;
             }
-            if (stateField[currState].set_request == PLDM_REQUEST_SET)
+            if (stateField[currState].set_request != PLDM_REQUEST_SET)
             {
-                rc = iter->second(paths[currState], currState);
-                if (rc != PLDM_SUCCESS)
-                {
-                    break;
-                }
+                continue;
+            }
+
+            auto index = action->valueIndex[state];
+            if (!index)
+            {
+                std::cerr << "Invalid state field passed or field not "
+                          << "found for the state set, STATE="
+                          << composite.stateSetId
+                          << " EFFECTER_ID=" << effecterId
+                          << " FIELD=" << static_cast<unsigned>(state)
+                          << " OBJECT_PATH=" << composite.path << "\n";
+                return PLDM_ERROR_INVALID_DATA;
+            }
+            if (action->keepsState && states[currState] == state)
+            {
+                ++redundantWrites;
+                continue;
+            }
+            const Value* value = &action->values[index - 1];
+            writes.push_back({composite.path.c_str(), action->property,
+                              action->interface, value});
+            written.push_back(currState);
+        }
+
+        if (writes.empty())
+        {
+            return PLDM_SUCCESS;
+        }
+        auto results = dBusIntf.setDbusProperties(writes, dbusTimeout);
+        int rc = PLDM_SUCCESS;
+        for (size_t i = 0; i < writes.size(); ++i)
+        {
+            states[written[i]] = results[i]
+                                     ? stateField[written[i]].effecter_state
+                                     : unknownState;
+            if (!results[i])
+            {
+                std::cerr << "Error setting property, PROPERTY="
+                          << writes[i].dbusProp
+                          << " INTERFACE=" << writes[i].dbusInterface
+                          << " PATH=" << writes[i].objPath << "\n";
+                rc = PLDM_ERROR;
             }
-            uint8_t* nextState =
-                reinterpret_cast<uint8_t*>(states) +
-                sizeof(state_effecter_possible_states) -
-                sizeof(states->states) +
-                (states->possible_states_size * sizeof(states->states));
-            states =
-                reinterpret_cast<state_effecter_possible_states*>(nextState);
         }
         return rc;
     }
+
+  private:
+    /** @brief Get the effecter plans of the current PDR snapshot, compiling
+     *         them the first time a new snapshot is seen
+     *
+     *  @return std::shared_ptr<const EffecterPlans> - the effecter plans
+     */
+    std::shared_ptr<const EffecterPlans> getEffecterPlans();
+
+    /** @brief The snapshot the effecter plans were compiled from */
+    std::shared_ptr<const pdr::Snapshot> plannedSnapshot{};
+
+    /** @brief Effecter plans, compiled from plannedSnapshot */
+    std::shared_ptr<const EffecterPlans> effecterPlans{};
+
+    /** @brief Subscribe to PropertiesChanged on the D-Bus objects of the
+     *         effecters, so that the effecter state cache follows changes
+     *         made by others. Done again whenever the effecter plans change.
+     */
+    void watchEffecterStates();
+
+    /** @brief Update the effecter state cache from a PropertiesChanged
+     *         signal
+     *
+     *  @param[in] path - D-Bus object path the signal is from
+     *  @param[in] msg - the PropertiesChanged signal
+     */
+    void effecterPropertiesChanged(const std::string& path,
+                                   sdbusplus::message::message& msg);
+
+    /** @brief Update the sensor tables from a PropertiesChanged signal
+     *
+     *  @param[in] path - D-Bus object path the signal is from
+     *  @param[in] msg - the PropertiesChanged signal
+     */
+    void sensorPropertiesChanged(const std::string& path,
+                                 sdbusplus::message::message& msg);
+
+    /** @brief The snapshot the sensor tables were built from */
+    std::shared_ptr<const pdr::Snapshot> sensorSnapshot{};
+
+    /** @brief State of every composite state sensor */
+    std::unique_ptr<sensor::StateTable> stateSensors{};
+
+    /** @brief Reading of every numeric sensor */
+    std::unique_ptr<sensor::NumericTable> numericSensors{};
+
+    /** @brief PropertiesChanged subscriptions of the sensor objects */
+    std::vector<std::unique_ptr<sdbusplus::bus::match::match>>
+        sensorMatches{};
+
+    /** @brief Timeout of each D-Bus property write */
+    std::chrono::milliseconds dbusTimeout;
+
+    /** @brief Time over which received platform events are coalesced */
+    std::chrono::milliseconds eventBatchWindow;
+
+    /** @brief Received platform events waiting to be published */
+    events::Queue eventQueue;
+
+    /** @brief Publishes the queued events at the end of a batch window,
+     *         created when the first event is received
+     */
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        eventTimer{};
+
+    /** @brief State cache marker for a state that isn't known */
+    static constexpr int16_t unknownState = -1;
+
+    /** @brief Last state applied to each composite effecter, indexed by
+     *         effecter id and composite effecter index
+     */
+    std::vector<std::vector<int16_t>> effecterStates{};
+
+    /** @brief The snapshot whose effecter D-Bus objects are watched */
+    std::shared_ptr<const pdr::Snapshot> watchedSnapshot{};
+
+    /** @brief PropertiesChanged subscriptions of the effecter objects */
+    std::vector<std::unique_ptr<sdbusplus::bus::match::match>>
+        effecterMatches{};
+
+    /** @brief Number of effecter state writes skipped */
+    uint64_t redundantWrites = 0;
 };
 
 } // namespace platform
@@ -0,0 +1,463 @@
+#include "sensor_readings.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace sensor
+{
+
+namespace
+{
+
+/** @brief State reported before a sensor has been read, and when its D-Bus
+ *         value has no state
+ */
+constexpr uint8_t unknownState = 0;
+
+/** @brief Call a function with each local PDR of a type in a snapshot
+ *
+ *  @tparam PDR - the PDR structure of the type
+ *  @param[in] snapshot - PDR snapshot
+ *  @param[in] pdrType - PDR type
+ *  @param[in] func - function called with each PDR
+ */
+template <typename PDR, typename Func>
+void forEachPdr(const pdr::Snapshot& snapshot, pdr::Type pdrType, Func func)
+{
+    const auto& repo = *snapshot.repo;
+    if (repo.empty())
+    {
+        return;
+    }
+
+    pdr::RecordHandle recordHndl = 0;
+    do
+    {
+        auto pdrEntry = repo.at(recordHndl);
+        auto header = reinterpret_cast<const pldm_pdr_hdr*>(pdrEntry.data());
+        recordHndl = header->record_handle;
+        if (header->type == pdrType && !snapshot.isRemote(recordHndl))
+        {
+            func(*reinterpret_cast<const PDR*>(pdrEntry.data()));
+        }
+    } while ((recordHndl = repo.getNextRecordHandle(recordHndl)));
+}
+
+/** @brief Range of the readings of a sensor data size
+ *
+ *  @param[in] dataSize - sensor data size
+ *
+ *  @return std::pair<int64_t, int64_t> - the lowest and highest reading
+ */
+std::pair<int64_t, int64_t> readingRange(uint8_t dataSize)
+{
+    switch (dataSize)
+    {
+        case PLDM_SENSOR_DATA_SIZE_UINT8:
+            return {0, UINT8_MAX};
+        case PLDM_SENSOR_DATA_SIZE_SINT8:
+            return {INT8_MIN, INT8_MAX};
+        case PLDM_SENSOR_DATA_SIZE_UINT16:
+            return {0, UINT16_MAX};
+        case PLDM_SENSOR_DATA_SIZE_SINT16:
+            return {INT16_MIN, INT16_MAX};
+        case PLDM_SENSOR_DATA_SIZE_UINT32:
+            return {0, UINT32_MAX};
+        default:
+            return {INT32_MIN, INT32_MAX};
+    }
+}
+
+/** @brief Width in bytes of a numeric sensor PDR field
+ *
+ *  @param[in] format - the field format, a pldm_range_field_format. The
+ *                      sensor data sizes share the integer formats.
+ *
+ *  @return size_t - width of the field
+ */
+size_t numericWidth(uint8_t format)
+{
+    switch (format)
+    {
+        case PLDM_RANGE_FIELD_FORMAT_UINT8:
+        case PLDM_RANGE_FIELD_FORMAT_SINT8:
+            return sizeof(uint8_t);
+        case PLDM_RANGE_FIELD_FORMAT_UINT16:
+        case PLDM_RANGE_FIELD_FORMAT_SINT16:
+            return sizeof(uint16_t);
+        default:
+            return sizeof(uint32_t);
+    }
+}
+
+/** @brief Read a numeric sensor PDR field and advance past it
+ *
+ *  @param[in] format - the field format
+ *  @param[in,out] pos - where the field is read from
+ *
+ *  @return double - the field value
+ */
+double readNumeric(uint8_t format, const uint8_t*& pos)
+{
+    auto read = [&pos](auto value) {
+        std::memcpy(&value, pos, sizeof(value));
+        pos += sizeof(value);
+        return static_cast<double>(value);
+    };
+    switch (format)
+    {
+        case PLDM_RANGE_FIELD_FORMAT_UINT8:
+            return read(uint8_t{});
+        case PLDM_RANGE_FIELD_FORMAT_SINT8:
+            return read(int8_t{});
+        case PLDM_RANGE_FIELD_FORMAT_UINT16:
+            return read(uint16_t{});
+        case PLDM_RANGE_FIELD_FORMAT_SINT16:
+            return read(int16_t{});
+        case PLDM_RANGE_FIELD_FORMAT_UINT32:
+            return read(uint32_t{});
+        case PLDM_RANGE_FIELD_FORMAT_SINT32:
+            return read(int32_t{});
+        default:
+            return read(float{});
+    }
+}
+
+/** @struct ThresholdCheck
+ *
+ *  @brief A threshold of a numeric sensor, as its index among the thresholds
+ *         kept, its bit in the supported thresholds bitfield, and the state
+ *         of a reading at or beyond it
+ */
+struct ThresholdCheck
+{
+    size_t index;
+    uint8_t bit;
+    bool upper;
+    uint8_t state;
+};
+
+/** @brief The thresholds, from the worst state to the mildest */
+constexpr ThresholdCheck thresholdChecks[] = {
+    {4, 1 << 2, true, PLDM_SENSOR_UPPERFATAL},
+    {5, 1 << 5, false, PLDM_SENSOR_LOWERFATAL},
+    {2, 1 << 1, true, PLDM_SENSOR_UPPERCRITICAL},
+    {3, 1 << 4, false, PLDM_SENSOR_LOWERCRITICAL},
+    {0, 1 << 0, true, PLDM_SENSOR_UPPERWARNING},
+    {1, 1 << 3, false, PLDM_SENSOR_LOWERWARNING}};
+
+} // namespace
+
+StateTable::StateTable(const pdr::Snapshot& snapshot) :
+    mappings(snapshot.sensorMappings)
+{
+    forEachPdr<pldm_state_sensor_pdr>(
+        snapshot, PLDM_STATE_SENSOR_PDR,
+        [this](const pldm_state_sensor_pdr& pdr) {
+            if (pdr.sensor_id >= sensors.size())
+            {
+                sensors.resize(pdr.sensor_id + 1);
+            }
+            sensors[pdr.sensor_id] = {fields.size(),
+                                      pdr.composite_sensor_count};
+
+            auto found = mappings->find(pdr.sensor_id);
+            for (size_t i = 0; i < pdr.composite_sensor_count; ++i)
+            {
+                const dbus_mapping::Mapping* mapping = nullptr;
+                if (found != mappings->end() && i < found->second.size() &&
+                    !found->second[i].objectPath.empty())
+                {
+                    mapping = &found->second[i];
+                    watchers[{mapping->objectPath, mapping->interface}]
+                        .push_back(fields.size());
+                }
+                fields.push_back({PLDM_SENSOR_UNAVAILABLE, unknownState,
+                                  unknownState, unknownState});
+                sources.push_back(mapping);
+            }
+        });
+}
+
+void StateTable::setState(size_t index, const pldm::utils::PropertyValue& value)
+{
+    auto& field = fields[index];
+    const auto& states = sources[index]->states;
+    auto state = states.find(value);
+    if (state == states.end())
+    {
+        field.sensor_op_state = PLDM_SENSOR_UNAVAILABLE;
+        return;
+    }
+
+    field.sensor_op_state = PLDM_SENSOR_ENABLED;
+    if (field.present_state != state->second)
+    {
+        field.previous_state = field.present_state;
+        field.present_state = state->second;
+    }
+    field.event_state = field.present_state;
+}
+
+void StateTable::update(const std::string& path, const std::string& interface,
+                        const pldm::utils::PropertyMap& properties)
+{
+    auto watcher = watchers.find({path, interface});
+    if (watcher == watchers.end())
+    {
+        return;
+    }
+    for (auto index : watcher->second)
+    {
+        auto property = properties.find(sources[index]->propertyName);
+        if (property != properties.end())
+        {
+            setState(index, property->second);
+        }
+    }
+}
+
+void StateTable::invalidate(const std::string& path)
+{
+    for (auto& [object, indices] : watchers)
+    {
+        if (object.first != path)
+        {
+            continue;
+        }
+        for (auto index : indices)
+        {
+            fields[index].sensor_op_state = PLDM_SENSOR_UNAVAILABLE;
+        }
+    }
+}
+
+int StateTable::getReadings(Id id,
+                            std::vector<get_sensor_state_field>& fields) const
+{
+    if (id >= sensors.size() || !sensors[id].second)
+    {
+        return PLDM_PLATFORM_INVALID_SENSOR_ID;
+    }
+    auto [offset, count] = sensors[id];
+    fields.assign(this->fields.begin() + offset,
+                  this->fields.begin() + offset + count);
+    return PLDM_SUCCESS;
+}
+
+std::vector<Object> StateTable::objects() const
+{
+    std::vector<Object> objects;
+    objects.reserve(watchers.size());
+    for (const auto& watcher : watchers)
+    {
+        objects.push_back(watcher.first);
+    }
+    return objects;
+}
+
+NumericTable::NumericTable(const pdr::Snapshot& snapshot) :
+    mappings(snapshot.sensorMappings)
+{
+    forEachPdr<pldm_numeric_sensor_pdr>(
+        snapshot, PLDM_NUMERIC_SENSOR_PDR,
+        [this](const pldm_numeric_sensor_pdr& pdr) {
+            if (pdr.sensor_id >= index.size())
+            {
+                index.resize(pdr.sensor_id + 1, noSlot);
+            }
+            index[pdr.sensor_id] = conversions.size();
+
+            // The resolution and offset lead the variable length fields
+            float resolution{};
+            float offset{};
+            std::memcpy(&resolution, pdr.variable_fields, sizeof(resolution));
+            std::memcpy(&offset, pdr.variable_fields + sizeof(resolution),
+                        sizeof(offset));
+
+            // Past the accuracy, tolerances and hysteresis come the
+            // supported thresholds, and past the intervals and readable
+            // limits the range fields, the thresholds from the fourth on
+            auto dataWidth = numericWidth(pdr.sensor_data_size);
+            const uint8_t* pos = pdr.variable_fields + sizeof(float) * 2 +
+                                 sizeof(uint16_t) + 2 + dataWidth;
+            uint8_t supportedThresholds = *pos;
+            pos += 2 + sizeof(float) * 2 + dataWidth * 2;
+            auto rangeFormat = *pos;
+            pos += 2 + numericWidth(rangeFormat) * 3;
+            std::array<double, 6> thresholds{};
+            for (auto& threshold : thresholds)
+            {
+                threshold = readNumeric(rangeFormat, pos);
+            }
+
+            const dbus_mapping::Mapping* mapping = nullptr;
+            auto found = mappings->find(pdr.sensor_id);
+            if (found != mappings->end() && !found->second.empty() &&
+                !found->second[0].objectPath.empty())
+            {
+                mapping = &found->second[0];
+                watchers[{mapping->objectPath, mapping->interface}].push_back(
+                    conversions.size());
+            }
+            conversions.push_back({pdr.sensor_data_size, pdr.unit_modifier,
+                                   resolution ? resolution : 1.0, offset,
+                                   mapping, supportedThresholds,
+                                   thresholds});
+        });
+    slots = std::make_unique<Slot[]>(conversions.size());
+}
+
+uint8_t NumericTable::thresholdState(const Conversion& conversion,
+                                     int64_t raw)
+{
+    auto reading = static_cast<double>(raw);
+    for (const auto& check : thresholdChecks)
+    {
+        if (!(conversion.supportedThresholds & check.bit))
+        {
+            continue;
+        }
+        auto threshold = conversion.thresholds[check.index];
+        if (check.upper ? reading >= threshold : reading <= threshold)
+        {
+            return check.state;
+        }
+    }
+    return PLDM_SENSOR_NORMAL;
+}
+
+void NumericTable::store(Slot& slot, uint8_t opState, uint8_t presentState,
+                         int64_t raw)
+{
+    auto sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto previousState = slot.presentState.load(std::memory_order_relaxed);
+    if (previousState != presentState)
+    {
+        slot.previousState.store(previousState, std::memory_order_relaxed);
+        slot.presentState.store(presentState, std::memory_order_relaxed);
+    }
+    slot.opState.store(opState, std::memory_order_relaxed);
+    if (opState == PLDM_SENSOR_ENABLED)
+    {
+        slot.raw.store(raw, std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void NumericTable::update(const std::string& path,
+                          const std::string& interface,
+                          const pldm::utils::PropertyMap& properties)
+{
+    auto watcher = watchers.find({path, interface});
+    if (watcher == watchers.end())
+    {
+        return;
+    }
+    for (auto slot : watcher->second)
+    {
+        const auto& conversion = conversions[slot];
+        auto property = properties.find(conversion.source->propertyName);
+        if (property == properties.end())
+        {
+            continue;
+        }
+
+        auto value = std::visit(
+            [](const auto& v) {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_arithmetic_v<T>)
+                {
+                    return static_cast<double>(v);
+                }
+                return std::numeric_limits<double>::quiet_NaN();
+            },
+            property->second);
+        // reading = (resolution * raw + offset) * 10^unitModifier
+        auto raw = std::round((value / std::pow(10, conversion.unitModifier) -
+                               conversion.offset) /
+                              conversion.resolution);
+        if (!std::isfinite(raw))
+        {
+            store(slots[slot], PLDM_SENSOR_UNAVAILABLE, PLDM_SENSOR_UNKNOWN,
+                  0);
+            continue;
+        }
+        auto [low, high] = readingRange(conversion.dataSize);
+        auto reading = static_cast<int64_t>(std::clamp<double>(
+            raw, static_cast<double>(low), static_cast<double>(high)));
+        store(slots[slot], PLDM_SENSOR_ENABLED,
+              thresholdState(conversion, reading), reading);
+    }
+}
+
+void NumericTable::invalidate(const std::string& path)
+{
+    for (auto& [object, indices] : watchers)
+    {
+        if (object.first != path)
+        {
+            continue;
+        }
+        for (auto slot : indices)
+        {
+            store(slots[slot], PLDM_SENSOR_UNAVAILABLE, PLDM_SENSOR_UNKNOWN,
+                  0);
+        }
+    }
+}
+
+int NumericTable::getReading(Id id, NumericReading& reading) const
+{
+    if (id >= index.size() || index[id] == noSlot)
+    {
+        return PLDM_PLATFORM_INVALID_SENSOR_ID;
+    }
+
+    const auto& slot = slots[index[id]];
+    reading.dataSize = conversions[index[id]].dataSize;
+    uint32_t before = 0;
+    uint32_t after = 0;
+    do
+    {
+        before = slot.sequence.load(std::memory_order_acquire);
+        reading.opState = slot.opState.load(std::memory_order_relaxed);
+        reading.presentState =
+            slot.presentState.load(std::memory_order_relaxed);
+        reading.previousState =
+            slot.previousState.load(std::memory_order_relaxed);
+        reading.raw = slot.raw.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = slot.sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    return PLDM_SUCCESS;
+}
+
+std::vector<Object> NumericTable::objects() const
+{
+    std::vector<Object> objects;
+    objects.reserve(watchers.size());
+    for (const auto& watcher : watchers)
+    {
+        objects.push_back(watcher.first);
+    }
+    return objects;
+}
+
+} // namespace sensor
+} // namespace responder
+} // namespace pldm
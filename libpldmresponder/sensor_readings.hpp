@@ -0,0 +1,259 @@
+#pragma once
+
+#include "pdr.hpp"
+#include "sensors.hpp"
+#include "utils.hpp"
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "libpldm/platform.h"
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace sensor
+{
+
+/** @brief A D-Bus object path and interface */
+using Object = std::pair<std::string, std::string>;
+
+/** @class StateTable
+ *
+ *  @brief Current state of every composite state sensor, kept up to date
+ *         from the D-Bus properties the sensors read so that
+ *         GetStateSensorReadings is answered from memory.
+ *
+ *  The state fields of all the sensors are stored back to back, a sensor's
+ *  composite sensors are found by their offset into that storage.
+ */
+class StateTable
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] snapshot - the PDR snapshot with the state sensor PDRs and
+     *                        their D-Bus mappings
+     */
+    explicit StateTable(const pdr::Snapshot& snapshot);
+
+    /** @brief Update the composite sensors that read an interface of a
+     *         D-Bus object
+     *
+     *  @param[in] path - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     *  @param[in] properties - the properties that changed
+     */
+    void update(const std::string& path, const std::string& interface,
+                const pldm::utils::PropertyMap& properties);
+
+    /** @brief Mark the composite sensors that read a D-Bus object as
+     *         unavailable, used when the object can't be read
+     *
+     *  @param[in] path - D-Bus object path
+     */
+    void invalidate(const std::string& path);
+
+    /** @brief Get the readings of a state sensor
+     *
+     *  @param[in] id - sensor id
+     *  @param[out] fields - state field of each composite sensor
+     *
+     *  @return PLDM_SUCCESS, or PLDM_PLATFORM_INVALID_SENSOR_ID if there's no
+     *          state sensor with the id
+     */
+    int getReadings(Id id, std::vector<get_sensor_state_field>& fields) const;
+
+    /** @brief Get the D-Bus objects the sensors read
+     *
+     *  @return std::vector<Object> - the D-Bus objects and interfaces
+     */
+    std::vector<Object> objects() const;
+
+  private:
+    /** @brief Set the state of a composite sensor from a D-Bus value
+     *
+     *  @param[in] index - index of the composite sensor's state field
+     *  @param[in] value - the D-Bus property value
+     */
+    void setState(size_t index, const pldm::utils::PropertyValue& value);
+
+    /** @brief The sensor D-Bus mappings the table was built from */
+    std::shared_ptr<const dbus_mapping::Map> mappings;
+
+    /** @brief State field of every composite sensor */
+    std::vector<get_sensor_state_field> fields;
+
+    /** @brief D-Bus mapping of every composite sensor, nullptr for the
+     *         composite sensors that have none
+     */
+    std::vector<const dbus_mapping::Mapping*> sources;
+
+    /** @brief Offset into fields and number of composite sensors, indexed
+     *         by sensor id. Sensors without an entry have no composites.
+     */
+    std::vector<std::pair<uint32_t, uint8_t>> sensors;
+
+    /** @brief Composite sensors reading each D-Bus object */
+    std::map<Object, std::vector<size_t>> watchers;
+};
+
+/** @struct NumericReading
+ *
+ *  @brief A consistent copy of the reading of a numeric sensor
+ */
+struct NumericReading
+{
+    uint8_t dataSize;      //!< sensor data size from the PDR
+    uint8_t opState;       //!< sensor operational state
+    uint8_t presentState;  //!< present state of the sensor
+    uint8_t previousState; //!< state the present state changed from
+    int64_t raw;           //!< present reading, in PDR units
+};
+
+/** @class NumericTable
+ *
+ *  @brief Current reading of every numeric sensor, kept up to date from the
+ *         D-Bus sensor values so that GetSensorReading is answered from
+ *         memory.
+ *
+ *  Readings are converted to the units of the sensor PDR when the D-Bus
+ *  value changes, and the present state is the worst of the thresholds the
+ *  PDR advertises that the reading is at or beyond. Hysteresis isn't
+ *  applied, a reading back within a threshold is reported as such at once.
+ *
+ *  Each reading lives in its own cache line and is guarded by a sequence
+ *  counter, so any number of threads can take readings while a single
+ *  thread, the one dispatching D-Bus signals, updates them. A reader
+ *  retries when it raced with an update instead of blocking it.
+ */
+class NumericTable
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] snapshot - the PDR snapshot with the numeric sensor PDRs
+     *                        and their D-Bus mappings
+     */
+    explicit NumericTable(const pdr::Snapshot& snapshot);
+
+    /** @brief Update the sensors that read an interface of a D-Bus object
+     *
+     *  @param[in] path - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     *  @param[in] properties - the properties that changed
+     */
+    void update(const std::string& path, const std::string& interface,
+                const pldm::utils::PropertyMap& properties);
+
+    /** @brief Mark the sensors that read a D-Bus object as unavailable
+     *
+     *  @param[in] path - D-Bus object path
+     */
+    void invalidate(const std::string& path);
+
+    /** @brief Take the reading of a numeric sensor
+     *
+     *  @param[in] id - sensor id
+     *  @param[out] reading - the reading
+     *
+     *  @return PLDM_SUCCESS, or PLDM_PLATFORM_INVALID_SENSOR_ID if there's no
+     *          numeric sensor with the id
+     */
+    int getReading(Id id, NumericReading& reading) const;
+
+    /** @brief Get the D-Bus objects the sensors read
+     *
+     *  @return std::vector<Object> - the D-Bus objects and interfaces
+     */
+    std::vector<Object> objects() const;
+
+  private:
+    /** @struct Conversion
+     *
+     *  @brief How a D-Bus value converts to a reading, from the PDR
+     */
+    struct Conversion
+    {
+        uint8_t dataSize;
+        int8_t unitModifier;
+        double resolution;
+        double offset;
+        const dbus_mapping::Mapping* source;
+
+        /** @brief Supported thresholds bitfield of the PDR */
+        uint8_t supportedThresholds;
+
+        /** @brief Warning, critical and fatal high and low thresholds, in
+         *         the order of the range fields of the PDR
+         */
+        std::array<double, 6> thresholds;
+    };
+
+    /** @brief Get the present state of a numeric sensor from its reading
+     *
+     *  @param[in] conversion - the sensor's conversion and thresholds
+     *  @param[in] raw - the reading, in PDR units
+     *
+     *  @return uint8_t - the state, PLDM_SENSOR_NORMAL unless the reading is
+     *          at or beyond a supported threshold
+     */
+    static uint8_t thresholdState(const Conversion& conversion, int64_t raw);
+
+    /** @struct Slot
+     *
+     *  @brief The reading of a sensor, with its sequence counter. The
+     *         counter is odd while the reading is being written.
+     */
+    struct alignas(64) Slot
+    {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<uint8_t> opState{PLDM_SENSOR_UNAVAILABLE};
+        std::atomic<uint8_t> presentState{PLDM_SENSOR_UNKNOWN};
+        std::atomic<uint8_t> previousState{PLDM_SENSOR_UNKNOWN};
+        std::atomic<int64_t> raw{0};
+    };
+
+    /** @brief Write a sensor's reading
+     *
+     *  @param[in] slot - the sensor's slot
+     *  @param[in] opState - sensor operational state
+     *  @param[in] presentState - present state of the sensor
+     *  @param[in] raw - present reading, ignored unless the sensor is
+     *                   enabled
+     */
+    void store(Slot& slot, uint8_t opState, uint8_t presentState,
+               int64_t raw);
+
+    /** @brief Marker for sensor ids without a slot */
+    static constexpr uint32_t noSlot = UINT32_MAX;
+
+    /** @brief The sensor D-Bus mappings the table was built from */
+    std::shared_ptr<const dbus_mapping::Map> mappings;
+
+    /** @brief Slot of each sensor, indexed by sensor id */
+    std::vector<uint32_t> index;
+
+    /** @brief Conversion of each slot */
+    std::vector<Conversion> conversions;
+
+    /** @brief The readings, one cache line each */
+    std::unique_ptr<Slot[]> slots;
+
+    /** @brief Slots reading each D-Bus object */
+    std::map<Object, std::vector<uint32_t>> watchers;
+};
+
+} // namespace sensor
+} // namespace responder
+} // namespace pldm
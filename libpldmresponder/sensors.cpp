@@ -0,0 +1,60 @@
+#include "sensors.hpp"
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace sensor
+{
+
+namespace internal
+{
+
+Id id = 0;
+
+} // namespace internal
+
+Id nextId()
+{
+    return ++internal::id;
+}
+
+void resetId()
+{
+    internal::id = 0;
+}
+
+namespace dbus_mapping
+{
+
+namespace internal
+{
+
+Map staged{};
+
+} // namespace internal
+
+void add(Id id, Mappings&& mappings)
+{
+    internal::staged.emplace(id, std::move(mappings));
+}
+
+std::shared_ptr<const Map> publish()
+{
+    auto published = std::make_shared<const Map>(std::move(internal::staged));
+    internal::staged.clear();
+    return published;
+}
+
+void discard()
+{
+    internal::staged.clear();
+}
+
+} // namespace dbus_mapping
+
+} // namespace sensor
+} // namespace responder
+} // namespace pldm
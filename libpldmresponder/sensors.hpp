@@ -0,0 +1,74 @@
+#pragma once
+
+#include "utils.hpp"
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace sensor
+{
+
+using Id = uint16_t;
+
+/** @brief Get next available id to assign to a sensor
+ *
+ *  @return  uint16_t - sensor id
+ */
+Id nextId();
+
+/** @brief Restart sensor id assignment, used when the PDR is regenerated
+ */
+void resetId();
+
+namespace dbus_mapping
+{
+
+/** @struct Mapping
+ *
+ *  @brief The D-Bus property a sensor reads, one per composite sensor
+ */
+struct Mapping
+{
+    std::string objectPath;
+    std::string interface;
+    std::string propertyName;
+    /** @brief State of each D-Bus property value, for state sensors */
+    std::map<pldm::utils::PropertyValue, uint8_t> states;
+};
+
+using Mappings = std::vector<Mapping>;
+using Map = std::map<Id, Mappings>;
+
+/** @brief Add a sensor id -> D-Bus properties mapping. The mapping is staged
+ *         until the next call to publish().
+ *
+ *  @param[in] id - sensor id
+ *  @param[in] mappings - D-Bus property of each composite sensor
+ */
+void add(Id id, Mappings&& mappings);
+
+/** @brief Replace the current mappings with the ones staged by add()
+ *
+ *  @return std::shared_ptr<const Map> - the published mappings
+ */
+std::shared_ptr<const Map> publish();
+
+/** @brief Drop the mappings staged by add() without publishing them
+ */
+void discard();
+
+} // namespace dbus_mapping
+
+} // namespace sensor
+} // namespace responder
+} // namespace pldm
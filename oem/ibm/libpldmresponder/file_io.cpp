@@ -361,23 +361,33 @@ Response Handler::getFileTable(const pldm_msg* request, size_t payloadLength)
         return response;
     }
 
-    using namespace pldm::filetable;
-    auto table = buildFileTable(FILE_TABLE_JSON);
-    auto attrTable = table();
-    response.resize(response.size() + attrTable.size());
-    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-
-    if (attrTable.empty())
+    transfer::Part part;
+    rc = getTablePart(request, tableType, transferHandle, transferFlag,
+                      [](std::shared_ptr<const transfer::Table>& table) {
+                          using namespace pldm::filetable;
+                          auto attrTable = std::make_shared<transfer::Table>(
+                              buildFileTable(FILE_TABLE_JSON)());
+                          if (attrTable->empty())
+                          {
+                              return static_cast<uint8_t>(
+                                  PLDM_FILE_TABLE_UNAVAILABLE);
+                          }
+                          table = std::move(attrTable);
+                          return static_cast<uint8_t>(PLDM_SUCCESS);
+                      },
+                      part);
+    if (rc != PLDM_SUCCESS)
     {
-        encode_get_file_table_resp(request->hdr.instance_id,
-                                   PLDM_FILE_TABLE_UNAVAILABLE, 0, 0, nullptr,
+        encode_get_file_table_resp(request->hdr.instance_id, rc, 0, 0, nullptr,
                                    0, responsePtr);
         return response;
     }
 
-    encode_get_file_table_resp(request->hdr.instance_id, PLDM_SUCCESS, 0,
-                               PLDM_START_AND_END, attrTable.data(),
-                               attrTable.size(), responsePtr);
+    response.resize(response.size() + part.length);
+    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    encode_get_file_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
+                               part.nextTransferHandle, part.transferFlag,
+                               part.data, part.length, responsePtr);
     return response;
 }
 
@@ -494,7 +494,7 @@ TEST_F(TestFileTable, GetFileTableCommand)
     auto& table = buildFileTable(fileTableConfig.c_str());
 
     uint32_t transferHandle = 0;
-    uint8_t opFlag = 0;
+    uint8_t opFlag = PLDM_GET_FIRSTPART;
     uint8_t type = PLDM_FILE_ATTRIBUTE_TABLE;
     uint32_t nextTransferHandle = 0;
     uint8_t transferFlag = PLDM_START_AND_END;
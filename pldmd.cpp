@@ -3,28 +3,42 @@
 #include "libpldmresponder/base.hpp"
 #include "libpldmresponder/bios.hpp"
 #include "libpldmresponder/fru.hpp"
+#include "libpldmresponder/pdr.hpp"
 #include "libpldmresponder/platform.hpp"
+#include "requester/handler.hpp"
+#include "requester/pdr_aggregator.hpp"
+#include "requester/sensor_poller.hpp"
+#include "requester/terminus.hpp"
 #include "utils.hpp"
 
 #include <err.h>
 #include <getopt.h>
 #include <poll.h>
 #include <stdlib.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/un.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sdbusplus/bus/match.hpp>
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/io.hpp>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <variant>
 #include <vector>
 
 #include "libpldm/base.h"
@@ -37,13 +51,20 @@
 
 constexpr uint8_t MCTP_MSG_TYPE_PLDM = 1;
 
+constexpr auto mctpPath = "/xyz/openbmc_project/mctp";
+constexpr auto mctpEndpointIntf = "xyz.openbmc_project.MCTP.Endpoint";
+
 using namespace pldm::responder;
 using namespace pldm;
 using namespace sdeventplus;
 using namespace sdeventplus::source;
 
+using RequestHandler = requester::Handler<dbus_api::Requester>;
+using EndpointProperties = std::map<
+    std::string, std::variant<size_t, std::vector<uint8_t>, std::string>>;
+
 static Response processRxMsg(const std::vector<uint8_t>& requestMsg,
-                             Invoker& invoker, dbus_api::Requester& requester)
+                             Invoker& invoker, RequestHandler& reqHandler)
 {
 
     Response response;
@@ -63,8 +84,8 @@ static Response processRxMsg(const std::vector<uint8_t>& requestMsg,
                             sizeof(eid) - sizeof(type);
         try
         {
-            response = invoker.handle(hdrFields.pldm_type, hdrFields.command,
-                                      request, requestLen);
+            response = invoker.handle(eid, hdrFields.pldm_type,
+                                      hdrFields.command, request, requestLen);
         }
         catch (const std::out_of_range& e)
         {
@@ -86,11 +107,85 @@ static Response processRxMsg(const std::vector<uint8_t>& requestMsg,
     }
     else
     {
-        requester.markFree(eid, hdr->instance_id);
+        auto responseMsg = reinterpret_cast<const pldm_msg*>(hdr);
+        size_t responseLen = requestMsg.size() - sizeof(struct pldm_msg_hdr) -
+                             sizeof(eid) - sizeof(type);
+        reqHandler.handleResponse(eid, responseMsg, responseLen);
     }
     return response;
 }
 
+/** @brief Get the EID of an MCTP endpoint if it carries PLDM
+ *
+ *  @param[in] properties - properties of the endpoint's D-Bus object
+ *
+ *  @return std::optional<uint8_t> - the EID, nothing if the endpoint doesn't
+ *          carry PLDM
+ */
+static std::optional<uint8_t> pldmEid(const EndpointProperties& properties)
+{
+    auto eid = properties.find("EID");
+    auto types = properties.find("SupportedMessageTypes");
+    if (eid == properties.end() || types == properties.end())
+    {
+        return std::nullopt;
+    }
+    auto eidValue = std::get_if<size_t>(&eid->second);
+    auto typesValue = std::get_if<std::vector<uint8_t>>(&types->second);
+    if (!eidValue || !typesValue ||
+        std::find(typesValue->begin(), typesValue->end(),
+                  MCTP_MSG_TYPE_PLDM) == typesValue->end())
+    {
+        return std::nullopt;
+    }
+    return static_cast<uint8_t>(*eidValue);
+}
+
+/** @brief Get the MCTP endpoints on D-Bus
+ *
+ *  @param[in] bus - the bus
+ *
+ *  @return std::map<std::string, EndpointProperties> - properties of each
+ *          endpoint, by object path
+ */
+static std::map<std::string, EndpointProperties>
+    getEndpoints(sdbusplus::bus::bus& bus)
+{
+    std::map<std::string, EndpointProperties> endpoints;
+    try
+    {
+        std::map<std::string, std::map<std::string, std::vector<std::string>>>
+            subtree;
+        auto mapper = bus.new_method_call(
+            "xyz.openbmc_project.ObjectMapper",
+            "/xyz/openbmc_project/object_mapper",
+            "xyz.openbmc_project.ObjectMapper", "GetSubTree");
+        mapper.append(mctpPath, 0, std::vector<std::string>{mctpEndpointIntf});
+        auto reply = bus.call(mapper);
+        reply.read(subtree);
+
+        for (const auto& [path, services] : subtree)
+        {
+            for (const auto& service : services)
+            {
+                auto method = bus.new_method_call(service.first.c_str(),
+                                                  path.c_str(),
+                                                  pldm::utils::dbusProperties,
+                                                  "GetAll");
+                method.append(mctpEndpointIntf);
+                auto properties = bus.call(method);
+                properties.read(endpoints[path]);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to get the MCTP endpoints, ERROR=" << e.what()
+                  << "\n";
+    }
+    return endpoints;
+}
+
 void printBuffer(const std::vector<uint8_t>& buffer)
 {
     std::ostringstream tempStream;
@@ -147,8 +242,9 @@ int main(int argc, char** argv)
     Invoker invoker{};
     invoker.registerHandler(PLDM_BASE, std::make_unique<base::Handler>());
     invoker.registerHandler(PLDM_BIOS, std::make_unique<bios::Handler>());
-    invoker.registerHandler(PLDM_PLATFORM,
-                            std::make_unique<platform::Handler>());
+    auto platformHandler = std::make_unique<platform::Handler>();
+    auto& platformResponder = *platformHandler;
+    invoker.registerHandler(PLDM_PLATFORM, std::move(platformHandler));
     invoker.registerHandler(PLDM_FRU,
                             std::make_unique<fru::Handler>(FRU_JSONS_DIR));
 
@@ -194,9 +290,148 @@ int main(int argc, char** argv)
     }
 
     auto& bus = pldm::utils::DBusHandler::getBus();
+    auto event = Event::get_default();
     dbus_api::Requester dbusImplReq(bus, "/xyz/openbmc_project/pldm");
-    auto callback = [verbose, &invoker, &dbusImplReq](IO& /*io*/, int fd,
-                                                      uint32_t revents) {
+    RequestHandler reqHandler(
+        event, dbusImplReq,
+        [&socketFd](uint8_t eid, const std::vector<uint8_t>& requestMsg) {
+            uint8_t prefix[] = {eid, MCTP_MSG_TYPE_PLDM};
+            struct iovec iov[2]{};
+            iov[0].iov_base = prefix;
+            iov[0].iov_len = sizeof(prefix);
+            iov[1].iov_base = const_cast<uint8_t*>(requestMsg.data());
+            iov[1].iov_len = requestMsg.size();
+
+            struct msghdr msg
+            {
+            };
+            msg.msg_iov = iov;
+            msg.msg_iovlen = sizeof(iov) / sizeof(iov[0]);
+            if (-1 == sendmsg(socketFd(), &msg, 0))
+            {
+                int returnCode = -errno;
+                std::cerr << "sendto system call failed, RC= " << returnCode
+                          << "\n";
+                return returnCode;
+            }
+            return 0;
+        },
+        std::chrono::milliseconds(RESPONSE_TIME_OUT_MS),
+        NUMBER_OF_REQUEST_RETRIES);
+
+    requester::SendRequest sendRequest =
+        [&reqHandler](uint8_t eid, uint8_t type, uint8_t command,
+                      size_t payloadLength, const requester::Encoder& encode,
+                      requester::ResponseHandler handler) {
+            return reqHandler.sendRequest(eid, type, command, payloadLength,
+                                          encode, std::move(handler));
+        };
+
+    // Discover the termini behind the MCTP endpoints, an endpoint that goes
+    // away is forgotten so that it is probed again when it comes back
+    requester::Discovery discovery(sendRequest);
+
+    // Poll the sensors the PDRs of the termini describe, readings that
+    // change are published like the sensor events the termini send
+    requester::SensorPoller sensorPoller(
+        event, sendRequest, events::publish,
+        std::chrono::milliseconds(SENSOR_POLL_MIN_INTERVAL_MS),
+        std::chrono::milliseconds(SENSOR_POLL_MAX_INTERVAL_MS),
+        SENSOR_POLL_OUTSTANDING);
+
+    // Merge the PDRs of the termini that have them into the local repository
+    requester::PdrAggregator pdrAggregator(
+        sendRequest,
+        [&discovery, &sensorPoller, &platformResponder](
+            uint8_t eid, std::vector<std::vector<uint8_t>>&& records) {
+            auto capabilities = discovery.get(eid);
+            if (capabilities)
+            {
+                sensorPoller.track(eid, *capabilities, records);
+            }
+            pdr::mergeRemote(eid, std::move(records));
+            platformResponder.watchSensors();
+        });
+    discovery.subscribe(
+        [&pdrAggregator, &sensorPoller, &platformResponder](
+            uint8_t eid,
+            std::shared_ptr<const requester::Capabilities> capabilities) {
+            if (!capabilities)
+            {
+                pdrAggregator.forget(eid);
+                sensorPoller.untrack(eid);
+                pdr::removeRemote(eid);
+                platformResponder.watchSensors();
+            }
+            else if (capabilities->supports(PLDM_PLATFORM, PLDM_GET_PDR))
+            {
+                pdrAggregator.sync(eid);
+            }
+        });
+    std::map<std::string, uint8_t> endpoints;
+    auto addEndpoint = [&discovery, &endpoints](
+                           const std::string& path,
+                           const EndpointProperties& properties) {
+        auto eid = pldmEid(properties);
+        if (eid)
+        {
+            endpoints[path] = *eid;
+            discovery.discover({*eid});
+        }
+    };
+    namespace rules = sdbusplus::bus::match::rules;
+    sdbusplus::bus::match::match endpointAdded(
+        bus, rules::interfacesAdded() + rules::path_namespace(mctpPath),
+        [&addEndpoint](sdbusplus::message::message& msg) {
+            // The signal is for any interface of the namespace, with
+            // properties of any type
+            try
+            {
+                sdbusplus::message::object_path path;
+                std::map<std::string, EndpointProperties> interfaces;
+                msg.read(path, interfaces);
+                auto endpoint = interfaces.find(mctpEndpointIntf);
+                if (endpoint != interfaces.end())
+                {
+                    addEndpoint(path, endpoint->second);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Failed to read the MCTP endpoint added, ERROR="
+                          << e.what() << "\n";
+            }
+        });
+    sdbusplus::bus::match::match endpointRemoved(
+        bus, rules::interfacesRemoved() + rules::path_namespace(mctpPath),
+        [&discovery, &endpoints](sdbusplus::message::message& msg) {
+            try
+            {
+                sdbusplus::message::object_path path;
+                std::vector<std::string> interfaces;
+                msg.read(path, interfaces);
+                auto endpoint = endpoints.find(path);
+                if (endpoint != endpoints.end() &&
+                    std::find(interfaces.begin(), interfaces.end(),
+                              mctpEndpointIntf) != interfaces.end())
+                {
+                    discovery.invalidate(endpoint->second);
+                    endpoints.erase(endpoint);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Failed to read the MCTP endpoint removed, ERROR="
+                          << e.what() << "\n";
+            }
+        });
+    for (const auto& [path, properties] : getEndpoints(bus))
+    {
+        addEndpoint(path, properties);
+    }
+
+    auto callback = [verbose, &invoker, &reqHandler](IO& /*io*/, int fd,
+                                                     uint32_t revents) {
         if (!(revents & EPOLLIN))
         {
             return;
@@ -244,7 +479,7 @@ int main(int argc, char** argv)
                 {
                     // process message and send response
                     auto response =
-                        processRxMsg(requestMsg, invoker, dbusImplReq);
+                        processRxMsg(requestMsg, invoker, reqHandler);
                     if (!response.empty())
                     {
                         if (verbose)
@@ -282,10 +517,72 @@ int main(int argc, char** argv)
         }
     };
 
-    auto event = Event::get_default();
+    // Watch the PDR JSONs and rebuild the PDR in the background when they
+    // change, the new repository is published once it is complete. The
+    // background rebuilds wake the event loop through an eventfd, their
+    // errors are reported from there as reporting takes D-Bus calls.
+    pldm::utils::CustomFD rebuiltFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+    pldm::utils::CustomFD pdrWatchFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC));
+    if (-1 == rebuiltFd() || -1 == pdrWatchFd() ||
+        -1 == inotify_add_watch(pdrWatchFd(), PDR_JSONS_DIR,
+                                IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM |
+                                    IN_DELETE))
+    {
+        std::cerr << "Failed to watch PDR JSONs, PDR changes require a "
+                     "restart, DIR="
+                  << PDR_JSONS_DIR << " ERRNO=" << errno << "\n";
+    }
+    auto pdrWatchCallback = [&rebuiltFd](IO& /*io*/, int fd,
+                                         uint32_t revents) {
+        if (!(revents & EPOLLIN))
+        {
+            return;
+        }
+
+        alignas(inotify_event) char buffer[4096];
+        while (read(fd, buffer, sizeof(buffer)) > 0)
+        {
+        }
+        pdr::rebuildAsync(PDR_JSONS_DIR, [fd = rebuiltFd()]() {
+            uint64_t count = 1;
+            if (write(fd, &count, sizeof(count)) < 0)
+            {
+                std::cerr << "Failed to signal a PDR rebuild, ERRNO=" << errno
+                          << "\n";
+            }
+        });
+    };
+    auto rebuiltCallback = [&platformResponder](IO& /*io*/, int fd,
+                                                uint32_t revents) {
+        if (!(revents & EPOLLIN))
+        {
+            return;
+        }
+
+        uint64_t count = 0;
+        if (read(fd, &count, sizeof(count)) > 0)
+        {
+            pdr::finishRebuilds();
+            platformResponder.watchSensors();
+        }
+    };
+
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
     bus.request_name("xyz.openbmc_project.PLDM");
+
+    // The sensor readings are answered from memory, filled in before the
+    // first request is taken
+    platformResponder.watchSensors();
     IO io(event, socketFd(), EPOLLIN, std::move(callback));
+    std::unique_ptr<IO> pdrWatch;
+    std::unique_ptr<IO> pdrRebuilt;
+    if (-1 != pdrWatchFd() && -1 != rebuiltFd())
+    {
+        pdrWatch = std::make_unique<IO>(event, pdrWatchFd(), EPOLLIN,
+                                        std::move(pdrWatchCallback));
+        pdrRebuilt = std::make_unique<IO>(event, rebuiltFd(), EPOLLIN,
+                                          std::move(rebuiltCallback));
+    }
     event.loop();
 
     result = shutdown(sockfd, SHUT_RDWR);
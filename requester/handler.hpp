@@ -0,0 +1,261 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+#include <tuple>
+#include <vector>
+
+#include "libpldm/base.h"
+
+namespace pldm
+{
+
+namespace requester
+{
+
+/** @brief Called with the response to a request, or with a null response
+ *         once the request has timed out on every retry
+ *
+ *  @param[in] eid - MCTP endpoint the request was sent to
+ *  @param[in] response - the response message
+ *  @param[in] respMsgLen - length of the response payload
+ */
+using ResponseHandler = std::function<void(
+    uint8_t eid, const pldm_msg* response, size_t respMsgLen)>;
+
+/** @brief Writes a PLDM message to an MCTP endpoint
+ *
+ *  @param[in] eid - MCTP endpoint
+ *  @param[in] msg - the PLDM message, header included
+ *
+ *  @return 0 on success, negative errno otherwise
+ */
+using Transport =
+    std::function<int(uint8_t eid, const std::vector<uint8_t>& msg)>;
+
+/** @brief Encodes a request into a message sized by the caller
+ *
+ *  @param[in] instanceId - instance id allocated for the request
+ *  @param[out] msg - the request message
+ *
+ *  @return pldm_completion_codes
+ */
+using Encoder = std::function<int(uint8_t instanceId, pldm_msg* msg)>;
+
+/** @class Handler
+ *
+ *  @brief Sends PLDM requests without waiting for their responses. Any
+ *         number of requests, to any number of endpoints, can be in flight
+ *         at once. Responses are matched to their request by endpoint,
+ *         instance id, type and command and handed to the request's
+ *         handler from the event loop. A request that gets no response in
+ *         time is retried, then its handler is told it timed out.
+ *
+ *  @tparam InstanceIdDb - allocates instance ids, with
+ *                         getInstanceId(eid) and markFree(eid, instanceId)
+ */
+template <class InstanceIdDb>
+class Handler
+{
+  public:
+    Handler() = delete;
+    Handler(const Handler&) = delete;
+    Handler& operator=(const Handler&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - event loop the time outs run on
+     *  @param[in] instanceIds - instance id allocator shared with the other
+     *                           requesters on the endpoints
+     *  @param[in] send - writes the requests to the endpoints
+     *  @param[in] timeout - time to wait for each response
+     *  @param[in] retries - number of times a request is sent again
+     *                       after it timed out
+     */
+    Handler(const sdeventplus::Event& event, InstanceIdDb& instanceIds,
+            Transport send, std::chrono::milliseconds timeout,
+            uint8_t retries) :
+        event(event),
+        instanceIds(instanceIds), send(std::move(send)), timeout(timeout),
+        retries(retries)
+    {
+    }
+
+    /** @brief Send a request
+     *
+     *  @param[in] eid - MCTP endpoint
+     *  @param[in] type - PLDM type of the request
+     *  @param[in] command - PLDM command of the request
+     *  @param[in] payloadLength - length of the request payload
+     *  @param[in] encode - encodes the request
+     *  @param[in] handler - called with the response, never before this
+     *                       returns
+     *
+     *  @return PLDM_SUCCESS if the request was sent, the handler is called
+     *          exactly once. Otherwise the handler is dropped.
+     */
+    int sendRequest(uint8_t eid, uint8_t type, uint8_t command,
+                    size_t payloadLength, const Encoder& encode,
+                    ResponseHandler handler)
+    {
+        uint8_t instanceId = 0;
+        try
+        {
+            instanceId = instanceIds.getInstanceId(eid);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to get an instance id, EID="
+                      << static_cast<unsigned>(eid) << " ERROR=" << e.what()
+                      << "\n";
+            return PLDM_ERROR;
+        }
+
+        std::vector<uint8_t> msg(sizeof(pldm_msg_hdr) + payloadLength);
+        auto rc = encode(instanceId, reinterpret_cast<pldm_msg*>(msg.data()));
+        if (rc == PLDM_SUCCESS && send(eid, msg) < 0)
+        {
+            rc = PLDM_ERROR;
+        }
+        if (rc != PLDM_SUCCESS)
+        {
+            instanceIds.markFree(eid, instanceId);
+            return rc;
+        }
+
+        Key key{eid, instanceId, type, command};
+        auto timer = std::make_unique<Timer>(
+            event, [this, key](Timer& /*timer*/) { expire(key); });
+        timer->restartOnce(timeout);
+        pending[key] = {std::move(msg), std::move(handler), std::move(timer),
+                        retries};
+        return PLDM_SUCCESS;
+    }
+
+    /** @brief Hand a response to the handler of its request. Responses
+     *         nobody waits for, late ones included, are dropped.
+     *
+     *  @param[in] eid - MCTP endpoint the response came from
+     *  @param[in] response - the response message
+     *  @param[in] respMsgLen - length of the response payload
+     */
+    void handleResponse(uint8_t eid, const pldm_msg* response,
+                        size_t respMsgLen)
+    {
+        auto request = pending.find({eid, response->hdr.instance_id,
+                                     response->hdr.type,
+                                     response->hdr.command});
+        if (request == pending.end())
+        {
+            // The id isn't ours to free, it may be in use again already
+            return;
+        }
+        instanceIds.markFree(eid, response->hdr.instance_id);
+        auto handler = std::move(request->second.handler);
+        retire(request);
+        handler(eid, response, respMsgLen);
+    }
+
+    /** @brief Get the number of requests waiting for a response
+     *
+     *  @return size_t - number of requests in flight
+     */
+    size_t getPending() const
+    {
+        return pending.size();
+    }
+
+  private:
+    using Timer = sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>;
+
+    /** @brief Endpoint, instance id, type and command of a request */
+    using Key = std::tuple<uint8_t, uint8_t, uint8_t, uint8_t>;
+
+    /** @struct Request
+     *
+     *  @brief A request waiting for its response
+     */
+    struct Request
+    {
+        std::vector<uint8_t> msg;
+        ResponseHandler handler;
+        std::unique_ptr<Timer> timer;
+        uint8_t retries;
+    };
+
+    /** @brief Retry a request that timed out, or give up on it
+     *
+     *  @param[in] key - the request
+     */
+    void expire(const Key& key)
+    {
+        auto request = pending.find(key);
+        if (request == pending.end())
+        {
+            return;
+        }
+        auto [eid, instanceId, type, command] = key;
+        if (request->second.retries)
+        {
+            --request->second.retries;
+            send(eid, request->second.msg);
+            request->second.timer->restartOnce(timeout);
+            return;
+        }
+
+        std::cerr << "PLDM request timed out, EID="
+                  << static_cast<unsigned>(eid)
+                  << " TYPE=" << static_cast<unsigned>(type)
+                  << " COMMAND=" << static_cast<unsigned>(command) << "\n";
+        instanceIds.markFree(eid, instanceId);
+        auto handler = std::move(request->second.handler);
+        retire(request);
+        handler(eid, nullptr, 0);
+    }
+
+    /** @brief Forget a request. Its timer may be the one running, so it is
+     *         kept until the next request is retired.
+     *
+     *  @param[in] request - the request
+     */
+    void retire(typename std::map<Key, Request>::iterator request)
+    {
+        retired.clear();
+        request->second.timer->setEnabled(false);
+        retired.push_back(std::move(request->second.timer));
+        pending.erase(request);
+    }
+
+    /** @brief Event loop the time outs run on */
+    sdeventplus::Event event;
+
+    /** @brief Instance id allocator */
+    InstanceIdDb& instanceIds;
+
+    /** @brief Writes the requests */
+    Transport send;
+
+    /** @brief Time to wait for each response */
+    std::chrono::milliseconds timeout;
+
+    /** @brief Number of times a request is sent again */
+    uint8_t retries;
+
+    /** @brief Requests waiting for a response */
+    std::map<Key, Request> pending;
+
+    /** @brief Timers of retired requests */
+    std::vector<std::unique_ptr<Timer>> retired;
+};
+
+} // namespace requester
+} // namespace pldm
@@ -0,0 +1,268 @@
+#include "pdr_aggregator.hpp"
+
+#include <endian.h>
+
+#include <iostream>
+
+#include "libpldm/utils.h"
+
+namespace pldm
+{
+
+namespace requester
+{
+
+void PdrAggregator::sync(uint8_t eid)
+{
+    auto found = fetches.find(eid);
+    if (found != fetches.end())
+    {
+        found->second.again = true;
+        return;
+    }
+
+    auto& fetch = fetches[eid];
+    fetch.generation = ++generation;
+    auto rc = send(
+        eid, PLDM_PLATFORM, PLDM_GET_PDR_REPOSITORY_INFO, 0,
+        [](uint8_t instanceId, pldm_msg* msg) {
+            return encode_get_pdr_repository_info_req(instanceId, msg);
+        },
+        [this, generation = fetch.generation](
+            uint8_t eid, const pldm_msg* response, size_t respMsgLen) {
+            auto found = fetches.find(eid);
+            if (found == fetches.end() ||
+                found->second.generation != generation)
+            {
+                return;
+            }
+
+            // Without the repository info the repository is always fetched
+            RepositorySignature signature{};
+            uint8_t cc = 0;
+            uint8_t state = 0;
+            uint8_t timeout = 0;
+            if (response &&
+                decode_get_pdr_repository_info_resp(
+                    response, respMsgLen, &cc, &state,
+                    signature.updateTime.data(),
+                    signature.oemUpdateTime.data(), &signature.recordCount,
+                    &signature.repositorySize, &signature.largestRecordSize,
+                    &timeout) == PLDM_SUCCESS &&
+                cc == PLDM_SUCCESS)
+            {
+                if (state != PLDM_PDR_REPOSITORY_AVAILABLE)
+                {
+                    std::cerr << "PDR repository unavailable, EID="
+                              << static_cast<unsigned>(eid)
+                              << " STATE=" << static_cast<unsigned>(state)
+                              << "\n";
+                    end(eid);
+                    return;
+                }
+                auto last = synced.find(eid);
+                if (last != synced.end() && last->second == signature)
+                {
+                    end(eid);
+                    return;
+                }
+                found->second.signature = signature;
+            }
+            schedule(eid);
+        });
+    if (rc != PLDM_SUCCESS)
+    {
+        fetches.erase(eid);
+    }
+}
+
+void PdrAggregator::forget(uint8_t eid)
+{
+    fetches.erase(eid);
+    synced.erase(eid);
+}
+
+void PdrAggregator::request(uint8_t eid, Fetch& fetch, RecordHandle handle,
+                            uint32_t transferHandle)
+{
+    ++fetch.outstanding;
+    fetch.requested.insert(handle);
+    auto rc = send(
+        eid, PLDM_PLATFORM, PLDM_GET_PDR, PLDM_GET_PDR_REQ_BYTES,
+        [handle, transferHandle](uint8_t instanceId, pldm_msg* msg) {
+            return encode_get_pdr_req(
+                instanceId, handle, transferHandle,
+                transferHandle ? PLDM_GET_NEXTPART : PLDM_GET_FIRSTPART,
+                pdrRequestCount, 0, msg, PLDM_GET_PDR_REQ_BYTES);
+        },
+        [this, generation = fetch.generation, handle](
+            uint8_t eid, const pldm_msg* response, size_t respMsgLen) {
+            auto found = fetches.find(eid);
+            if (found == fetches.end() ||
+                found->second.generation != generation)
+            {
+                return;
+            }
+            --found->second.outstanding;
+            receive(eid, found->second, handle, response, respMsgLen);
+            schedule(eid);
+        });
+    if (rc != PLDM_SUCCESS)
+    {
+        --fetch.outstanding;
+        fetch.missing.insert(handle);
+        fetch.speculate = false;
+    }
+}
+
+void PdrAggregator::receive(uint8_t eid, Fetch& fetch, RecordHandle handle,
+                            const pldm_msg* response, size_t respMsgLen)
+{
+    uint8_t cc = 0;
+    uint32_t nextRecord = 0;
+    uint32_t nextTransfer = 0;
+    uint8_t flag = 0;
+    uint16_t count = 0;
+    uint8_t crc = 0;
+    std::vector<uint8_t> data(pdrRequestCount);
+    if (!response ||
+        decode_get_pdr_resp(response, respMsgLen, &cc, &nextRecord,
+                            &nextTransfer, &flag, &count, data.data(),
+                            data.size(), &crc) != PLDM_SUCCESS ||
+        cc != PLDM_SUCCESS)
+    {
+        // A guess that missed, the fetch fails if the record is needed
+        fetch.missing.insert(handle);
+        fetch.parts.erase(handle);
+        fetch.speculate = false;
+        return;
+    }
+
+    auto& record = fetch.parts[handle];
+    record.insert(record.end(), data.begin(), data.begin() + count);
+
+    // The record is whole once it has the length its header gives
+    bool whole = false;
+    if (record.size() >= sizeof(pldm_pdr_hdr))
+    {
+        auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(record.data());
+        auto length = sizeof(pldm_pdr_hdr) + le16toh(hdr->length);
+        if (record.size() >= length)
+        {
+            record.resize(length);
+            whole = true;
+        }
+    }
+    if (!whole && flag != PLDM_END && flag != PLDM_START_AND_END)
+    {
+        request(eid, fetch, handle, nextTransfer);
+        return;
+    }
+    if (!whole || (flag == PLDM_END && crc8(record.data(), record.size()) !=
+                                           crc))
+    {
+        fetch.missing.insert(handle);
+        fetch.parts.erase(handle);
+        return;
+    }
+
+    auto key = handle;
+    if (!handle)
+    {
+        auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(record.data());
+        key = le32toh(hdr->record_handle);
+        fetch.first = key;
+        fetch.requested.insert(key);
+    }
+    fetch.next[key] = nextRecord;
+    fetch.records[key] = std::move(record);
+    fetch.parts.erase(handle);
+}
+
+void PdrAggregator::schedule(uint8_t eid)
+{
+    auto& fetch = fetches.at(eid);
+
+    // Follow the chain of next record handles as far as it's fetched
+    std::vector<RecordHandle> chain;
+    RecordHandle needed = 0;
+    if (fetch.first)
+    {
+        needed = *fetch.first;
+        while (fetch.records.count(needed) &&
+               chain.size() <= fetch.records.size())
+        {
+            chain.push_back(needed);
+            needed = fetch.next[needed];
+            if (!needed)
+            {
+                finish(eid, chain);
+                return;
+            }
+        }
+    }
+
+    if (!fetch.requested.count(needed))
+    {
+        request(eid, fetch, needed, 0);
+    }
+    if (fetch.speculate)
+    {
+        size_t recordCount =
+            fetch.signature ? fetch.signature->recordCount : SIZE_MAX;
+        // Until the first record arrives it's assumed to be record 1
+        for (auto handle = fetch.first ? needed + 1 : 2;
+             fetch.speculate && fetch.outstanding < window &&
+             fetch.records.size() + fetch.outstanding < recordCount;
+             ++handle)
+        {
+            if (!fetch.requested.count(handle))
+            {
+                request(eid, fetch, handle, 0);
+            }
+        }
+    }
+
+    if (fetch.missing.count(needed) || !fetch.outstanding ||
+        chain.size() > fetch.records.size())
+    {
+        std::cerr << "Failed to fetch PDRs, EID=" << static_cast<unsigned>(eid)
+                  << " RECORD_HANDLE=" << needed << "\n";
+        end(eid);
+    }
+}
+
+void PdrAggregator::finish(uint8_t eid, const std::vector<RecordHandle>& chain)
+{
+    auto& fetch = fetches.at(eid);
+    std::vector<std::vector<uint8_t>> records;
+    records.reserve(chain.size());
+    for (auto handle : chain)
+    {
+        records.emplace_back(std::move(fetch.records[handle]));
+    }
+
+    if (fetch.signature)
+    {
+        synced[eid] = *fetch.signature;
+    }
+    else
+    {
+        synced.erase(eid);
+    }
+    merge(eid, std::move(records));
+    end(eid);
+}
+
+void PdrAggregator::end(uint8_t eid)
+{
+    auto again = fetches.at(eid).again;
+    fetches.erase(eid);
+    if (again)
+    {
+        sync(eid);
+    }
+}
+
+} // namespace requester
+} // namespace pldm
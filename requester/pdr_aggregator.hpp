@@ -0,0 +1,197 @@
+#pragma once
+
+#include "terminus.hpp"
+
+#include <stdint.h>
+
+#include <array>
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "libpldm/platform.h"
+
+namespace pldm
+{
+
+namespace requester
+{
+
+/** @brief Number of GetPDR requests kept in flight per terminus */
+constexpr size_t pdrWindow = 8;
+
+/** @brief Largest part of a PDR asked for in a GetPDR request */
+constexpr uint16_t pdrRequestCount = 1024;
+
+/** @struct RepositorySignature
+ *
+ *  @brief Identifies the contents of a remote PDR repository, as reported by
+ *         GetPDRRepositoryInfo
+ */
+struct RepositorySignature
+{
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime;
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> oemUpdateTime;
+    uint32_t recordCount;
+    uint32_t repositorySize;
+    uint32_t largestRecordSize;
+
+    bool operator==(const RepositorySignature& other) const
+    {
+        return updateTime == other.updateTime &&
+               oemUpdateTime == other.oemUpdateTime &&
+               recordCount == other.recordCount &&
+               repositorySize == other.repositorySize &&
+               largestRecordSize == other.largestRecordSize;
+    }
+};
+
+/** @class PdrAggregator
+ *
+ *  @brief Fetches the PDR repositories of remote termini with GetPDR and
+ *         hands them over to be merged into the local repository.
+ *
+ *  The termini are fetched from in parallel, and each fetch keeps a window
+ *  of requests in flight: besides the record the chain of next record
+ *  handles leads to, the records that follow it are asked for on the
+ *  assumption that the terminus numbers its records contiguously. The first
+ *  guess that misses turns the guessing off, and the fetch follows the
+ *  chain one record at a time. A repository whose GetPDRRepositoryInfo is
+ *  unchanged since the last fetch is skipped.
+ */
+class PdrAggregator
+{
+  public:
+    /** @brief Takes the PDRs fetched from a terminus
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] records - the PDRs, in the terminus's record handle order
+     */
+    using Merge = std::function<void(
+        uint8_t eid, std::vector<std::vector<uint8_t>>&& records)>;
+
+    /** @brief Constructor
+     *
+     *  @param[in] send - sends the requests
+     *  @param[in] merge - takes the fetched PDRs
+     *  @param[in] window - number of requests in flight per terminus
+     */
+    PdrAggregator(SendRequest send, Merge merge, size_t window = pdrWindow) :
+        send(std::move(send)), merge(std::move(merge)), window(window)
+    {
+    }
+
+    /** @brief Fetch the repository of a terminus if it changed. A terminus
+     *         being fetched from is fetched from again once done.
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    void sync(uint8_t eid);
+
+    /** @brief Stop fetching from a terminus and forget its repository was
+     *         fetched, used when its endpoint is reset or goes away
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    void forget(uint8_t eid);
+
+    /** @brief Check if a terminus is being fetched from
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *
+     *  @return bool - true while the fetch is in progress
+     */
+    bool isSyncing(uint8_t eid) const
+    {
+        return fetches.count(eid);
+    }
+
+  private:
+    using RecordHandle = uint32_t;
+
+    /** @struct Fetch
+     *
+     *  @brief A repository being fetched
+     */
+    struct Fetch
+    {
+        uint32_t generation;
+        std::optional<RepositorySignature> signature;
+        std::optional<RecordHandle> first;
+        std::map<RecordHandle, std::vector<uint8_t>> records;
+        std::map<RecordHandle, RecordHandle> next;
+        std::map<RecordHandle, std::vector<uint8_t>> parts;
+        std::set<RecordHandle> requested;
+        std::set<RecordHandle> missing;
+        size_t outstanding = 0;
+        bool speculate = true;
+        bool again = false;
+    };
+
+    /** @brief Send a GetPDR request of a fetch
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] fetch - the fetch
+     *  @param[in] handle - record handle, 0 for the first record
+     *  @param[in] transferHandle - data transfer handle of the next part of
+     *                              a record, 0 for the first part
+     */
+    void request(uint8_t eid, Fetch& fetch, RecordHandle handle,
+                 uint32_t transferHandle);
+
+    /** @brief Handle a GetPDR response
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] fetch - the fetch
+     *  @param[in] handle - record handle asked for
+     *  @param[in] response - the response message, nullptr on time out
+     *  @param[in] respMsgLen - length of the response payload
+     */
+    void receive(uint8_t eid, Fetch& fetch, RecordHandle handle,
+                 const pldm_msg* response, size_t respMsgLen);
+
+    /** @brief Request what the fetch needs next, or finish it
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    void schedule(uint8_t eid);
+
+    /** @brief Hand over the fetched PDRs and end the fetch
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] chain - record handles of the fetched PDRs, in order
+     */
+    void finish(uint8_t eid, const std::vector<RecordHandle>& chain);
+
+    /** @brief End a fetch, and start the next one if it was asked for while
+     *         this one was in progress
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    void end(uint8_t eid);
+
+    /** @brief Sends the requests */
+    SendRequest send;
+
+    /** @brief Takes the fetched PDRs */
+    Merge merge;
+
+    /** @brief Number of requests in flight per terminus */
+    size_t window;
+
+    /** @brief Repositories being fetched */
+    std::map<uint8_t, Fetch> fetches;
+
+    /** @brief Signature of the repositories fetched */
+    std::map<uint8_t, RepositorySignature> synced;
+
+    /** @brief Number of fetches started, tells responses to an abandoned
+     *         fetch from the fetch that replaced it
+     */
+    uint32_t generation = 0;
+};
+
+} // namespace requester
+} // namespace pldm
@@ -0,0 +1,558 @@
+#include "sensor_poller.hpp"
+
+#include <endian.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "libpldm/platform.h"
+
+namespace pldm
+{
+
+namespace requester
+{
+
+namespace
+{
+
+/** @brief Largest number of composite sensors of a state sensor */
+constexpr size_t maxCompositeSensors = 8;
+
+/** @brief Width in bytes of a numeric sensor field
+ *
+ *  @param[in] format - the field format, a pldm_range_field_format. The
+ *                      sensor data sizes share the integer formats.
+ *
+ *  @return size_t - width of the field
+ */
+size_t numericWidth(uint8_t format)
+{
+    switch (format)
+    {
+        case PLDM_RANGE_FIELD_FORMAT_UINT8:
+        case PLDM_RANGE_FIELD_FORMAT_SINT8:
+            return sizeof(uint8_t);
+        case PLDM_RANGE_FIELD_FORMAT_UINT16:
+        case PLDM_RANGE_FIELD_FORMAT_SINT16:
+            return sizeof(uint16_t);
+        default:
+            return sizeof(uint32_t);
+    }
+}
+
+/** @brief Convert a little endian numeric sensor value
+ *
+ *  @param[in] format - the value format
+ *  @param[in] raw - the value, in the low order bytes
+ *
+ *  @return double - the value
+ */
+double toDouble(uint8_t format, uint32_t raw)
+{
+    switch (format)
+    {
+        case PLDM_RANGE_FIELD_FORMAT_UINT8:
+            return static_cast<uint8_t>(raw);
+        case PLDM_RANGE_FIELD_FORMAT_SINT8:
+            return static_cast<int8_t>(raw);
+        case PLDM_RANGE_FIELD_FORMAT_UINT16:
+            return static_cast<uint16_t>(raw);
+        case PLDM_RANGE_FIELD_FORMAT_SINT16:
+            return static_cast<int16_t>(raw);
+        case PLDM_RANGE_FIELD_FORMAT_UINT32:
+            return raw;
+        case PLDM_RANGE_FIELD_FORMAT_SINT32:
+            return static_cast<int32_t>(raw);
+        default:
+        {
+            float value = 0;
+            std::memcpy(&value, &raw, sizeof(value));
+            return value;
+        }
+    }
+}
+
+/** @brief Read a numeric sensor PDR field and advance past it
+ *
+ *  @param[in] format - the field format
+ *  @param[in,out] pos - where the field is read from
+ *
+ *  @return double - the field value
+ */
+double readNumeric(uint8_t format, const uint8_t*& pos)
+{
+    uint32_t raw = 0;
+    auto width = numericWidth(format);
+    std::memcpy(&raw, pos, width);
+    pos += width;
+    return toDouble(format, le32toh(raw));
+}
+
+/** @brief The thresholds of a numeric sensor PDR, as their bit in the
+ *         supported thresholds bitfield and their index among the range
+ *         fields
+ */
+constexpr std::pair<uint8_t, size_t> thresholdFields[] = {
+    {1 << 0, 3}, {1 << 3, 4}, {1 << 1, 5}, {1 << 4, 6}, {1 << 2, 7},
+    {1 << 5, 8}};
+
+/** @brief Number of range fields of a numeric sensor PDR */
+constexpr size_t rangeFieldCount = 9;
+
+/** @brief Round an interval down to a power of two multiple of the shortest
+ *         interval
+ *
+ *  @param[in] ticks - the interval
+ *  @param[in] min - shortest interval
+ *  @param[in] max - longest interval
+ *
+ *  @return size_t - the rounded interval, at least min
+ */
+size_t quantize(size_t ticks, size_t min, size_t max)
+{
+    auto limit = std::min(ticks, max);
+    auto interval = min;
+    while (interval * 2 <= limit)
+    {
+        interval *= 2;
+    }
+    return interval;
+}
+
+} // namespace
+
+SensorPoller::SensorPoller(const sdeventplus::Event& event, SendRequest send,
+                           Publish publish,
+                           std::chrono::milliseconds minInterval,
+                           std::chrono::milliseconds maxInterval,
+                           size_t outstanding) :
+    send(std::move(send)),
+    publish(std::move(publish)),
+    minTicks(std::max<size_t>(1, minInterval / pollTick)),
+    maxTicks(std::max<size_t>(minTicks, maxInterval / pollTick)),
+    outstanding(std::max<size_t>(1, outstanding)), wheel(wheelSlots),
+    timer(std::make_unique<
+          sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
+        event, [this](auto& /*timer*/) { tick(); }))
+{
+}
+
+bool SensorPoller::parseNumeric(const std::vector<uint8_t>& record,
+                                Sensor& sensor) const
+{
+    if (record.size() < sizeof(pldm_numeric_sensor_pdr) - 1)
+    {
+        return false;
+    }
+    auto pdr = reinterpret_cast<const pldm_numeric_sensor_pdr*>(record.data());
+    auto dataSize = pdr->sensor_data_size;
+    if (dataSize > PLDM_SENSOR_DATA_SIZE_SINT32)
+    {
+        return false;
+    }
+    sensor.id = le16toh(pdr->sensor_id);
+
+    // resolution, offset, accuracy, tolerances and hysteresis
+    auto dataWidth = numericWidth(dataSize);
+    const uint8_t* pos = pdr->variable_fields;
+    const uint8_t* end = record.data() + record.size();
+    if (static_cast<size_t>(end - pos) <
+        sizeof(float) * 4 + sizeof(uint16_t) + 6 + 3 * dataWidth)
+    {
+        return false;
+    }
+    pos += sizeof(float) * 2 + sizeof(uint16_t) + 2 + dataWidth;
+    uint8_t supportedThresholds = *pos;
+    pos += 2 + sizeof(float);
+    float updateInterval = 0;
+    std::memcpy(&updateInterval, pos, sizeof(updateInterval));
+    pos += sizeof(updateInterval);
+    auto maxReadable = readNumeric(dataSize, pos);
+    auto minReadable = readNumeric(dataSize, pos);
+    auto rangeFormat = *pos;
+    pos += 2;
+    if (rangeFormat > PLDM_RANGE_FIELD_FORMAT_REAL32 ||
+        static_cast<size_t>(end - pos) <
+            rangeFieldCount * numericWidth(rangeFormat))
+    {
+        return false;
+    }
+    std::array<double, rangeFieldCount> range{};
+    for (auto& field : range)
+    {
+        field = readNumeric(rangeFormat, pos);
+    }
+
+    sensor.numeric = true;
+    sensor.compositeCount = 1;
+    sensor.span = std::max(0.0, maxReadable - minReadable);
+    for (const auto& [bit, index] : thresholdFields)
+    {
+        if (supportedThresholds & bit)
+        {
+            sensor.thresholds.push_back(range[index]);
+        }
+    }
+
+    // The sensor isn't polled faster than it updates its reading
+    sensor.minTicks = minTicks;
+    if (updateInterval > 0)
+    {
+        auto updateTicks = static_cast<size_t>(
+            std::ceil(updateInterval * 1000 / pollTick.count()));
+        while (sensor.minTicks < std::min(updateTicks, maxTicks))
+        {
+            sensor.minTicks *= 2;
+        }
+    }
+    return true;
+}
+
+void SensorPoller::track(uint8_t eid, const Capabilities& capabilities,
+                         const std::vector<std::vector<uint8_t>>& records)
+{
+    bool numeric = capabilities.supports(PLDM_PLATFORM,
+                                         PLDM_GET_SENSOR_READING);
+    bool state = capabilities.supports(PLDM_PLATFORM,
+                                       PLDM_GET_STATE_SENSOR_READINGS);
+
+    // Requests in flight for the replaced sensors still count
+    auto& terminus = termini[eid];
+    terminus.tid = capabilities.tid;
+    terminus.generation = ++generation;
+    terminus.sensors.clear();
+    terminus.ready.clear();
+    for (const auto& record : records)
+    {
+        if (record.size() < sizeof(pldm_pdr_hdr))
+        {
+            continue;
+        }
+        auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(record.data());
+        Sensor sensor{};
+        if (hdr->type == PLDM_NUMERIC_SENSOR_PDR && numeric)
+        {
+            if (!parseNumeric(record, sensor))
+            {
+                continue;
+            }
+        }
+        else if (hdr->type == PLDM_STATE_SENSOR_PDR && state &&
+                 record.size() >= sizeof(pldm_state_sensor_pdr) - 1)
+        {
+            auto pdr =
+                reinterpret_cast<const pldm_state_sensor_pdr*>(record.data());
+            sensor.id = le16toh(pdr->sensor_id);
+            sensor.compositeCount = pdr->composite_sensor_count;
+            sensor.minTicks = minTicks;
+            if (!sensor.compositeCount ||
+                sensor.compositeCount > maxCompositeSensors)
+            {
+                continue;
+            }
+        }
+        else
+        {
+            continue;
+        }
+        sensor.interval = sensor.minTicks;
+        terminus.sensors.emplace_back(std::move(sensor));
+    }
+
+    if (terminus.sensors.empty())
+    {
+        untrack(eid);
+        return;
+    }
+
+    // The first polls are spread over the shortest interval
+    for (size_t index = 0; index < terminus.sensors.size(); ++index)
+    {
+        auto& sensor = terminus.sensors[index];
+        sensor.due = now + 1 + index % sensor.minTicks;
+        schedule(eid, terminus, index);
+    }
+    if (!timer->isEnabled())
+    {
+        timer->restart(pollTick);
+    }
+}
+
+void SensorPoller::untrack(uint8_t eid)
+{
+    termini.erase(eid);
+    if (termini.empty())
+    {
+        timer->setEnabled(false);
+    }
+}
+
+size_t SensorPoller::size() const
+{
+    size_t count = 0;
+    for (const auto& [eid, terminus] : termini)
+    {
+        count += terminus.sensors.size();
+    }
+    return count;
+}
+
+std::chrono::milliseconds SensorPoller::getInterval(uint8_t eid,
+                                                    uint16_t sensorId) const
+{
+    auto found = termini.find(eid);
+    if (found != termini.end())
+    {
+        for (const auto& sensor : found->second.sensors)
+        {
+            if (sensor.id == sensorId)
+            {
+                return sensor.interval * pollTick;
+            }
+        }
+    }
+    return std::chrono::milliseconds(0);
+}
+
+void SensorPoller::schedule(uint8_t eid, const Terminus& terminus,
+                            size_t index)
+{
+    auto ticks = terminus.sensors[index].due - now;
+    wheel[terminus.sensors[index].due % wheelSlots].push_back(
+        {eid, terminus.generation, index, (ticks - 1) / wheelSlots});
+}
+
+void SensorPoller::tick()
+{
+    ++now;
+    auto& slot = wheel[now % wheelSlots];
+    std::vector<uint8_t> due;
+    size_t kept = 0;
+    for (const auto& slotted : slot)
+    {
+        auto found = termini.find(slotted.eid);
+        if (found == termini.end() ||
+            found->second.generation != slotted.generation)
+        {
+            continue;
+        }
+        if (slotted.rounds)
+        {
+            slot[kept] = slotted;
+            --slot[kept++].rounds;
+            continue;
+        }
+        found->second.ready.push_back(slotted.index);
+        due.push_back(slotted.eid);
+    }
+    slot.resize(kept);
+
+    std::sort(due.begin(), due.end());
+    due.erase(std::unique(due.begin(), due.end()), due.end());
+    for (auto eid : due)
+    {
+        dispatch(eid);
+    }
+}
+
+void SensorPoller::dispatch(uint8_t eid)
+{
+    auto& terminus = termini.at(eid);
+    while (terminus.outstanding < outstanding && !terminus.ready.empty())
+    {
+        auto index = terminus.ready.front();
+        terminus.ready.pop_front();
+        auto sensorId = terminus.sensors[index].id;
+
+        ++terminus.outstanding;
+        auto handler = [this, generation = terminus.generation, index](
+                           uint8_t eid, const pldm_msg* response,
+                           size_t respMsgLen) {
+            auto found = termini.find(eid);
+            if (found == termini.end())
+            {
+                return;
+            }
+            auto& terminus = found->second;
+            if (terminus.outstanding)
+            {
+                --terminus.outstanding;
+            }
+            if (terminus.generation == generation)
+            {
+                receive(eid, terminus, index, response, respMsgLen);
+            }
+            dispatch(eid);
+        };
+        int rc = PLDM_SUCCESS;
+        if (terminus.sensors[index].numeric)
+        {
+            rc = send(
+                eid, PLDM_PLATFORM, PLDM_GET_SENSOR_READING,
+                PLDM_GET_SENSOR_READING_REQ_BYTES,
+                [sensorId](uint8_t instanceId, pldm_msg* msg) {
+                    return encode_get_sensor_reading_req(instanceId, sensorId,
+                                                         false, msg);
+                },
+                std::move(handler));
+        }
+        else
+        {
+            rc = send(
+                eid, PLDM_PLATFORM, PLDM_GET_STATE_SENSOR_READINGS,
+                PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES,
+                [sensorId](uint8_t instanceId, pldm_msg* msg) {
+                    bitfield8_t rearm{};
+                    return encode_get_state_sensor_readings_req(
+                        instanceId, sensorId, rearm, 0, msg);
+                },
+                std::move(handler));
+        }
+        if (rc != PLDM_SUCCESS)
+        {
+            --terminus.outstanding;
+            receive(eid, terminus, index, nullptr, 0);
+        }
+    }
+}
+
+void SensorPoller::receive(uint8_t eid, Terminus& terminus, size_t index,
+                           const pldm_msg* response, size_t respMsgLen)
+{
+    auto& sensor = terminus.sensors[index];
+    auto event = [&terminus, &sensor](uint8_t eventClass) {
+        responder::events::SensorEvent event{};
+        event.tid = terminus.tid;
+        event.sensorId = sensor.id;
+        event.sensorEventClass = eventClass;
+        event.coalesced = 1;
+        return event;
+    };
+
+    // A sensor that couldn't be read backs off
+    size_t next = sensor.interval * 2;
+    if (sensor.numeric)
+    {
+        uint8_t cc = 0;
+        uint8_t dataSize = 0;
+        uint8_t opState = 0;
+        uint8_t eventEnable = 0;
+        uint8_t presentState = 0;
+        uint8_t previousState = 0;
+        uint8_t eventState = 0;
+        std::array<uint8_t, sizeof(uint32_t)> reading{};
+        if (response &&
+            decode_get_sensor_reading_resp(
+                response, respMsgLen, &cc, &dataSize, &opState, &eventEnable,
+                &presentState, &previousState, &eventState,
+                reading.data()) == PLDM_SUCCESS &&
+            cc == PLDM_SUCCESS)
+        {
+            uint32_t raw = 0;
+            std::memcpy(&raw, reading.data(), sizeof(raw));
+            raw = le32toh(raw);
+            auto value = toDouble(dataSize, raw);
+            bool changed = !sensor.read || raw != sensor.presentReading ||
+                           presentState != sensor.presentState;
+
+            if (sensor.read && opState != sensor.opState)
+            {
+                auto opEvent = event(PLDM_SENSOR_OP_STATE);
+                opEvent.eventState = opState;
+                opEvent.previousEventState = sensor.opState;
+                publish(opEvent);
+            }
+            if (changed)
+            {
+                auto numericEvent = event(PLDM_NUMERIC_SENSOR_STATE);
+                numericEvent.eventState = presentState;
+                numericEvent.previousEventState = previousState;
+                numericEvent.sensorDataSize = dataSize;
+                numericEvent.presentReading = raw;
+                publish(numericEvent);
+            }
+
+            next = changed ? sensor.interval / 2 : sensor.interval * 2;
+            if (!sensor.thresholds.empty() && sensor.span > 0)
+            {
+                double distance = HUGE_VAL;
+                for (auto threshold : sensor.thresholds)
+                {
+                    distance = std::min(distance, std::fabs(value - threshold));
+                }
+                auto last = toDouble(dataSize, sensor.presentReading);
+                if (distance < thresholdMargin * sensor.span)
+                {
+                    next = 0;
+                }
+                else if (sensor.read && value != last)
+                {
+                    // Ticks until the threshold is reached at this rate,
+                    // clamped before the cast, which is undefined for a
+                    // quotient that doesn't fit
+                    auto rate = std::fabs(value - last) / sensor.interval;
+                    auto ticks = std::min(distance / rate / 4,
+                                          static_cast<double>(maxTicks));
+                    next = std::min(next, static_cast<size_t>(ticks));
+                }
+            }
+
+            sensor.read = true;
+            sensor.opState = opState;
+            sensor.presentState = presentState;
+            sensor.presentReading = raw;
+        }
+    }
+    else
+    {
+        uint8_t cc = 0;
+        uint8_t count = maxCompositeSensors;
+        std::array<get_sensor_state_field, maxCompositeSensors> fields{};
+        if (response &&
+            decode_get_state_sensor_readings_resp(response, respMsgLen, &cc,
+                                                  &count, fields.data()) ==
+                PLDM_SUCCESS &&
+            cc == PLDM_SUCCESS && count)
+        {
+            bool changed = !sensor.read || count != sensor.states.size();
+            if (sensor.read && fields[0].sensor_op_state != sensor.opState)
+            {
+                auto opEvent = event(PLDM_SENSOR_OP_STATE);
+                opEvent.eventState = fields[0].sensor_op_state;
+                opEvent.previousEventState = sensor.opState;
+                publish(opEvent);
+            }
+            sensor.states.resize(count);
+            for (uint8_t offset = 0; offset < count; ++offset)
+            {
+                if (sensor.read &&
+                    fields[offset].present_state == sensor.states[offset])
+                {
+                    continue;
+                }
+                changed = true;
+                auto stateEvent = event(PLDM_STATE_SENSOR_STATE);
+                stateEvent.sensorOffset = offset;
+                stateEvent.eventState = fields[offset].present_state;
+                stateEvent.previousEventState = fields[offset].previous_state;
+                publish(stateEvent);
+                sensor.states[offset] = fields[offset].present_state;
+            }
+
+            next = changed ? sensor.interval / 2 : sensor.interval * 2;
+            sensor.read = true;
+            sensor.opState = fields[0].sensor_op_state;
+        }
+    }
+
+    // Polls due together stay together as long as their intervals match
+    sensor.interval = quantize(next, sensor.minTicks, maxTicks);
+    sensor.due = std::max(sensor.due + sensor.interval, now + 1);
+    schedule(eid, terminus, index);
+}
+
+} // namespace requester
+} // namespace pldm
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "libpldmresponder/events.hpp"
+#include "terminus.hpp"
+
+#include <stdint.h>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+#include <vector>
+
+namespace pldm
+{
+
+namespace requester
+{
+
+/** @brief Resolution of the sensor polling intervals */
+constexpr std::chrono::milliseconds pollTick(100);
+
+/** @brief Number of slots of the timer wheel, polls due further ahead than
+ *         a turn of the wheel wait for more turns in their slot
+ */
+constexpr size_t wheelSlots = 256;
+
+/** @brief A numeric sensor closer to a threshold than this fraction of its
+ *         range is polled at the shortest interval
+ */
+constexpr double thresholdMargin = 0.1;
+
+/** @class SensorPoller
+ *
+ *  @brief Polls the sensors of remote termini, as described by their PDRs,
+ *         with GetSensorReading and GetStateSensorReadings, and publishes
+ *         the readings that changed as sensor events.
+ *
+ *  Polls are scheduled on a timer wheel that advances every pollTick, so
+ *  the cost of a tick depends on the polls due, not on the number of
+ *  sensors. The polls due on a tick are queued per terminus and sent back
+ *  to back, with no more than a set number of requests in flight to each
+ *  terminus. A sensor is polled again only once its reading came back, so
+ *  a slow terminus delays its polls rather than piling them up.
+ *
+ *  Each sensor has its own interval, a power of two multiple of the
+ *  shortest interval so that polls due together stay together. The
+ *  interval doubles while the reading doesn't change and halves when it
+ *  does. A numeric sensor is polled at least four times in the time its
+ *  rate of change takes it to the nearest threshold, and at the shortest
+ *  interval when it's close to one.
+ */
+class SensorPoller
+{
+  public:
+    /** @brief Takes a sensor reading that changed */
+    using Publish =
+        std::function<void(const responder::events::SensorEvent& event)>;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - event loop the timer wheel runs on
+     *  @param[in] send - sends the requests
+     *  @param[in] publish - takes the readings that changed
+     *  @param[in] minInterval - shortest polling interval
+     *  @param[in] maxInterval - longest polling interval
+     *  @param[in] outstanding - number of requests in flight per terminus
+     */
+    SensorPoller(const sdeventplus::Event& event, SendRequest send,
+                 Publish publish, std::chrono::milliseconds minInterval,
+                 std::chrono::milliseconds maxInterval, size_t outstanding);
+
+    /** @brief Poll the sensors described by the PDRs of a terminus, replacing
+     *         the sensors polled on it before
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] capabilities - what the terminus supports, only the sensors
+     *                            it has a reading command for are polled
+     *  @param[in] records - the terminus's PDRs
+     */
+    void track(uint8_t eid, const Capabilities& capabilities,
+               const std::vector<std::vector<uint8_t>>& records);
+
+    /** @brief Stop polling the sensors of a terminus
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    void untrack(uint8_t eid);
+
+    /** @brief Advance the timer wheel by a tick and send the polls due,
+     *         called by the timer every pollTick
+     */
+    void tick();
+
+    /** @brief Get the number of sensors polled
+     *
+     *  @return size_t - number of sensors
+     */
+    size_t size() const;
+
+    /** @brief Get the polling interval of a sensor
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] sensorId - the sensor
+     *
+     *  @return std::chrono::milliseconds - the interval, 0 if the sensor
+     *          isn't polled
+     */
+    std::chrono::milliseconds getInterval(uint8_t eid,
+                                          uint16_t sensorId) const;
+
+  private:
+    /** @struct Sensor
+     *
+     *  @brief A polled sensor and its last reading
+     */
+    struct Sensor
+    {
+        uint16_t id;
+        bool numeric;
+        uint8_t compositeCount;
+        size_t minTicks;
+        size_t interval;
+        uint64_t due;
+        std::vector<double> thresholds;
+        double span;
+        bool read = false;
+        uint8_t opState = 0;
+        uint8_t presentState = 0;
+        uint32_t presentReading = 0;
+        std::vector<uint8_t> states;
+    };
+
+    /** @struct Terminus
+     *
+     *  @brief A terminus whose sensors are polled
+     */
+    struct Terminus
+    {
+        uint8_t tid;
+        uint32_t generation;
+        std::vector<Sensor> sensors;
+        std::deque<size_t> ready;
+        size_t outstanding = 0;
+    };
+
+    /** @struct Slotted
+     *
+     *  @brief A poll waiting in a slot of the timer wheel
+     */
+    struct Slotted
+    {
+        uint8_t eid;
+        uint32_t generation;
+        size_t index;
+        size_t rounds;
+    };
+
+    /** @brief Parse a numeric sensor PDR
+     *
+     *  @param[in] record - the PDR
+     *  @param[out] sensor - the sensor
+     *
+     *  @return bool - false if the PDR is malformed
+     */
+    bool parseNumeric(const std::vector<uint8_t>& record,
+                      Sensor& sensor) const;
+
+    /** @brief Put the next poll of a sensor in the timer wheel, at the tick
+     *         it's due, which is after the current one
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] terminus - the terminus
+     *  @param[in] index - the sensor
+     */
+    void schedule(uint8_t eid, const Terminus& terminus, size_t index);
+
+    /** @brief Send the polls due on a terminus, as many as it takes
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    void dispatch(uint8_t eid);
+
+    /** @brief Take the reading of a polled sensor, publish it if it changed
+     *         and schedule the next poll
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] terminus - the terminus
+     *  @param[in] index - the sensor
+     *  @param[in] response - the response message, nullptr on time out
+     *  @param[in] respMsgLen - length of the response payload
+     */
+    void receive(uint8_t eid, Terminus& terminus, size_t index,
+                 const pldm_msg* response, size_t respMsgLen);
+
+    /** @brief Sends the requests */
+    SendRequest send;
+
+    /** @brief Takes the readings that changed */
+    Publish publish;
+
+    /** @brief Shortest polling interval, in ticks */
+    size_t minTicks;
+
+    /** @brief Longest polling interval, in ticks */
+    size_t maxTicks;
+
+    /** @brief Number of requests in flight per terminus */
+    size_t outstanding;
+
+    /** @brief Termini whose sensors are polled */
+    std::map<uint8_t, Terminus> termini;
+
+    /** @brief The timer wheel */
+    std::vector<std::vector<Slotted>> wheel;
+
+    /** @brief Number of ticks so far */
+    uint64_t now = 0;
+
+    /** @brief Number of times sensors were tracked, tells the polls of
+     *         replaced sensors apart
+     */
+    uint32_t generation = 0;
+
+    /** @brief Advances the wheel, enabled while there are sensors to poll */
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        timer;
+};
+
+} // namespace requester
+} // namespace pldm
@@ -0,0 +1,236 @@
+#include "terminus.hpp"
+
+#include <iostream>
+
+namespace pldm
+{
+
+namespace requester
+{
+
+namespace
+{
+
+/** @brief Get the completion code of a response
+ *
+ *  @param[in] response - the response message
+ *  @param[in] respMsgLen - length of the response payload
+ *
+ *  @return uint8_t - the completion code, PLDM_ERROR_INVALID_LENGTH if the
+ *          response has none
+ */
+uint8_t completionCode(const pldm_msg* response, size_t respMsgLen)
+{
+    return respMsgLen ? response->payload[0]
+                      : static_cast<uint8_t>(PLDM_ERROR_INVALID_LENGTH);
+}
+
+} // namespace
+
+bool Capabilities::supports(uint8_t type, uint8_t command) const
+{
+    auto found = commands.find(type);
+    return found != commands.end() && found->second.test(command);
+}
+
+void Discovery::discover(const std::vector<uint8_t>& eids)
+{
+    for (auto eid : eids)
+    {
+        if (cache.count(eid) || probes.count(eid))
+        {
+            continue;
+        }
+
+        auto& probe = probes[eid] = {++generation, 0, false, {}};
+        request(
+            eid, probe, PLDM_GET_TID, 0,
+            [](uint8_t instanceId, pldm_msg* msg) {
+                return encode_get_tid_req(instanceId, msg);
+            },
+            [](Probe& probe, const pldm_msg* response, size_t respMsgLen) {
+                uint8_t cc = 0;
+                uint8_t tid = 0;
+                // A terminus without GetTID is still usable, its tid stays 0
+                if (completionCode(response, respMsgLen) == PLDM_SUCCESS &&
+                    decode_get_tid_resp(response, respMsgLen, &cc, &tid) ==
+                        PLDM_SUCCESS)
+                {
+                    probe.capabilities.tid = tid;
+                }
+            });
+        request(
+            eid, probe, PLDM_GET_PLDM_TYPES, 0,
+            [](uint8_t instanceId, pldm_msg* msg) {
+                return encode_get_types_req(instanceId, msg);
+            },
+            [this, eid](Probe& probe, const pldm_msg* response,
+                        size_t respMsgLen) {
+                uint8_t cc = 0;
+                bitfield8_t types[PLDM_MAX_TYPES / 8]{};
+                if (completionCode(response, respMsgLen) != PLDM_SUCCESS ||
+                    decode_get_types_resp(response, respMsgLen, &cc, types) !=
+                        PLDM_SUCCESS)
+                {
+                    probe.failed = true;
+                    return;
+                }
+
+                for (uint8_t type = 0; type < PLDM_MAX_TYPES; ++type)
+                {
+                    if (!(types[type / 8].byte & (1 << (type % 8))))
+                    {
+                        continue;
+                    }
+                    probe.capabilities.types.set(type);
+                    request(
+                        eid, probe, PLDM_GET_PLDM_VERSION,
+                        PLDM_GET_VERSION_REQ_BYTES,
+                        [type](uint8_t instanceId, pldm_msg* msg) {
+                            return encode_get_version_req(
+                                instanceId, 0, PLDM_GET_FIRSTPART, type, msg);
+                        },
+                        [this, eid, type](Probe& probe,
+                                          const pldm_msg* response,
+                                          size_t respMsgLen) {
+                            uint8_t cc = 0;
+                            uint32_t nextHandle = 0;
+                            uint8_t flag = 0;
+                            ver32_t version{};
+                            if (completionCode(response, respMsgLen) !=
+                                    PLDM_SUCCESS ||
+                                decode_get_version_resp(
+                                    response, respMsgLen, &cc, &nextHandle,
+                                    &flag, &version) != PLDM_SUCCESS)
+                            {
+                                probe.failed = true;
+                                return;
+                            }
+                            probe.capabilities.versions[type] = version;
+                            requestCommands(eid, probe, type, version);
+                        });
+                }
+            });
+        if (!probe.outstanding)
+        {
+            finish(eid);
+        }
+    }
+}
+
+void Discovery::requestCommands(uint8_t eid, Probe& probe, uint8_t type,
+                                ver32_t version)
+{
+    request(
+        eid, probe, PLDM_GET_PLDM_COMMANDS, PLDM_GET_COMMANDS_REQ_BYTES,
+        [type, version](uint8_t instanceId, pldm_msg* msg) {
+            return encode_get_commands_req(instanceId, type, version, msg);
+        },
+        [type](Probe& probe, const pldm_msg* response, size_t respMsgLen) {
+            uint8_t cc = 0;
+            bitfield8_t commands[PLDM_MAX_CMDS_PER_TYPE / 8]{};
+            if (completionCode(response, respMsgLen) != PLDM_SUCCESS ||
+                decode_get_commands_resp(response, respMsgLen, &cc,
+                                         commands) != PLDM_SUCCESS)
+            {
+                probe.failed = true;
+                return;
+            }
+
+            auto& supported = probe.capabilities.commands[type];
+            for (size_t command = 0; command < PLDM_MAX_CMDS_PER_TYPE;
+                 ++command)
+            {
+                supported[command] =
+                    commands[command / 8].byte & (1 << (command % 8));
+            }
+        });
+}
+
+void Discovery::request(uint8_t eid, Probe& probe, uint8_t command,
+                        size_t payloadLength, const Encoder& encode,
+                        ProbeHandler handler)
+{
+    ++probe.outstanding;
+    auto rc = send(
+        eid, PLDM_BASE, command, payloadLength, encode,
+        [this, generation = probe.generation, handler = std::move(handler)](
+            uint8_t eid, const pldm_msg* response, size_t respMsgLen) {
+            auto found = probes.find(eid);
+            if (found == probes.end() ||
+                found->second.generation != generation)
+            {
+                return;
+            }
+
+            auto& probe = found->second;
+            if (response)
+            {
+                handler(probe, response, respMsgLen);
+            }
+            else
+            {
+                probe.failed = true;
+            }
+            if (!--probe.outstanding)
+            {
+                finish(eid);
+            }
+        });
+    if (rc != PLDM_SUCCESS)
+    {
+        --probe.outstanding;
+        probe.failed = true;
+    }
+}
+
+void Discovery::finish(uint8_t eid)
+{
+    auto probe = probes.find(eid);
+    if (probe->second.failed)
+    {
+        std::cerr << "Failed to discover terminus, EID="
+                  << static_cast<unsigned>(eid) << "\n";
+        probes.erase(probe);
+        return;
+    }
+
+    auto capabilities = std::make_shared<const Capabilities>(
+        std::move(probe->second.capabilities));
+    probes.erase(probe);
+    cache[eid] = capabilities;
+    notify(eid, capabilities);
+}
+
+void Discovery::invalidate(uint8_t eid)
+{
+    probes.erase(eid);
+    if (cache.erase(eid))
+    {
+        notify(eid, nullptr);
+    }
+}
+
+std::shared_ptr<const Capabilities> Discovery::get(uint8_t eid) const
+{
+    auto found = cache.find(eid);
+    return found == cache.end() ? nullptr : found->second;
+}
+
+bool Discovery::supports(uint8_t eid, uint8_t type, uint8_t command) const
+{
+    auto capabilities = get(eid);
+    return capabilities && capabilities->supports(type, command);
+}
+
+void Discovery::notify(uint8_t eid,
+                       const std::shared_ptr<const Capabilities>& capabilities)
+{
+    for (const auto& listener : listeners)
+    {
+        listener(eid, capabilities);
+    }
+}
+
+} // namespace requester
+} // namespace pldm
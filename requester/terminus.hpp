@@ -0,0 +1,217 @@
+#pragma once
+
+#include "handler.hpp"
+
+#include <stdint.h>
+
+#include <bitset>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "libpldm/base.h"
+
+namespace pldm
+{
+
+namespace requester
+{
+
+/** @brief Sends a request, Handler::sendRequest bound to a handler
+ *
+ *  @param[in] eid - MCTP endpoint
+ *  @param[in] type - PLDM type of the request
+ *  @param[in] command - PLDM command of the request
+ *  @param[in] payloadLength - length of the request payload
+ *  @param[in] encode - encodes the request
+ *  @param[in] handler - called with the response
+ *
+ *  @return PLDM_SUCCESS if the request was sent
+ */
+using SendRequest = std::function<int(
+    uint8_t eid, uint8_t type, uint8_t command, size_t payloadLength,
+    const Encoder& encode, ResponseHandler handler)>;
+
+/** @struct Capabilities
+ *
+ *  @brief What a terminus supports, as reported by GetTID, GetPLDMTypes,
+ *         GetPLDMVersion and GetPLDMCommands
+ */
+struct Capabilities
+{
+    /** @brief Terminus id, 0 if the terminus doesn't support GetTID */
+    uint8_t tid = 0;
+
+    /** @brief Supported PLDM types */
+    std::bitset<PLDM_MAX_TYPES> types;
+
+    /** @brief Version of each supported type */
+    std::map<uint8_t, ver32_t> versions;
+
+    /** @brief Supported commands of each supported type */
+    std::map<uint8_t, std::bitset<PLDM_MAX_CMDS_PER_TYPE>> commands;
+
+    /** @brief Check if the terminus supports a command
+     *
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     *
+     *  @return bool - true if the command is supported
+     */
+    bool supports(uint8_t type, uint8_t command) const;
+};
+
+/** @class Discovery
+ *
+ *  @brief Discovers the capabilities of remote termini and caches them per
+ *         MCTP endpoint. All the endpoints are probed at once, and each
+ *         probe sends every request it can without waiting on the others:
+ *         GetTID and GetPLDMTypes together, then GetPLDMVersion for each
+ *         type, then GetPLDMCommands for each type as its version arrives.
+ *
+ *  Other subsystems read the cache instead of probing the termini again. A
+ *  terminus stays cached until it is invalidated, which is to be done when
+ *  its endpoint is reset or goes away.
+ */
+class Discovery
+{
+  public:
+    /** @brief Called when the cached capabilities of a terminus change
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] capabilities - the discovered capabilities, nullptr when
+     *                            the terminus was invalidated
+     */
+    using Listener = std::function<void(
+        uint8_t eid, std::shared_ptr<const Capabilities> capabilities)>;
+
+    /** @brief Constructor
+     *
+     *  @param[in] send - sends the discovery requests
+     */
+    explicit Discovery(SendRequest send) : send(std::move(send))
+    {
+    }
+
+    /** @brief Probe endpoints that aren't cached or being probed already
+     *
+     *  @param[in] eids - MCTP endpoints
+     */
+    void discover(const std::vector<uint8_t>& eids);
+
+    /** @brief Drop what's known about a terminus, and stop probing it. Its
+     *         late responses are ignored.
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    void invalidate(uint8_t eid);
+
+    /** @brief Get the capabilities of a terminus
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *
+     *  @return std::shared_ptr<const Capabilities> - the capabilities, or
+     *          nullptr if the terminus isn't discovered yet
+     */
+    std::shared_ptr<const Capabilities> get(uint8_t eid) const;
+
+    /** @brief Check if a discovered terminus supports a command
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     *
+     *  @return bool - true if the command is supported, false if not or if
+     *          the terminus isn't discovered yet
+     */
+    bool supports(uint8_t eid, uint8_t type, uint8_t command) const;
+
+    /** @brief Get notified of discovered and invalidated termini
+     *
+     *  @param[in] listener - called on every change to the cache
+     */
+    void subscribe(Listener listener)
+    {
+        listeners.push_back(std::move(listener));
+    }
+
+  private:
+    /** @struct Probe
+     *
+     *  @brief A terminus being discovered
+     */
+    struct Probe
+    {
+        uint32_t generation;
+        size_t outstanding;
+        bool failed;
+        Capabilities capabilities;
+    };
+
+    /** @brief Handles a response of a probe
+     *
+     *  @param[in] probe - the probe
+     *  @param[in] response - the response message
+     *  @param[in] respMsgLen - length of the response payload
+     */
+    using ProbeHandler = std::function<void(
+        Probe& probe, const pldm_msg* response, size_t respMsgLen)>;
+
+    /** @brief Send a request of a probe
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] probe - the probe
+     *  @param[in] command - PLDM base command
+     *  @param[in] payloadLength - length of the request payload
+     *  @param[in] encode - encodes the request
+     *  @param[in] handler - handles the response
+     */
+    void request(uint8_t eid, Probe& probe, uint8_t command,
+                 size_t payloadLength, const Encoder& encode,
+                 ProbeHandler handler);
+
+    /** @brief Send the GetPLDMCommands request of a type
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] probe - the probe
+     *  @param[in] type - PLDM type
+     *  @param[in] version - version of the type reported by the terminus
+     */
+    void requestCommands(uint8_t eid, Probe& probe, uint8_t type,
+                         ver32_t version);
+
+    /** @brief Cache the result of a probe that got all its responses
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    void finish(uint8_t eid);
+
+    /** @brief Notify the listeners of a change
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] capabilities - the new capabilities, nullptr if dropped
+     */
+    void notify(uint8_t eid,
+                const std::shared_ptr<const Capabilities>& capabilities);
+
+    /** @brief Sends the requests */
+    SendRequest send;
+
+    /** @brief Discovered termini */
+    std::map<uint8_t, std::shared_ptr<const Capabilities>> cache;
+
+    /** @brief Termini being discovered */
+    std::map<uint8_t, Probe> probes;
+
+    /** @brief Number of probes started, tells responses to an abandoned
+     *         probe from the probe that replaced it
+     */
+    uint32_t generation = 0;
+
+    /** @brief Notified of changes to the cache */
+    std::vector<Listener> listeners;
+};
+
+} // namespace requester
+} // namespace pldm
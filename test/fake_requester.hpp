@@ -0,0 +1,147 @@
+#pragma once
+
+#include "requester/handler.hpp"
+#include "requester/terminus.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "libpldm/base.h"
+
+namespace pldm
+{
+
+namespace test
+{
+
+/** @struct Sent
+ *
+ *  @brief A request sent, and the handler its response goes to
+ */
+struct Sent
+{
+    uint8_t eid;
+    std::vector<uint8_t> msg;
+    requester::ResponseHandler handler;
+};
+
+/** @class FakeRequester
+ *
+ *  @brief Keeps the requests sent to remote termini, in place of MCTP, and
+ *         answers them when the test asks for it
+ */
+class FakeRequester
+{
+  public:
+    /** @brief Builds the response of a terminus to a request
+     *
+     *  @param[in] eid - MCTP endpoint the request was sent to
+     *  @param[in] msg - the request message, header included
+     *
+     *  @return std::vector<uint8_t> - the response message, header included
+     */
+    using Respond = std::function<std::vector<uint8_t>(
+        uint8_t eid, const std::vector<uint8_t>& msg)>;
+
+    /** @brief Constructor
+     *
+     *  @param[in] respond - answers the requests
+     */
+    explicit FakeRequester(Respond respond) : respond(std::move(respond))
+    {
+    }
+
+    /** @brief Send requests as a requester would, each to its own handler
+     *
+     *  @return requester::SendRequest - keeps the requests it is called with
+     */
+    requester::SendRequest sender()
+    {
+        return [this](uint8_t eid, uint8_t, uint8_t, size_t payloadLength,
+                      const requester::Encoder& encode,
+                      requester::ResponseHandler handler) {
+            std::vector<uint8_t> msg(sizeof(pldm_msg_hdr) + payloadLength);
+            auto rc = encode(0, reinterpret_cast<pldm_msg*>(msg.data()));
+            if (rc != PLDM_SUCCESS)
+            {
+                return rc;
+            }
+            keep(eid, std::move(msg), std::move(handler));
+            return static_cast<int>(PLDM_SUCCESS);
+        };
+    }
+
+    /** @brief Send messages as MCTP would, for a requester::Handler
+     *
+     *  @param[in] deliver - where the responses go, the handler's
+     *                       handleResponse
+     *
+     *  @return requester::Transport - keeps the messages it is called with
+     */
+    requester::Transport transport(requester::ResponseHandler deliver)
+    {
+        return [this, deliver = std::move(deliver)](
+                   uint8_t eid, const std::vector<uint8_t>& msg) {
+            keep(eid, msg, deliver);
+            return 0;
+        };
+    }
+
+    /** @brief Answer the requests sent so far
+     *
+     *  @return size_t - number of requests answered
+     */
+    size_t answer()
+    {
+        std::deque<Sent> round;
+        round.swap(sent);
+        for (auto& request : round)
+        {
+            auto response = respond(request.eid, request.msg);
+            --inFlight[request.eid];
+            request.handler(request.eid,
+                            reinterpret_cast<pldm_msg*>(response.data()),
+                            response.size() - sizeof(pldm_msg_hdr));
+        }
+        return round.size();
+    }
+
+    /** @brief Answer requests until none are left
+     *
+     *  @return size_t - number of rounds of requests answered
+     */
+    size_t answerAll()
+    {
+        size_t rounds = 0;
+        while (answer())
+        {
+            ++rounds;
+        }
+        return rounds;
+    }
+
+    /** @brief Requests sent and not answered yet */
+    std::deque<Sent> sent;
+
+    /** @brief Requests in flight, and the most ever in flight, by endpoint */
+    std::map<uint8_t, size_t> inFlight;
+    std::map<uint8_t, size_t> mostInFlight;
+
+  private:
+    void keep(uint8_t eid, std::vector<uint8_t> msg,
+              requester::ResponseHandler handler)
+    {
+        sent.push_back({eid, std::move(msg), std::move(handler)});
+        ++inFlight[eid];
+        mostInFlight[eid] = std::max(mostInFlight[eid], inFlight[eid]);
+    }
+
+    Respond respond;
+};
+
+} // namespace test
+
+} // namespace pldm
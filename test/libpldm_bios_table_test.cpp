@@ -169,6 +169,8 @@ TEST(AttrTable, StringEntryDecodeTest)
     uint16_t def_string_length =
         pldm_bios_table_attr_entry_string_decode_def_string_length(entry);
     EXPECT_EQ(def_string_length, 3);
+    EXPECT_EQ(pldm_bios_table_attr_entry_string_decode_min_length(entry), 1);
+    EXPECT_EQ(pldm_bios_table_attr_entry_string_decode_max_length(entry), 100);
 
     def_string_length = 0;
     auto rc = pldm_bios_table_attr_entry_string_decode_def_string_length_check(
@@ -312,6 +314,17 @@ TEST(AttrTable, integerEntryEncodeTest)
 
     EXPECT_EQ(integerEntry, encodeEntry);
 
+    uint64_t lower, upper, def;
+    uint32_t scalar;
+    pldm_bios_table_attr_entry_integer_decode(
+        reinterpret_cast<struct pldm_bios_attr_table_entry*>(
+            integerEntry.data()),
+        &lower, &upper, &scalar, &def);
+    EXPECT_EQ(lower, 1);
+    EXPECT_EQ(upper, 10);
+    EXPECT_EQ(scalar, 2);
+    EXPECT_EQ(def, 3);
+
     EXPECT_DEATH(pldm_bios_table_attr_entry_integer_encode(
                      encodeEntry.data(), encodeEntry.size() - 1, &info),
                  "length <= entry_length");
@@ -460,6 +473,15 @@ TEST(AttrValTable, EnumEntryDecodeTest)
         enumEntry.data());
     auto number = pldm_bios_table_attr_value_entry_enum_decode_number(entry);
     EXPECT_EQ(2, number);
+
+    std::vector<uint8_t> handles(3, 0xff);
+    number = pldm_bios_table_attr_value_entry_enum_decode_handles(
+        entry, handles.data(), handles.size());
+    EXPECT_EQ(2, number);
+    EXPECT_EQ(handles, std::vector<uint8_t>({0, 1, 0xff}));
+    number = pldm_bios_table_attr_value_entry_enum_decode_handles(
+        entry, handles.data(), 1);
+    EXPECT_EQ(1, number);
 }
 
 TEST(AttrValTable, stringEntryEncodeTest)
@@ -542,6 +564,10 @@ TEST(AttrValTable, integerEntryEncodeTest)
     pldm_bios_table_attr_value_entry_encode_integer(
         encodeEntry.data(), encodeEntry.size(), 0, PLDM_BIOS_INTEGER, 10);
     EXPECT_EQ(encodeEntry, integerEntry);
+    EXPECT_EQ(pldm_bios_table_attr_value_entry_integer_decode_cv(
+                  reinterpret_cast<struct pldm_bios_attr_val_table_entry*>(
+                      encodeEntry.data())),
+              10);
 
     EXPECT_DEATH(pldm_bios_table_attr_value_entry_encode_integer(
                      encodeEntry.data(), encodeEntry.size() - 1, 0,
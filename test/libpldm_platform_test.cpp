@@ -1,3 +1,4 @@
+#include <endian.h>
 #include <string.h>
 
 #include <array>
@@ -384,3 +385,493 @@ TEST(GetPDR, testBadDecodeResponse)
         &retRespCnt, retRecordData, recordDataLength, &retTransferCRC);
     EXPECT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
 }
+
+TEST(GetPDRRepositoryInfo, testGoodEncodeResponse)
+{
+    std::array<uint8_t, hdrSize + PLDM_GET_PDR_REPOSITORY_INFO_RESP_BYTES>
+        responseMsg{};
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime{1, 2, 3};
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> oemUpdateTime{4, 5, 6};
+
+    auto rc = encode_get_pdr_repository_info_resp(
+        0, PLDM_SUCCESS, PLDM_PDR_REPOSITORY_AVAILABLE, updateTime.data(),
+        oemUpdateTime.data(), 10, 500, 60, 1, response);
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    auto resp = reinterpret_cast<struct pldm_get_pdr_repository_info_resp*>(
+        response->payload);
+    EXPECT_EQ(resp->completion_code, PLDM_SUCCESS);
+    EXPECT_EQ(resp->repository_state, PLDM_PDR_REPOSITORY_AVAILABLE);
+    EXPECT_EQ(0, memcmp(resp->update_time, updateTime.data(),
+                        PLDM_TIMESTAMP104_SIZE));
+    EXPECT_EQ(0, memcmp(resp->oem_update_time, oemUpdateTime.data(),
+                        PLDM_TIMESTAMP104_SIZE));
+    EXPECT_EQ(le32toh(resp->record_count), 10);
+    EXPECT_EQ(le32toh(resp->repository_size), 500);
+    EXPECT_EQ(le32toh(resp->largest_record_size), 60);
+    EXPECT_EQ(resp->data_transfer_handle_timeout, 1);
+
+    rc = encode_get_pdr_repository_info_resp(
+        0, PLDM_SUCCESS, PLDM_PDR_REPOSITORY_AVAILABLE, NULL,
+        oemUpdateTime.data(), 10, 500, 60, 1, response);
+    EXPECT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+}
+
+TEST(GetPDRRepositoryInfo, testGoodDecodeResponse)
+{
+    std::array<uint8_t, hdrSize + PLDM_GET_PDR_REPOSITORY_INFO_RESP_BYTES>
+        responseMsg{};
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime{1, 2, 3};
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> oemUpdateTime{4, 5, 6};
+    encode_get_pdr_repository_info_resp(
+        0, PLDM_SUCCESS, PLDM_PDR_REPOSITORY_UPDATE_IN_PROGRESS,
+        updateTime.data(), oemUpdateTime.data(), 10, 500, 60, 1, response);
+
+    uint8_t retCompletionCode = 0;
+    uint8_t retState = 0;
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> retUpdateTime{};
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> retOemUpdateTime{};
+    uint32_t retRecordCount = 0;
+    uint32_t retRepositorySize = 0;
+    uint32_t retLargestRecordSize = 0;
+    uint8_t retTimeout = 0;
+
+    auto rc = decode_get_pdr_repository_info_resp(
+        response, responseMsg.size() - hdrSize, &retCompletionCode, &retState,
+        retUpdateTime.data(), retOemUpdateTime.data(), &retRecordCount,
+        &retRepositorySize, &retLargestRecordSize, &retTimeout);
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    EXPECT_EQ(retCompletionCode, PLDM_SUCCESS);
+    EXPECT_EQ(retState, PLDM_PDR_REPOSITORY_UPDATE_IN_PROGRESS);
+    EXPECT_EQ(retUpdateTime, updateTime);
+    EXPECT_EQ(retOemUpdateTime, oemUpdateTime);
+    EXPECT_EQ(retRecordCount, 10);
+    EXPECT_EQ(retRepositorySize, 500);
+    EXPECT_EQ(retLargestRecordSize, 60);
+    EXPECT_EQ(retTimeout, 1);
+}
+
+TEST(GetPDRRepositoryInfo, testBadDecodeResponse)
+{
+    std::array<uint8_t, hdrSize + PLDM_GET_PDR_REPOSITORY_INFO_RESP_BYTES>
+        responseMsg{};
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+
+    uint8_t retCompletionCode = 0;
+    uint8_t retState = 0;
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> retUpdateTime{};
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> retOemUpdateTime{};
+    uint32_t retRecordCount = 0;
+    uint32_t retRepositorySize = 0;
+    uint32_t retLargestRecordSize = 0;
+    uint8_t retTimeout = 0;
+
+    auto rc = decode_get_pdr_repository_info_resp(
+        response, responseMsg.size() - hdrSize, NULL, &retState,
+        retUpdateTime.data(), retOemUpdateTime.data(), &retRecordCount,
+        &retRepositorySize, &retLargestRecordSize, &retTimeout);
+    EXPECT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+
+    rc = decode_get_pdr_repository_info_resp(
+        response, responseMsg.size() - hdrSize - 1, &retCompletionCode,
+        &retState, retUpdateTime.data(), retOemUpdateTime.data(),
+        &retRecordCount, &retRepositorySize, &retLargestRecordSize,
+        &retTimeout);
+    EXPECT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+}
+
+TEST(GetStateSensorReadings, testGoodEncodeResponse)
+{
+    std::array<uint8_t, hdrSize +
+                            PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
+                            sizeof(get_sensor_state_field)>
+        responseMsg{};
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+    std::array<get_sensor_state_field, 2> stateField{};
+    stateField[0] = {PLDM_SENSOR_ENABLED, 1, 2, 1};
+    stateField[1] = {PLDM_SENSOR_UNAVAILABLE, 0, 0, 0};
+
+    auto rc = encode_get_state_sensor_readings_resp(
+        0, PLDM_SUCCESS, 2, stateField.data(), response);
+
+    auto resp = reinterpret_cast<pldm_get_state_sensor_readings_resp*>(
+        response->payload);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(resp->completion_code, PLDM_SUCCESS);
+    ASSERT_EQ(resp->comp_sensor_count, 2);
+    ASSERT_EQ(resp->field[0].sensor_op_state, PLDM_SENSOR_ENABLED);
+    ASSERT_EQ(resp->field[0].present_state, 1);
+    ASSERT_EQ(resp->field[0].previous_state, 2);
+    ASSERT_EQ(resp->field[1].sensor_op_state, PLDM_SENSOR_UNAVAILABLE);
+}
+
+TEST(GetStateSensorReadings, testBadEncodeResponse)
+{
+    std::array<uint8_t, hdrSize +
+                            PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES>
+        responseMsg{};
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+    get_sensor_state_field stateField{};
+
+    auto rc = encode_get_state_sensor_readings_resp(0, PLDM_SUCCESS, 1,
+                                                    &stateField, nullptr);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+
+    rc = encode_get_state_sensor_readings_resp(0, PLDM_SUCCESS, 9, &stateField,
+                                               response);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+}
+
+TEST(GetStateSensorReadings, testGoodDecodeRequest)
+{
+    std::array<uint8_t, hdrSize + PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    bitfield8_t sensorRearm{};
+    sensorRearm.byte = 0x03;
+
+    auto rc = encode_get_state_sensor_readings_req(0, 0xAB12, sensorRearm, 0,
+                                                   request);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+
+    uint16_t sensorId{};
+    bitfield8_t retRearm{};
+    uint8_t reserved = 0xFF;
+    rc = decode_get_state_sensor_readings_req(
+        request, requestMsg.size() - hdrSize, &sensorId, &retRearm, &reserved);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(sensorId, 0xAB12);
+    ASSERT_EQ(retRearm.byte, sensorRearm.byte);
+    ASSERT_EQ(reserved, 0);
+}
+
+TEST(GetStateSensorReadings, testBadDecodeRequest)
+{
+    std::array<uint8_t, hdrSize + PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    uint16_t sensorId{};
+    bitfield8_t sensorRearm{};
+    uint8_t reserved{};
+
+    auto rc = decode_get_state_sensor_readings_req(
+        nullptr, requestMsg.size() - hdrSize, &sensorId, &sensorRearm,
+        &reserved);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+
+    rc = decode_get_state_sensor_readings_req(
+        request, requestMsg.size() - hdrSize - 1, &sensorId, &sensorRearm,
+        &reserved);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+}
+
+TEST(GetStateSensorReadings, testGoodDecodeResponse)
+{
+    std::array<uint8_t, hdrSize +
+                            PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
+                            sizeof(get_sensor_state_field)>
+        responseMsg{};
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+    std::array<get_sensor_state_field, 2> stateField{};
+    stateField[0] = {PLDM_SENSOR_ENABLED, 1, 2, 1};
+    stateField[1] = {PLDM_SENSOR_ENABLED, 3, 3, 3};
+    auto rc = encode_get_state_sensor_readings_resp(
+        0, PLDM_SUCCESS, 2, stateField.data(), response);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+
+    uint8_t completionCode = 0xFF;
+    uint8_t compSensorCount = 8;
+    std::array<get_sensor_state_field, 8> retField{};
+    rc = decode_get_state_sensor_readings_resp(
+        response, responseMsg.size() - hdrSize, &completionCode,
+        &compSensorCount, retField.data());
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(completionCode, PLDM_SUCCESS);
+    ASSERT_EQ(compSensorCount, 2);
+    ASSERT_EQ(retField[0].present_state, 1);
+    ASSERT_EQ(retField[0].previous_state, 2);
+    ASSERT_EQ(retField[1].present_state, 3);
+}
+
+TEST(GetStateSensorReadings, testBadDecodeResponse)
+{
+    std::array<uint8_t, hdrSize +
+                            PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
+                            sizeof(get_sensor_state_field)>
+        responseMsg{};
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+    std::array<get_sensor_state_field, 2> stateField{};
+    auto rc = encode_get_state_sensor_readings_resp(
+        0, PLDM_SUCCESS, 2, stateField.data(), response);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+
+    uint8_t completionCode{};
+    uint8_t compSensorCount = 1;
+    get_sensor_state_field retField[1]{};
+    // Not enough room for the fields
+    rc = decode_get_state_sensor_readings_resp(
+        response, responseMsg.size() - hdrSize, &completionCode,
+        &compSensorCount, retField);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+
+    compSensorCount = 2;
+    rc = decode_get_state_sensor_readings_resp(
+        response, responseMsg.size() - hdrSize - 1, &completionCode,
+        &compSensorCount, retField);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+}
+
+TEST(GetSensorReading, testGoodEncodeDecodeRequest)
+{
+    std::array<uint8_t, hdrSize + PLDM_GET_SENSOR_READING_REQ_BYTES>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+    auto rc = encode_get_sensor_reading_req(0, 0x1234, true, request);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(request->hdr.command, PLDM_GET_SENSOR_READING);
+
+    uint16_t sensorId{};
+    bool8_t rearm{};
+    rc = decode_get_sensor_reading_req(request, requestMsg.size() - hdrSize,
+                                       &sensorId, &rearm);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(sensorId, 0x1234);
+    ASSERT_EQ(rearm, true);
+
+    rc = decode_get_sensor_reading_req(
+        request, requestMsg.size() - hdrSize - 1, &sensorId, &rearm);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+    rc = decode_get_sensor_reading_req(nullptr, requestMsg.size() - hdrSize,
+                                       &sensorId, &rearm);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+}
+
+TEST(GetSensorReading, testGoodEncodeDecodeResponse)
+{
+    constexpr size_t payloadLength =
+        PLDM_GET_SENSOR_READING_MIN_RESP_BYTES - 1 + sizeof(int32_t);
+    std::array<uint8_t, hdrSize + payloadLength> responseMsg{};
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+    int32_t reading = htole32(-40000);
+
+    auto rc = encode_get_sensor_reading_resp(
+        0, PLDM_SUCCESS, PLDM_SENSOR_DATA_SIZE_SINT32, PLDM_SENSOR_ENABLED,
+        PLDM_NO_EVENT_GENERATION, PLDM_SENSOR_NORMAL, PLDM_SENSOR_UNKNOWN,
+        PLDM_SENSOR_NORMAL, reinterpret_cast<uint8_t*>(&reading), response,
+        payloadLength);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+
+    uint8_t completionCode = 0xFF;
+    uint8_t dataSize{};
+    uint8_t opState{};
+    uint8_t eventEnable{};
+    uint8_t presentState{};
+    uint8_t previousState{};
+    uint8_t eventState{};
+    int32_t retReading{};
+    rc = decode_get_sensor_reading_resp(
+        response, payloadLength, &completionCode, &dataSize, &opState,
+        &eventEnable, &presentState, &previousState, &eventState,
+        reinterpret_cast<uint8_t*>(&retReading));
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(completionCode, PLDM_SUCCESS);
+    ASSERT_EQ(dataSize, PLDM_SENSOR_DATA_SIZE_SINT32);
+    ASSERT_EQ(opState, PLDM_SENSOR_ENABLED);
+    ASSERT_EQ(presentState, PLDM_SENSOR_NORMAL);
+    ASSERT_EQ(previousState, PLDM_SENSOR_UNKNOWN);
+    ASSERT_EQ(static_cast<int32_t>(le32toh(retReading)), -40000);
+}
+
+TEST(GetSensorReading, testBadEncodeDecodeResponse)
+{
+    constexpr size_t payloadLength = PLDM_GET_SENSOR_READING_MIN_RESP_BYTES;
+    std::array<uint8_t, hdrSize + payloadLength> responseMsg{};
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+    uint8_t reading = 42;
+
+    // Data size doesn't match the payload length
+    auto rc = encode_get_sensor_reading_resp(
+        0, PLDM_SUCCESS, PLDM_SENSOR_DATA_SIZE_UINT16, PLDM_SENSOR_ENABLED,
+        PLDM_NO_EVENT_GENERATION, PLDM_SENSOR_NORMAL, PLDM_SENSOR_NORMAL,
+        PLDM_SENSOR_NORMAL, &reading, response, payloadLength);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+
+    rc = encode_get_sensor_reading_resp(
+        0, PLDM_SUCCESS, PLDM_SENSOR_DATA_SIZE_SINT32 + 1, PLDM_SENSOR_ENABLED,
+        PLDM_NO_EVENT_GENERATION, PLDM_SENSOR_NORMAL, PLDM_SENSOR_NORMAL,
+        PLDM_SENSOR_NORMAL, &reading, response, payloadLength);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+
+    rc = encode_get_sensor_reading_resp(
+        0, PLDM_SUCCESS, PLDM_SENSOR_DATA_SIZE_UINT8, PLDM_SENSOR_ENABLED,
+        PLDM_NO_EVENT_GENERATION, PLDM_SENSOR_NORMAL, PLDM_SENSOR_NORMAL,
+        PLDM_SENSOR_NORMAL, &reading, response, payloadLength);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+
+    uint8_t completionCode{};
+    uint8_t dataSize{};
+    uint8_t opState{};
+    uint8_t eventEnable{};
+    uint8_t presentState{};
+    uint8_t previousState{};
+    uint8_t eventState{};
+    std::array<uint8_t, 4> retReading{};
+    rc = decode_get_sensor_reading_resp(
+        response, payloadLength + 1, &completionCode, &dataSize, &opState,
+        &eventEnable, &presentState, &previousState, &eventState,
+        retReading.data());
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+}
+
+TEST(PlatformEventMessage, testGoodEncodeDecodeRequest)
+{
+    std::array<uint8_t, PLDM_SENSOR_EVENT_DATA_MIN_LENGTH +
+                            PLDM_SENSOR_EVENT_STATE_SENSOR_STATE_DATA_LENGTH>
+        eventData{0x34, 0x12, PLDM_STATE_SENSOR_STATE, 1, 2, 3};
+    std::array<uint8_t, hdrSize + PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES +
+                            eventData.size()>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto payloadLength = requestMsg.size() - hdrSize;
+
+    auto rc = encode_platform_event_message_req(
+        0, 1, 0x10, PLDM_SENSOR_EVENT, eventData.data(), eventData.size(),
+        request, payloadLength);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+
+    uint8_t formatVersion{};
+    uint8_t tid{};
+    uint8_t eventClass = 0xFF;
+    size_t eventDataOffset{};
+    rc = decode_platform_event_message_req(request, payloadLength,
+                                           &formatVersion, &tid, &eventClass,
+                                           &eventDataOffset);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(formatVersion, 1);
+    ASSERT_EQ(tid, 0x10);
+    ASSERT_EQ(eventClass, PLDM_SENSOR_EVENT);
+
+    auto data = request->payload + eventDataOffset;
+    auto dataLength = payloadLength - eventDataOffset;
+    uint16_t sensorId{};
+    uint8_t sensorEventClass = 0xFF;
+    size_t classDataOffset{};
+    rc = decode_sensor_event_data(data, dataLength, &sensorId,
+                                  &sensorEventClass, &classDataOffset);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(sensorId, 0x1234);
+    ASSERT_EQ(sensorEventClass, PLDM_STATE_SENSOR_STATE);
+
+    uint8_t sensorOffset{};
+    uint8_t eventState{};
+    uint8_t previousEventState{};
+    rc = decode_state_sensor_data(data + classDataOffset,
+                                  dataLength - classDataOffset, &sensorOffset,
+                                  &eventState, &previousEventState);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(sensorOffset, 1);
+    ASSERT_EQ(eventState, 2);
+    ASSERT_EQ(previousEventState, 3);
+}
+
+TEST(PlatformEventMessage, testBadDecodeRequest)
+{
+    std::array<uint8_t, hdrSize + PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    uint8_t formatVersion{};
+    uint8_t tid{};
+    uint8_t eventClass{};
+    size_t eventDataOffset{};
+
+    // No event data
+    auto rc = decode_platform_event_message_req(
+        request, requestMsg.size() - hdrSize, &formatVersion, &tid,
+        &eventClass, &eventDataOffset);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+
+    rc = decode_platform_event_message_req(nullptr, 4, &formatVersion, &tid,
+                                           &eventClass, &eventDataOffset);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+
+    // State sensor class data of the wrong length
+    std::array<uint8_t, 5> eventData{0x01, 0x00, PLDM_STATE_SENSOR_STATE, 1,
+                                     2};
+    uint16_t sensorId{};
+    uint8_t sensorEventClass{};
+    size_t classDataOffset{};
+    rc = decode_sensor_event_data(eventData.data(), eventData.size(),
+                                  &sensorId, &sensorEventClass,
+                                  &classDataOffset);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+
+    eventData[2] = PLDM_NUMERIC_SENSOR_STATE + 1;
+    rc = decode_sensor_event_data(eventData.data(), eventData.size(),
+                                  &sensorId, &sensorEventClass,
+                                  &classDataOffset);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+}
+
+TEST(PlatformEventMessage, testDecodeNumericAndOpStateData)
+{
+    std::array<uint8_t, 5> numericData{PLDM_SENSOR_UPPERWARNING,
+                                       PLDM_SENSOR_NORMAL,
+                                       PLDM_SENSOR_DATA_SIZE_SINT16, 0x38,
+                                       0xFF};
+    uint8_t eventState{};
+    uint8_t previousEventState{};
+    uint8_t dataSize{};
+    uint32_t presentReading{};
+    auto rc = decode_numeric_sensor_data(numericData.data(),
+                                         numericData.size(), &eventState,
+                                         &previousEventState, &dataSize,
+                                         &presentReading);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(eventState, PLDM_SENSOR_UPPERWARNING);
+    ASSERT_EQ(previousEventState, PLDM_SENSOR_NORMAL);
+    ASSERT_EQ(dataSize, PLDM_SENSOR_DATA_SIZE_SINT16);
+    ASSERT_EQ(static_cast<int32_t>(presentReading), -200);
+
+    // The reading is shorter than the data size
+    numericData[2] = PLDM_SENSOR_DATA_SIZE_UINT32;
+    rc = decode_numeric_sensor_data(numericData.data(), numericData.size(),
+                                    &eventState, &previousEventState,
+                                    &dataSize, &presentReading);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_LENGTH);
+
+    std::array<uint8_t, 2> opData{PLDM_SENSOR_FAILED, PLDM_SENSOR_ENABLED};
+    uint8_t presentOpState{};
+    uint8_t previousOpState{};
+    rc = decode_sensor_op_data(opData.data(), opData.size(), &presentOpState,
+                               &previousOpState);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(presentOpState, PLDM_SENSOR_FAILED);
+    ASSERT_EQ(previousOpState, PLDM_SENSOR_ENABLED);
+}
+
+TEST(PlatformEventMessage, testEncodeDecodeResponse)
+{
+    std::array<uint8_t, hdrSize + PLDM_PLATFORM_EVENT_MESSAGE_RESP_BYTES>
+        responseMsg{};
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+
+    auto rc = encode_platform_event_message_resp(0, PLDM_SUCCESS,
+                                                 PLDM_EVENT_NO_LOGGING,
+                                                 response);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+
+    uint8_t completionCode = 0xFF;
+    uint8_t status = 0xFF;
+    rc = decode_platform_event_message_resp(
+        response, responseMsg.size() - hdrSize, &completionCode, &status);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(completionCode, PLDM_SUCCESS);
+    ASSERT_EQ(status, PLDM_EVENT_NO_LOGGING);
+
+    rc = encode_platform_event_message_resp(
+        0, PLDM_SUCCESS, PLDM_EVENT_LOGGING_REJECTED + 1, response);
+    ASSERT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+}
@@ -0,0 +1,149 @@
+#include "libpldmresponder/bios_image.hpp"
+
+#include <stdlib.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace bios_parser::image;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+/** @brief Get the enumeration values of an attribute which are strings */
+std::vector<std::string> strings(const Image& image, size_t first,
+                                 size_t count)
+{
+    std::vector<std::string> values;
+    for (size_t i = first; i < first + count; ++i)
+    {
+        values.emplace_back(image.string(unpack(image.value(i))));
+    }
+    return values;
+}
+
+} // namespace
+
+class TestBIOSImage : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pldm_bios_image.XXXXXX";
+        dir = fs::path(mkdtemp(tmpdir));
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    /** @brief Write an image to a file in the test directory */
+    std::string write(const std::vector<uint8_t>& bytes)
+    {
+        auto path = (dir / fileName).string();
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        return path;
+    }
+
+    fs::path dir;
+};
+
+TEST_F(TestBIOSImage, testCompile)
+{
+    auto image = Image::fromBytes(compile("./bios_jsons"));
+    ASSERT_TRUE(image);
+    EXPECT_EQ(image->header().attrCount, 10);
+    EXPECT_EQ(image->header().inputsHash, hashJsons("./bios_jsons"));
+    EXPECT_EQ(image->find("NoSuchAttribute"), nullptr);
+
+    auto attr = image->find("FWBootSide");
+    ASSERT_NE(attr, nullptr);
+    EXPECT_EQ(attr->kind, static_cast<uint8_t>(AttrKind::Enum));
+    EXPECT_FALSE(attr->readOnly);
+    EXPECT_EQ(image->string(attr->objectPath), "/xyz/abc/def");
+    EXPECT_EQ(image->string(attr->interface), "xyz.openbmc.FWBoot.Side");
+    EXPECT_EQ(image->string(attr->propertyName), "Side");
+    EXPECT_EQ(attr->propertyType, static_cast<uint8_t>(PropertyType::Bool));
+    EXPECT_EQ(strings(*image, attr->values, attr->pvCount),
+              std::vector<std::string>({"Perm", "Temp"}));
+    EXPECT_EQ(strings(*image, attr->values + 2, attr->dvCount),
+              std::vector<std::string>({"Perm"}));
+    EXPECT_EQ(image->value(attr->values + 3), 1);
+    EXPECT_EQ(image->value(attr->values + 4), 0);
+
+    // Mapped to D-Bus values, if not to a D-Bus property
+    attr = image->find("HMCManagedState");
+    ASSERT_NE(attr, nullptr);
+    EXPECT_FALSE(attr->readOnly);
+    EXPECT_EQ(attr->objectPath.length, 0);
+    EXPECT_EQ(strings(*image, attr->values + 3, attr->pvCount),
+              std::vector<std::string>({"xyz.openbmc_project.State.On",
+                                        "xyz.openbmc_project.State.Off"}));
+
+    attr = image->find("CodeUpdatePolicy");
+    ASSERT_NE(attr, nullptr);
+    EXPECT_TRUE(attr->readOnly);
+    EXPECT_EQ(attr->propertyType, static_cast<uint8_t>(PropertyType::Unknown));
+
+    attr = image->find("str_example2");
+    ASSERT_NE(attr, nullptr);
+    EXPECT_EQ(attr->kind, static_cast<uint8_t>(AttrKind::String));
+    EXPECT_EQ(attr->stringType, 0x02);
+    EXPECT_EQ(image->string(attr->defaultString).size(),
+              attr->defaultLength);
+
+    attr = image->find("VDD_AVSBUS_RAIL");
+    ASSERT_NE(attr, nullptr);
+    EXPECT_EQ(attr->kind, static_cast<uint8_t>(AttrKind::Integer));
+    EXPECT_EQ(attr->propertyType, static_cast<uint8_t>(PropertyType::Uint8));
+    EXPECT_EQ(attr->upperBound, 15);
+    EXPECT_EQ(attr->scalarIncrement, 1);
+}
+
+TEST_F(TestBIOSImage, testLoad)
+{
+    EXPECT_FALSE(Image::load((dir / fileName).c_str()));
+
+    auto bytes = compile("./bios_jsons");
+    auto image = Image::load(write(bytes).c_str());
+    ASSERT_TRUE(image);
+    EXPECT_EQ(image->header().inputsHash, hashJsons("./bios_jsons"));
+    auto attr = image->find("SBE_IMAGE_MINIMUM_VALID_ECS");
+    ASSERT_NE(attr, nullptr);
+    EXPECT_EQ(attr->defaultValue, 2);
+}
+
+TEST_F(TestBIOSImage, testUnusableImages)
+{
+    auto bytes = compile("./bios_jsons");
+
+    auto truncated = bytes;
+    truncated.pop_back();
+    EXPECT_FALSE(Image::fromBytes(truncated));
+    EXPECT_FALSE(Image::load(write(truncated).c_str()));
+
+    auto otherVersion = bytes;
+    reinterpret_cast<Header*>(otherVersion.data())->version++;
+    EXPECT_FALSE(Image::fromBytes(otherVersion));
+
+    auto otherByteOrder = bytes;
+    reinterpret_cast<Header*>(otherByteOrder.data())->byteOrder = 0x0201;
+    EXPECT_FALSE(Image::fromBytes(otherByteOrder));
+
+    // A record referring to a string out of the string arena
+    auto badString = bytes;
+    auto header = reinterpret_cast<Header*>(badString.data());
+    auto attr = reinterpret_cast<Attr*>(badString.data() + header->attrsOffset);
+    attr->name.length = header->stringsLength + 1;
+    EXPECT_FALSE(Image::fromBytes(badString));
+
+    EXPECT_FALSE(Image::fromBytes({}));
+}
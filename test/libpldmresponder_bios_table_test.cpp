@@ -3,12 +3,69 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
 #include <vector>
 
+#include "libpldm/bios_table.h"
+#include "libpldm/utils.h"
+
 #include <gtest/gtest.h>
 
 using namespace pldm::responder::bios;
 
+namespace
+{
+
+/** @brief Encode the value of an integer attribute */
+Table integerEntry(uint16_t handle, uint64_t value)
+{
+    Table entry(pldm_bios_table_attr_value_entry_encode_integer_length());
+    pldm_bios_table_attr_value_entry_encode_integer(
+        entry.data(), entry.size(), handle, PLDM_BIOS_INTEGER, value);
+    return entry;
+}
+
+/** @brief Encode the value of a string attribute */
+Table stringEntry(uint16_t handle, const std::string& value)
+{
+    Table entry(
+        pldm_bios_table_attr_value_entry_encode_string_length(value.size()));
+    pldm_bios_table_attr_value_entry_encode_string(
+        entry.data(), entry.size(), handle, PLDM_BIOS_STRING, value.size(),
+        value.c_str());
+    return entry;
+}
+
+/** @brief Get the value field of an encoded entry */
+Table valueOf(const Table& entry)
+{
+    auto valueOffset = offsetof(pldm_bios_attr_val_table_entry, value);
+    return Table(entry.begin() + valueOffset, entry.end());
+}
+
+/** @brief Build an attribute value table of the entries, padded and
+ *         checksummed
+ */
+Table valueTable(const std::vector<Table>& entries)
+{
+    Table table;
+    for (const auto& entry : entries)
+    {
+        table.insert(table.end(), entry.begin(), entry.end());
+    }
+    auto entriesLength = table.size();
+    table.resize(entriesLength +
+                 pldm_bios_table_pad_checksum_size(entriesLength));
+    pldm_bios_table_append_pad_checksum(table.data(), table.size(),
+                                        entriesLength);
+    return table;
+}
+
+} // namespace
+
 class TestBIOSTable : public testing::Test
 {
   public:
@@ -20,6 +77,7 @@ class TestBIOSTable : public testing::Test
 
     void TearDown() override
     {
+        BIOSTable::flush();
         fs::remove_all(dir);
     }
 
@@ -59,3 +117,252 @@ TEST_F(TestBIOSTable, testLoadOntoExisting)
     ASSERT_EQ(out[0], 99);
     ASSERT_EQ(out[1], 99);
 }
+
+TEST_F(TestBIOSTable, testWriteThrough)
+{
+    std::vector<uint8_t> table{10, 34, 56, 100, 44, 55, 69, 21, 48, 2, 7, 82};
+    fs::path file(dir / "tables" / "t1");
+    BIOSTable t(file.string().c_str());
+    t.store(table);
+
+    // Another object of the same file shares the table in memory
+    BIOSTable other(file.string().c_str());
+    ASSERT_FALSE(other.isEmpty());
+    EXPECT_EQ(*other.get(), table);
+    EXPECT_EQ(other.get(), t.get());
+
+    // The table is persisted after a header, with no temporary file left
+    BIOSTable::flush();
+    std::ifstream stream(file.string(), std::ios::in | std::ios::binary);
+    std::vector<uint8_t> persisted((std::istreambuf_iterator<char>(stream)),
+                                   std::istreambuf_iterator<char>());
+    ASSERT_GT(persisted.size(), table.size());
+    EXPECT_TRUE(std::equal(table.begin(), table.end(),
+                           persisted.end() - table.size()));
+    EXPECT_EQ(std::distance(fs::directory_iterator(file.parent_path()),
+                            fs::directory_iterator()),
+              1);
+
+    other.remove();
+    EXPECT_TRUE(t.isEmpty());
+    BIOSTable::flush();
+    EXPECT_FALSE(fs::exists(file));
+}
+
+TEST_F(TestBIOSTable, testPersistedAcrossRestart)
+{
+    std::vector<uint8_t> table{10, 34, 56, 100, 44, 55, 69, 21, 48, 2, 7, 82};
+    fs::path file(dir / "t1");
+    BIOSTable t(file.string().c_str(), 7);
+    t.store(table);
+    BIOSTable::flush();
+
+    // As after a restart, the table is read back from its file
+    t.forget();
+    ASSERT_FALSE(t.isEmpty());
+    EXPECT_EQ(*t.get(), table);
+
+    // A table built from other inputs isn't used
+    t.forget();
+    EXPECT_TRUE(BIOSTable(file.string().c_str(), 8).isEmpty());
+
+    // Nor is a corrupt one
+    t.forget();
+    {
+        std::fstream stream(file.string(),
+                            std::ios::in | std::ios::out | std::ios::binary);
+        stream.seekp(-1, std::ios::end);
+        stream.put(0);
+    }
+    EXPECT_TRUE(t.isEmpty());
+}
+
+TEST_F(TestBIOSTable, testUpdateAttrValue)
+{
+    auto table = valueTable({integerEntry(0, 5), stringEntry(1, "abc"),
+                             integerEntry(2, 7)});
+    fs::path file(dir / "t1");
+    BIOSTable t(file.string().c_str(), 7);
+    t.store(table);
+    BIOSTable::flush();
+
+    // Entries of the same length are appended to the journal of the file,
+    // and the table read back has the same CRC as if it were written whole
+    auto before = t.get();
+    ASSERT_TRUE(t.updateAttrValue(integerEntry(2, 9).data(),
+                                  integerEntry(2, 9).size()));
+    auto expected =
+        valueTable({integerEntry(0, 5), stringEntry(1, "abc"),
+                    integerEntry(2, 9)});
+    EXPECT_EQ(*t.get(), expected);
+    EXPECT_NE(*before, expected);
+    BIOSTable::flush();
+    t.forget();
+    ASSERT_FALSE(t.isEmpty());
+    EXPECT_EQ(*t.get(), expected);
+
+    // Others are spliced in, and the table written whole
+    auto longer = stringEntry(1, "abcdef");
+    ASSERT_TRUE(t.updateAttrValue(longer.data(), longer.size()));
+    ASSERT_TRUE(t.updateAttrValue(integerEntry(2, 3).data(),
+                                  integerEntry(2, 3).size()));
+    expected = valueTable(
+        {integerEntry(0, 5), stringEntry(1, "abcdef"), integerEntry(2, 3)});
+    EXPECT_EQ(*t.get(), expected);
+    BIOSTable::flush();
+    t.forget();
+    ASSERT_FALSE(t.isEmpty());
+    EXPECT_EQ(*t.get(), expected);
+
+    // Attributes not in the table, or of another type, aren't updated
+    EXPECT_FALSE(t.updateAttrValue(integerEntry(3, 1).data(),
+                                   integerEntry(3, 1).size()));
+    EXPECT_FALSE(t.updateAttrValue(integerEntry(1, 1).data(),
+                                   integerEntry(1, 1).size()));
+    EXPECT_FALSE(BIOSTable((dir / "t2").string().c_str())
+                     .updateAttrValue(longer.data(), longer.size()));
+}
+
+TEST_F(TestBIOSTable, testJournal)
+{
+    std::vector<Table> entries;
+    for (uint16_t handle = 0; handle < 20; ++handle)
+    {
+        entries.push_back(integerEntry(handle, handle));
+    }
+    fs::path file(dir / "t1");
+    auto journal = file;
+    journal += ".journal";
+    BIOSTable t(file.string().c_str(), 7);
+    t.store(valueTable(entries));
+    BIOSTable::flush();
+
+    // Updates go to the journal, applied when the table is read back
+    entries[3] = integerEntry(3, 30);
+    ASSERT_TRUE(t.updateAttrValue(entries[3].data(), entries[3].size()));
+    BIOSTable::flush();
+    ASSERT_TRUE(fs::exists(journal));
+    t.forget();
+    EXPECT_EQ(*t.get(), valueTable(entries));
+
+    // A record torn by a crash isn't applied, and the journal is dropped
+    auto torn = integerEntry(4, 40);
+    ASSERT_TRUE(t.updateAttrValue(torn.data(), torn.size()));
+    BIOSTable::flush();
+    fs::resize_file(journal, fs::file_size(journal) - 1);
+    t.forget();
+    EXPECT_EQ(*t.get(), valueTable(entries));
+    BIOSTable::flush();
+    EXPECT_FALSE(fs::exists(journal));
+    t.forget();
+    EXPECT_EQ(*t.get(), valueTable(entries));
+
+    // The journal is compacted into the file once it outgrows the table
+    size_t records = 0;
+    do
+    {
+        entries[5] = integerEntry(5, 50 + records++);
+        ASSERT_TRUE(t.updateAttrValue(entries[5].data(), entries[5].size()));
+        BIOSTable::flush();
+    } while (fs::exists(journal) && records < 100);
+    EXPECT_GT(records, 1);
+    EXPECT_LT(records, 100);
+    t.forget();
+    EXPECT_EQ(*t.get(), valueTable(entries));
+}
+
+TEST_F(TestBIOSTable, testFindAttrValue)
+{
+    fs::path file(dir / "t1");
+    BIOSTable t(file.string().c_str(), 7);
+    EXPECT_EQ(t.findAttrValue(5), nullptr);
+    t.store(valueTable({integerEntry(5, 1), stringEntry(6, "abc"),
+                        integerEntry(8, 3)}));
+
+    auto value = t.findAttrValue(6);
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, valueOf(stringEntry(6, "abc")));
+    EXPECT_EQ(t.findAttrValue(4), nullptr);
+    EXPECT_EQ(t.findAttrValue(7), nullptr);
+    EXPECT_EQ(t.findAttrValue(9), nullptr);
+
+    // Values follow the entries they're from, patched or spliced
+    ASSERT_TRUE(t.updateAttrValue(integerEntry(8, 4).data(),
+                                  integerEntry(8, 4).size()));
+    auto longer = stringEntry(6, "abcdef");
+    ASSERT_TRUE(t.updateAttrValue(longer.data(), longer.size()));
+    EXPECT_EQ(*t.findAttrValue(8), valueOf(integerEntry(8, 4)));
+    EXPECT_EQ(*t.findAttrValue(6), valueOf(longer));
+    EXPECT_EQ(*t.findAttrValue(5), valueOf(integerEntry(5, 1)));
+
+    // and tables stored or removed
+    t.store(valueTable({integerEntry(5, 2)}));
+    EXPECT_EQ(*t.findAttrValue(5), valueOf(integerEntry(5, 2)));
+    EXPECT_EQ(t.findAttrValue(6), nullptr);
+    t.remove();
+    EXPECT_EQ(t.findAttrValue(5), nullptr);
+}
+
+TEST(AttrValueTable, testPatchAndSplice)
+{
+    AttrValueTable values(valueTable(
+        {stringEntry(0, "x"), integerEntry(1, 1), stringEntry(2, "abc")}));
+
+    // A patch in place changes only the entry and the checksum
+    auto snapshot = values.get();
+    auto patch = values.update(integerEntry(1, 2).data(),
+                               integerEntry(1, 2).size());
+    ASSERT_TRUE(patch);
+    EXPECT_FALSE(patch->spliced);
+    EXPECT_EQ(patch->offset, stringEntry(0, "x").size());
+    EXPECT_EQ(patch->length, integerEntry(1, 2).size());
+    auto expected = valueTable(
+        {stringEntry(0, "x"), integerEntry(1, 2), stringEntry(2, "abc")});
+    EXPECT_EQ(*values.get(), expected);
+    EXPECT_EQ(values.crc(), crc32(expected.data(), expected.size()));
+
+    // The snapshot taken before is left as it was
+    EXPECT_EQ(*snapshot, valueTable({stringEntry(0, "x"), integerEntry(1, 1),
+                                     stringEntry(2, "abc")}));
+
+    // The entries after one spliced are still found
+    auto shorter = stringEntry(0, "");
+    patch = values.update(shorter.data(), shorter.size());
+    ASSERT_TRUE(patch);
+    EXPECT_TRUE(patch->spliced);
+    auto entry = stringEntry(2, "abd");
+    ASSERT_TRUE(values.update(entry.data(), entry.size()));
+    expected = valueTable(
+        {stringEntry(0, ""), integerEntry(1, 2), stringEntry(2, "abd")});
+    EXPECT_EQ(*values.get(), expected);
+    EXPECT_EQ(values.crc(), crc32(expected.data(), expected.size()));
+}
+
+TEST(BIOSStringIndex, testFindBothWays)
+{
+    std::vector<std::string> strings{"Allowed", "Disabled", "Enabled"};
+    Table table;
+    for (const auto& str : strings)
+    {
+        auto length = pldm_bios_table_string_entry_encode_length(str.size());
+        auto pos = table.size();
+        table.resize(pos + length);
+        pldm_bios_table_string_entry_encode(table.data() + pos, length,
+                                            str.c_str(), str.size());
+    }
+    table.resize(table.size() + 4); // checksum, no pad needed
+
+    BIOSStringIndex index(table);
+    for (const auto& str : strings)
+    {
+        auto entry = pldm_bios_table_string_find_by_string(
+            table.data(), table.size(), str.c_str());
+        ASSERT_NE(entry, nullptr);
+        auto handle = pldm_bios_table_string_entry_decode_handle(entry);
+        EXPECT_EQ(index.findHandle(str), handle);
+        ASSERT_NE(index.findName(handle), nullptr);
+        EXPECT_EQ(*index.findName(handle), str);
+    }
+    EXPECT_EQ(index.findHandle("Missing"), std::nullopt);
+    EXPECT_EQ(index.findName(0xffff), nullptr);
+}
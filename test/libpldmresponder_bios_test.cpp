@@ -4,10 +4,13 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
 #include <ctime>
 #include <filesystem>
+#include <memory>
 
 #include "libpldm/base.h"
 #include "libpldm/bios.h"
@@ -228,6 +231,7 @@ class TestAllBIOSTables : public ::testing::Test
     static void TearDownTestCase() // will be executed once at th eend of all
                                    // TestAllBIOSTables objects
     {
+        BIOSTable::flush();
         fs::remove_all(biosPath);
     }
 
@@ -515,6 +519,7 @@ class TestSingleTypeBIOSTable : public ::testing::Test
     void TearDown() override
     { // will be executed after each individual test
         // defined in TestSingleTypeBIOSTable
+        BIOSTable::flush();
         fs::remove_all(destBiosPath);
     }
 
@@ -670,3 +675,182 @@ TEST_F(TestSingleTypeBIOSTable,
         EXPECT_EQ(2, cv);
     }
 }
+
+TEST_F(TestSingleTypeBIOSTable, attrValuesFollowPropertiesChanged)
+{
+    TestSingleTypeBIOSTable::CopySingleJsonFile(bios_parser::bIOSStrJson);
+    auto fpath = TestSingleTypeBIOSTable::destBiosPath.c_str();
+
+    // As when the object is read at startup
+    DBusObject object{"/xyz/abc/def", "xyz.openbmc_project.str_example1.value"};
+    EXPECT_EQ(getDBusObjects().count(object), 1);
+    auto attrIndex = getAttrIndex("str_example1");
+    ASSERT_TRUE(attrIndex);
+    EXPECT_FALSE(getAttrIndex("no_such_attribute"));
+    auto attrIndices =
+        updateProperties(object, {{"Str_example1", std::string("abc")}});
+    EXPECT_EQ(attrIndices, AttrIndices{*attrIndex});
+    EXPECT_EQ(bios_string::getAttrValue("str_example1"), "abc");
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_BIOS_TABLE_REQ_BYTES>
+        requestPayload{};
+    auto request = reinterpret_cast<pldm_msg*>(requestPayload.data());
+    auto req = reinterpret_cast<pldm_get_bios_table_req*>(request->payload);
+    req->transfer_op_flag = PLDM_GET_FIRSTPART;
+    size_t requestPayloadLength = requestPayload.size() - sizeof(pldm_msg_hdr);
+    for (auto tableType : {PLDM_BIOS_STRING_TABLE, PLDM_BIOS_ATTR_TABLE})
+    {
+        req->table_type = tableType;
+        internal::buildBIOSTables(request, requestPayloadLength, fpath, fpath);
+    }
+
+    // Value of the one string attribute in the value table that isn't read
+    // only
+    req->table_type = PLDM_BIOS_ATTR_VAL_TABLE;
+    auto currentValue = [&]() {
+        auto response = internal::buildBIOSTables(
+            request, requestPayloadLength, fpath, fpath);
+        auto table = response.data() + sizeof(pldm_msg_hdr) +
+                     PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES;
+        std::unique_ptr<pldm_bios_table_iter,
+                        decltype(&pldm_bios_table_iter_free)>
+            iter(pldm_bios_table_iter_create(
+                     table, response.data() + response.size() - table,
+                     PLDM_BIOS_ATTR_VAL_TABLE),
+                 pldm_bios_table_iter_free);
+        for (; !pldm_bios_table_iter_is_end(iter.get());
+             pldm_bios_table_iter_next(iter.get()))
+        {
+            auto entry =
+                pldm_bios_table_iter_attr_value_entry_value(iter.get());
+            if (entry->attr_type == PLDM_BIOS_STRING)
+            {
+                return std::string(
+                    reinterpret_cast<const char*>(entry->value) +
+                        sizeof(uint16_t),
+                    pldm_bios_table_attr_value_entry_string_decode_length(
+                        entry));
+            }
+        }
+        return std::string();
+    };
+    EXPECT_EQ(currentValue(), "abc");
+
+    // A change is spliced into the table built
+    attrIndices =
+        updateProperties(object, {{"Str_example1", std::string("abcdef")}});
+    internal::updateAttrValues(attrIndices, fpath, fpath);
+    EXPECT_EQ(currentValue(), "abcdef");
+
+    // Properties no attribute is mapped to change nothing
+    EXPECT_TRUE(
+        updateProperties(object, {{"Other", std::string("xyz")}}).empty());
+
+    // Values are got from D-Bus again once dropped
+    attrIndices = invalidateProperties("/xyz/abc/def");
+    EXPECT_NE(std::find(attrIndices.begin(), attrIndices.end(), *attrIndex),
+              attrIndices.end());
+    EXPECT_ANY_THROW(bios_string::getAttrValue("str_example1"));
+}
+
+TEST_F(TestSingleTypeBIOSTable, setAttrValueChecksAttrTable)
+{
+    TestSingleTypeBIOSTable::CopySingleJsonFile(bios_parser::bIOSStrJson);
+    auto fpath = TestSingleTypeBIOSTable::destBiosPath.c_str();
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_BIOS_TABLE_REQ_BYTES>
+        requestPayload{};
+    auto request = reinterpret_cast<pldm_msg*>(requestPayload.data());
+    auto req = reinterpret_cast<pldm_get_bios_table_req*>(request->payload);
+    req->transfer_op_flag = PLDM_GET_FIRSTPART;
+    size_t requestPayloadLength = requestPayload.size() - sizeof(pldm_msg_hdr);
+    Response response;
+    for (auto tableType : {PLDM_BIOS_STRING_TABLE, PLDM_BIOS_ATTR_TABLE})
+    {
+        req->table_type = tableType;
+        response = internal::buildBIOSTables(request, requestPayloadLength,
+                                             fpath, fpath);
+    }
+
+    // Handles of str_example1, at least a character long, and of the read
+    // only str_example3
+    uint16_t writable = 0;
+    uint16_t readOnly = 0;
+    auto table = response.data() + sizeof(pldm_msg_hdr) +
+                 PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES;
+    std::unique_ptr<pldm_bios_table_iter, decltype(&pldm_bios_table_iter_free)>
+        iter(pldm_bios_table_iter_create(
+                 table, response.data() + response.size() - table,
+                 PLDM_BIOS_ATTR_TABLE),
+             pldm_bios_table_iter_free);
+    for (; !pldm_bios_table_iter_is_end(iter.get());
+         pldm_bios_table_iter_next(iter.get()))
+    {
+        auto entry = pldm_bios_table_iter_attr_entry_value(iter.get());
+        if (entry->attr_type == PLDM_BIOS_STRING_READ_ONLY)
+        {
+            readOnly = entry->attr_handle;
+        }
+        else if (pldm_bios_table_attr_entry_string_decode_min_length(entry))
+        {
+            writable = entry->attr_handle;
+        }
+    }
+
+    auto set = [fpath](const std::vector<uint8_t>& entry) {
+        std::vector<uint8_t> msg(sizeof(pldm_msg_hdr) +
+                                 PLDM_SET_BIOS_ATTR_CURR_VAL_MIN_REQ_BYTES +
+                                 entry.size());
+        auto request = reinterpret_cast<pldm_msg*>(msg.data());
+        auto payloadLength = msg.size() - sizeof(pldm_msg_hdr);
+        encode_set_bios_attribute_current_value_req(
+            0, 0, PLDM_START_AND_END, entry.data(), entry.size(), request,
+            payloadLength);
+        auto response = internal::setBIOSAttributeCurrentValue(
+            request, payloadLength, fpath, fpath);
+        return reinterpret_cast<pldm_msg*>(response.data())->payload[0];
+    };
+    auto stringEntry = [](uint16_t handle, uint8_t type,
+                          const std::string& str) {
+        std::vector<uint8_t> entry(
+            pldm_bios_table_attr_value_entry_encode_string_length(str.size()));
+        pldm_bios_table_attr_value_entry_encode_string(
+            entry.data(), entry.size(), handle, type, str.size(), str.c_str());
+        return entry;
+    };
+
+    EXPECT_EQ(set(stringEntry(0xffff, PLDM_BIOS_STRING, "ab")),
+              PLDM_INVALID_BIOS_ATTR_HANDLE);
+    EXPECT_EQ(set(stringEntry(readOnly, PLDM_BIOS_STRING_READ_ONLY, "ab")),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(set(stringEntry(writable, PLDM_BIOS_ENUMERATION, "ab")),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(set(stringEntry(writable, PLDM_BIOS_STRING, "")),
+              PLDM_ERROR_INVALID_DATA);
+    auto tooLong = std::string(101, 'a');
+    EXPECT_EQ(set(stringEntry(writable, PLDM_BIOS_STRING, tooLong)),
+              PLDM_ERROR_INVALID_DATA);
+    auto truncated = stringEntry(writable, PLDM_BIOS_STRING, "ab");
+    truncated.pop_back();
+    EXPECT_EQ(set(truncated), PLDM_ERROR_INVALID_LENGTH);
+
+    // A valid value is written to D-Bus, which isn't there
+    EXPECT_EQ(set(stringEntry(writable, PLDM_BIOS_STRING, "ab")), PLDM_ERROR);
+}
+
+TEST(fetchProperties, objectsNotReadAreNotAskedPerAttribute)
+{
+    bios_parser::setupConfig("./bios_jsons");
+
+    // There's no D-Bus to read the objects from here
+    fetchProperties(std::chrono::milliseconds(1));
+    auto misses = pldm::utils::DBusHandler::getServiceCacheStats().misses;
+    EXPECT_ANY_THROW(bios_string::getAttrValue("str_example2"));
+    EXPECT_EQ(pldm::utils::DBusHandler::getServiceCacheStats().misses, misses);
+
+    // Until they change
+    DBusObject object{"/xyz/abc/def", "xyz.openbmc_project.str_example2.value"};
+    updateProperties(object, {{"Str_example2", std::string("gh")}});
+    EXPECT_EQ(bios_string::getAttrValue("str_example2"), "gh");
+    invalidateProperties("/xyz/abc/def");
+}
@@ -0,0 +1,79 @@
+#include "libpldmresponder/entity_tree.hpp"
+#include "libpldmresponder/pdr.hpp"
+
+#include "libpldm/platform.h"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder;
+
+TEST(EntityTree, testBuildFromPdr)
+{
+    auto snapshot = pdr::getSnapshot("./pdr_jsons/entity_tree/good");
+    const auto& repo = *snapshot->repo;
+    const auto& tree = *snapshot->entities;
+
+    // System, chassis, 2 sensors and the entity 33 effecter
+    ASSERT_EQ(tree.size(), 5);
+
+    auto chassis = tree.find({45, 1, 0});
+    ASSERT_TRUE(chassis.has_value());
+    ASSERT_EQ(tree.parent(*chassis), entity::Tree::root);
+    ASSERT_EQ(tree.container(1), chassis);
+    ASSERT_EQ(tree.node(*chassis).containerId, 1);
+
+    auto sensor1 = tree.find({64, 1, 1});
+    auto sensor2 = tree.find({64, 2, 1});
+    ASSERT_TRUE(sensor1.has_value());
+    ASSERT_TRUE(sensor2.has_value());
+    ASSERT_EQ(tree.parent(*sensor1), *chassis);
+    ASSERT_EQ(tree.parent(*sensor2), *chassis);
+    ASSERT_FALSE(tree.find({64, 3, 1}).has_value());
+
+    auto [begin, end] = tree.children(*chassis);
+    ASSERT_EQ(end - begin, 2);
+    ASSERT_EQ(tree.node(begin[0]).entity.entity_instance_num, 1);
+    ASSERT_EQ(tree.node(begin[1]).entity.entity_instance_num, 2);
+
+    auto [rootBegin, rootEnd] = tree.children(entity::Tree::root);
+    ASSERT_EQ(rootEnd - rootBegin, 2);
+
+    // The chassis effecter, but not the entity 33 one
+    auto effecters =
+        tree.recordsUnder(entity::Tree::root, PLDM_STATE_EFFECTER_PDR);
+    ASSERT_EQ(effecters.size(), 2);
+    effecters = tree.recordsUnder(*chassis, PLDM_STATE_EFFECTER_PDR);
+    ASSERT_EQ(effecters.size(), 1);
+    auto e = repo.at(effecters[0]);
+    auto effecter = reinterpret_cast<pldm_state_effecter_pdr*>(e.data());
+    ASSERT_EQ(effecter->entity_type, 45);
+
+    auto sensors = tree.recordsUnder(*chassis, PLDM_NUMERIC_SENSOR_PDR);
+    ASSERT_EQ(sensors.size(), 2);
+}
+
+TEST(EntityTree, testGeneratedAssociation)
+{
+    auto snapshot = pdr::getSnapshot("./pdr_jsons/entity_tree/good");
+    const auto& repo = *snapshot->repo;
+    const auto& tree = *snapshot->entities;
+
+    // The JSON lists the first sensor only, the second one is associated
+    // by a generated PDR at the end of the repository
+    ASSERT_EQ(repo.numEntries(), 6);
+    auto e = repo.at(6);
+    auto pdr = reinterpret_cast<pldm_pdr_entity_association*>(e.data());
+    ASSERT_EQ(pdr->hdr.record_handle, 6);
+    ASSERT_EQ(pdr->hdr.type, PLDM_PDR_ENTITY_ASSOCIATION);
+    ASSERT_EQ(pdr->hdr.length, e.size() - sizeof(pldm_pdr_hdr));
+    ASSERT_EQ(pdr->container_id, 1);
+    ASSERT_EQ(pdr->container.entity_type, 45);
+    ASSERT_EQ(pdr->num_children, 1);
+    ASSERT_EQ(pdr->children[0].entity_type, 64);
+    ASSERT_EQ(pdr->children[0].entity_instance_num, 2);
+
+    auto chassis = tree.find({45, 1, 0});
+    ASSERT_EQ(tree.recordsUnder(*chassis, PLDM_PDR_ENTITY_ASSOCIATION).size(),
+              2);
+    ASSERT_TRUE(tree.associationPdrs().empty());
+}
@@ -0,0 +1,116 @@
+#include "libpldmresponder/events.hpp"
+
+#include <array>
+
+#include "libpldm/platform.h"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder::events;
+
+namespace
+{
+
+/** @brief Queue a stateSensorState event */
+bool pushStateEvent(Queue& queue, uint8_t tid, uint16_t sensorId,
+                    uint8_t offset, uint8_t state, uint8_t previous)
+{
+    std::array<uint8_t, 6> data{static_cast<uint8_t>(sensorId & 0xFF),
+                                static_cast<uint8_t>(sensorId >> 8),
+                                PLDM_STATE_SENSOR_STATE,
+                                offset,
+                                state,
+                                previous};
+    return queue.push(tid, PLDM_SENSOR_EVENT, data.data(), data.size());
+}
+
+} // namespace
+
+TEST(RingBuffer, testPushPop)
+{
+    RingBuffer<int, 4> ring;
+    int item = 0;
+    ASSERT_FALSE(ring.pop(item));
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.push(i));
+    }
+    ASSERT_FALSE(ring.push(4));
+
+    ASSERT_TRUE(ring.pop(item));
+    ASSERT_EQ(item, 0);
+    ASSERT_TRUE(ring.push(4));
+    for (int i = 1; i <= 4; ++i)
+    {
+        ASSERT_TRUE(ring.pop(item));
+        ASSERT_EQ(item, i);
+    }
+    ASSERT_FALSE(ring.pop(item));
+}
+
+TEST(EventQueue, testCoalesce)
+{
+    Queue queue;
+    // A sensor flapping between states is published once
+    ASSERT_TRUE(pushStateEvent(queue, 1, 0x10, 0, 2, 1));
+    ASSERT_TRUE(pushStateEvent(queue, 1, 0x10, 0, 3, 2));
+    ASSERT_TRUE(pushStateEvent(queue, 1, 0x10, 0, 4, 3));
+    // Other composite sensors, sensors and termini are kept apart
+    ASSERT_TRUE(pushStateEvent(queue, 1, 0x10, 1, 5, 1));
+    ASSERT_TRUE(pushStateEvent(queue, 2, 0x10, 0, 6, 1));
+    ASSERT_TRUE(pushStateEvent(queue, 1, 0x11, 0, 7, 1));
+
+    std::array<uint8_t, 8> numeric{0x20,
+                                   0x00,
+                                   PLDM_NUMERIC_SENSOR_STATE,
+                                   PLDM_SENSOR_UPPERWARNING,
+                                   PLDM_SENSOR_NORMAL,
+                                   PLDM_SENSOR_DATA_SIZE_UINT16,
+                                   0x00,
+                                   0x01};
+    ASSERT_TRUE(
+        queue.push(1, PLDM_SENSOR_EVENT, numeric.data(), numeric.size()));
+
+    // Malformed events are counted and skipped
+    std::array<uint8_t, 3> bad{0x30, 0x00, PLDM_STATE_SENSOR_STATE};
+    ASSERT_TRUE(queue.push(1, PLDM_SENSOR_EVENT, bad.data(), bad.size()));
+
+    auto batch = queue.drain();
+    ASSERT_EQ(batch.size(), 5);
+    ASSERT_EQ(queue.getDecodeErrors(), 1);
+
+    const auto& flapping = batch[0];
+    ASSERT_EQ(flapping.tid, 1);
+    ASSERT_EQ(flapping.sensorId, 0x10);
+    ASSERT_EQ(flapping.sensorOffset, 0);
+    ASSERT_EQ(flapping.eventState, 4);
+    ASSERT_EQ(flapping.previousEventState, 1);
+    ASSERT_EQ(flapping.coalesced, 3);
+    ASSERT_EQ(batch[1].sensorOffset, 1);
+    ASSERT_EQ(batch[2].sensorId, 0x11);
+
+    const auto& reading = batch[3];
+    ASSERT_EQ(reading.sensorId, 0x20);
+    ASSERT_EQ(reading.sensorEventClass, PLDM_NUMERIC_SENSOR_STATE);
+    ASSERT_EQ(reading.presentReading, 0x100);
+    ASSERT_EQ(batch[4].tid, 2);
+
+    ASSERT_TRUE(queue.drain().empty());
+}
+
+TEST(EventQueue, testOverflow)
+{
+    Queue queue;
+    for (size_t i = 0; i < queueCapacity; ++i)
+    {
+        ASSERT_TRUE(pushStateEvent(queue, 1, 1, 0, 1, 0));
+    }
+    ASSERT_FALSE(pushStateEvent(queue, 1, 1, 0, 2, 1));
+    ASSERT_FALSE(pushStateEvent(queue, 1, 1, 0, 2, 1));
+    ASSERT_EQ(queue.getOverflows(), 2);
+
+    auto batch = queue.drain();
+    ASSERT_EQ(batch.size(), 1);
+    ASSERT_EQ(batch[0].coalesced, queueCapacity);
+    ASSERT_TRUE(pushStateEvent(queue, 1, 1, 0, 2, 1));
+}
@@ -0,0 +1,150 @@
+#include "libpldmresponder/pdr.hpp"
+#include "libpldmresponder/sensors.hpp"
+
+#include "libpldm/platform.h"
+
+#include <cstring>
+#include <map>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder;
+
+namespace
+{
+
+/** @brief Generate the PDRs in a directory, keyed by PDR type */
+std::map<pdr::Type, pdr::Entry> generateByType(const std::string& dir)
+{
+    pdr::internal::IndexedRepo repo;
+    sensor::resetId();
+    pdr::internal::generate(dir, repo);
+
+    std::map<pdr::Type, pdr::Entry> byType;
+    for (size_t i = 1; i <= repo.numEntries(); ++i)
+    {
+        auto e = repo.at(i);
+        auto hdr = reinterpret_cast<pldm_pdr_hdr*>(e.data());
+        EXPECT_EQ(hdr->record_handle, i);
+        EXPECT_EQ(hdr->version, 1);
+        EXPECT_EQ(hdr->length, e.size() - sizeof(pldm_pdr_hdr));
+        byType.emplace(hdr->type, std::move(e));
+    }
+    return byType;
+}
+
+} // namespace
+
+TEST(GeneratePDR, testNumericSensor)
+{
+    auto byType = generateByType("./pdr_jsons/generators/good");
+    ASSERT_EQ(byType.size(), 4);
+
+    auto& e = byType.at(PLDM_NUMERIC_SENSOR_PDR);
+    // sint16 readings and real32 range fields
+    ASSERT_EQ(e.size(), sizeof(pldm_numeric_sensor_pdr) - 1 + 24 + 3 * 2 +
+                            9 * sizeof(float));
+    auto pdr = reinterpret_cast<pldm_numeric_sensor_pdr*>(e.data());
+    ASSERT_NE(pdr->sensor_id, 0);
+    ASSERT_EQ(pdr->entity_type, 64);
+    ASSERT_EQ(pdr->entity_instance, 1);
+    ASSERT_EQ(pdr->container_id, 1);
+    ASSERT_EQ(pdr->base_unit, 2);
+    ASSERT_EQ(pdr->unit_modifier, -3);
+    ASSERT_EQ(pdr->sensor_data_size, PLDM_SENSOR_DATA_SIZE_SINT16);
+
+    const uint8_t* fields = pdr->variable_fields;
+    float resolution{};
+    memcpy(&resolution, fields, sizeof(resolution));
+    ASSERT_EQ(resolution, 1);
+
+    int16_t maxReadable{};
+    int16_t minReadable{};
+    memcpy(&maxReadable, fields + 24, sizeof(maxReadable));
+    memcpy(&minReadable, fields + 26, sizeof(minReadable));
+    ASSERT_EQ(maxReadable, 4000);
+    ASSERT_EQ(minReadable, -400);
+    ASSERT_EQ(fields[28], PLDM_RANGE_FIELD_FORMAT_REAL32);
+    // normal max, critical high and fatal low
+    ASSERT_EQ(fields[29], (1 << 1) | (1 << 3) | (1 << 6));
+
+    float normalMax{};
+    float fatalLow{};
+    memcpy(&normalMax, fields + 30 + sizeof(float), sizeof(normalMax));
+    memcpy(&fatalLow, fields + 30 + 8 * sizeof(float), sizeof(fatalLow));
+    ASSERT_EQ(normalMax, 85.5);
+    ASSERT_EQ(fatalLow, -10);
+
+    // Upper warning, upper critical and lower fatal thresholds
+    ASSERT_EQ(fields[14], (1 << 0) | (1 << 1) | (1 << 5));
+    float warningHigh{};
+    memcpy(&warningHigh, fields + 30 + 3 * sizeof(float),
+           sizeof(warningHigh));
+    ASSERT_EQ(warningHigh, 2000);
+}
+
+TEST(GeneratePDR, testNumericSensorOutOfRange)
+{
+    // A hysteresis too large for a uint8 sensor fails the file
+    auto parsed = pdr::internal::parse(
+        {"./pdr_jsons/generators/out_of_range/2.json"});
+    ASSERT_EQ(parsed.size(), 1);
+    ASSERT_TRUE(parsed[0].records.empty());
+    ASSERT_NE(parsed[0].error.find("300"), std::string::npos);
+}
+
+TEST(GeneratePDR, testStateSensor)
+{
+    auto byType = generateByType("./pdr_jsons/generators/good");
+
+    auto& e = byType.at(PLDM_STATE_SENSOR_PDR);
+    ASSERT_EQ(e.size(), sizeof(pldm_state_sensor_pdr) - 1 +
+                            sizeof(state_sensor_possible_states));
+    auto pdr = reinterpret_cast<pldm_state_sensor_pdr*>(e.data());
+    ASSERT_NE(pdr->sensor_id, 0);
+    ASSERT_EQ(pdr->entity_type, 45);
+    ASSERT_EQ(pdr->sensor_init, PLDM_SENSOR_NO_INIT);
+    ASSERT_EQ(pdr->composite_sensor_count, 1);
+    auto states =
+        reinterpret_cast<state_sensor_possible_states*>(pdr->possible_states);
+    ASSERT_EQ(states->state_set_id, 196);
+    ASSERT_EQ(states->possible_states_size, 1);
+    ASSERT_EQ(states->states[0].byte, 6);
+
+    // Sensor ids are unique across sensor PDR types
+    auto numeric = reinterpret_cast<pldm_numeric_sensor_pdr*>(
+        byType.at(PLDM_NUMERIC_SENSOR_PDR).data());
+    ASSERT_NE(numeric->sensor_id, pdr->sensor_id);
+}
+
+TEST(GeneratePDR, testEntityAssociation)
+{
+    auto byType = generateByType("./pdr_jsons/generators/good");
+
+    auto& e = byType.at(PLDM_PDR_ENTITY_ASSOCIATION);
+    ASSERT_EQ(e.size(), sizeof(pldm_pdr_entity_association) +
+                            sizeof(pldm_entity));
+    auto pdr = reinterpret_cast<pldm_pdr_entity_association*>(e.data());
+    ASSERT_EQ(pdr->container_id, 1);
+    ASSERT_EQ(pdr->association_type, PLDM_ENTITY_ASSOCIATION_PHYSICAL);
+    ASSERT_EQ(pdr->container.entity_type, 45);
+    ASSERT_EQ(pdr->container.entity_instance_num, 1);
+    ASSERT_EQ(pdr->num_children, 2);
+    ASSERT_EQ(pdr->children[1].entity_type, 64);
+    ASSERT_EQ(pdr->children[1].entity_instance_num, 2);
+    ASSERT_EQ(pdr->children[1].entity_container_id, 1);
+}
+
+TEST(GeneratePDR, testFruRecordSet)
+{
+    auto byType = generateByType("./pdr_jsons/generators/good");
+
+    auto& e = byType.at(PLDM_PDR_FRU_RECORD_SET);
+    ASSERT_EQ(e.size(), sizeof(pldm_pdr_fru_record_set));
+    auto pdr = reinterpret_cast<pldm_pdr_fru_record_set*>(e.data());
+    ASSERT_EQ(pdr->terminus_handle, 0);
+    ASSERT_EQ(pdr->fru_rsi, 1);
+    ASSERT_EQ(pdr->entity_type, 45);
+    ASSERT_EQ(pdr->entity_instance_num, 1);
+    ASSERT_EQ(pdr->container_id, 0);
+}
@@ -1,6 +1,8 @@
 #include "libpldmresponder/effecters.hpp"
 #include "libpldmresponder/pdr.hpp"
 
+#include <future>
+
 #include "libpldm/platform.h"
 
 #include <gtest/gtest.h>
@@ -11,7 +13,8 @@ TEST(GeneratePDR, testGoodJson)
 {
     using namespace pdr;
     using namespace effecter::dbus_mapping;
-    Repo& pdrRepo = get("./pdr_jsons/state_effecter/good");
+    auto snapshot = getSnapshot("./pdr_jsons/state_effecter/good");
+    const Repo& pdrRepo = *snapshot->repo;
 
     // 2 entries
     ASSERT_EQ(pdrRepo.numEntries(), 2);
@@ -92,7 +95,8 @@ TEST(GeneratePDR, testGoodJson)
 TEST(GeneratePDR, testNoJson)
 {
     using namespace pdr;
-    Repo& pdrRepo = get("./pdr_jsons/not_there");
+    auto snapshot = getSnapshot("./pdr_jsons/not_there");
+    const Repo& pdrRepo = *snapshot->repo;
 
     ASSERT_EQ(pdrRepo.numEntries(), 2);
 }
@@ -100,10 +104,128 @@ TEST(GeneratePDR, testNoJson)
 TEST(GeneratePDR, testMalformedJson)
 {
     using namespace pdr;
-    Repo& pdrRepo = get("./pdr_jsons/state_effecter/good");
+    auto snapshot = getSnapshot("./pdr_jsons/state_effecter/good");
+    const Repo& pdrRepo = *snapshot->repo;
     ASSERT_EQ(pdrRepo.numEntries(), 2);
-    pdrRepo.makeEmpty();
     ASSERT_THROW(pldm::responder::pdr::internal::readJson(
                      "./pdr_jsons/state_effecter/malformed"),
                  std::exception);
 }
+
+TEST(GeneratePDR, testRebuildSnapshot)
+{
+    using namespace pdr;
+    using namespace effecter::dbus_mapping;
+    auto before = getSnapshot("./pdr_jsons/state_effecter/good");
+    ASSERT_EQ(before->repo->numEntries(), 2);
+
+    rebuild("./pdr_jsons/state_effecter/good");
+    auto after = getSnapshot("./pdr_jsons/state_effecter/good");
+
+    // A new repository is published, the old one stays intact for readers
+    // still holding it
+    ASSERT_NE(before->repo, after->repo);
+    ASSERT_EQ(before->repo->numEntries(), 2);
+    ASSERT_EQ(after->repo->numEntries(), 2);
+    ASSERT_EQ(after->repo->getSignature(), before->repo->getSignature() + 1);
+
+    // Effecter ids are assigned afresh, so an unchanged config yields the
+    // same repository
+    ASSERT_EQ(before->repo->at(1), after->repo->at(1));
+    ASSERT_EQ(before->repo->at(2), after->repo->at(2));
+    ASSERT_EQ(after->effecterPaths->at(2).at(1), "/foo/bar/baz");
+    ASSERT_EQ(get(2).at(1), "/foo/bar/baz");
+
+    // A failed rebuild keeps the current snapshot
+    rebuild("./pdr_jsons/not_there");
+    ASSERT_EQ(getSnapshot("./pdr_jsons/not_there")->repo, after->repo);
+}
+
+TEST(GeneratePDR, testParseInOrder)
+{
+    using namespace pdr::internal;
+    std::vector<fs::path> files{"./pdr_jsons/state_effecter/good/11.json",
+                                "./pdr_jsons/state_effecter/malformed/11.json",
+                                "./pdr_jsons/state_effecter/good/11.json"};
+    auto parsed = parse(files);
+
+    ASSERT_EQ(parsed.size(), 3);
+    ASSERT_EQ(parsed[0].records.size(), 2);
+    ASSERT_TRUE(parsed[0].error.empty());
+    ASSERT_TRUE(parsed[1].records.empty());
+    ASSERT_FALSE(parsed[1].error.empty());
+    ASSERT_EQ(parsed[2].records.size(), 2);
+
+    // Record handles and effecter ids are left for the merge phase
+    for (const auto& record : parsed[0].records)
+    {
+        auto pdr = reinterpret_cast<const pldm_state_effecter_pdr*>(
+            record.entry.data());
+        ASSERT_EQ(pdr->hdr.record_handle, 0);
+        ASSERT_EQ(pdr->effecter_id, 0);
+    }
+    ASSERT_EQ(parsed[0].records[1].entry, parsed[2].records[1].entry);
+    ASSERT_EQ(parsed[0].records[1].paths[1], "/foo/bar/baz");
+}
+
+TEST(GeneratePDR, testMergeRemote)
+{
+    using namespace pdr;
+    rebuild("./pdr_jsons/state_effecter/good");
+    auto local = getSnapshot("./pdr_jsons/state_effecter/good");
+    ASSERT_EQ(local->repo->numEntries(), 2);
+
+    auto remoteRecord = [](uint32_t handle, uint8_t type) {
+        Entry entry(sizeof(pldm_pdr_hdr));
+        auto hdr = reinterpret_cast<pldm_pdr_hdr*>(entry.data());
+        hdr->record_handle = handle;
+        hdr->version = 1;
+        hdr->type = type;
+        return entry;
+    };
+    mergeRemote(9, {remoteRecord(100, PLDM_STATE_SENSOR_PDR),
+                    remoteRecord(200, PLDM_NUMERIC_SENSOR_PDR)});
+    auto merged = getSnapshot("./pdr_jsons/state_effecter/good");
+    ASSERT_EQ(merged->repo->numEntries(), 4);
+    ASSERT_EQ(merged->repo->getSignature(), local->repo->getSignature() + 1);
+    ASSERT_EQ(merged->repo->at(1), local->repo->at(1));
+    ASSERT_FALSE(merged->isRemote(2));
+
+    // The remote PDRs get local record handles, the snapshot keeps where
+    // they came from
+    auto entry = merged->repo->at(4);
+    auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(entry.data());
+    ASSERT_EQ(hdr->record_handle, 4);
+    ASSERT_EQ(hdr->type, PLDM_NUMERIC_SENSOR_PDR);
+    ASSERT_TRUE(merged->isRemote(4));
+    ASSERT_EQ(merged->remote->at(4).eid, 9);
+    ASSERT_EQ(merged->remote->at(4).handle, 200);
+    ASSERT_EQ(merged->effecterPaths, local->effecterPaths);
+
+    // A rebuild of the local PDRs keeps the remote ones
+    rebuild("./pdr_jsons/state_effecter/good");
+    auto rebuilt = getSnapshot("./pdr_jsons/state_effecter/good");
+    ASSERT_EQ(rebuilt->repo->numEntries(), 4);
+    ASSERT_EQ(rebuilt->remote->at(3).handle, 100);
+
+    removeRemote(9);
+    auto removed = getSnapshot("./pdr_jsons/state_effecter/good");
+    ASSERT_EQ(removed->repo->numEntries(), 2);
+    ASSERT_FALSE(removed->isRemote(3));
+}
+
+TEST(GeneratePDR, testRebuildAsync)
+{
+    using namespace pdr;
+    auto before = getSnapshot("./pdr_jsons/state_effecter/good");
+
+    // The event loop is woken once the new snapshot is published
+    std::promise<void> published;
+    rebuildAsync("./pdr_jsons/state_effecter/good",
+                 [&published]() { published.set_value(); });
+    published.get_future().wait();
+    auto after = getSnapshot("./pdr_jsons/state_effecter/good");
+    ASSERT_EQ(after->repo->getSignature(), before->repo->getSignature() + 1);
+    ASSERT_EQ(after->repo->at(1), before->repo->at(1));
+    finishRebuilds();
+}
@@ -2,6 +2,7 @@
 #include "libpldmresponder/pdr.hpp"
 #include "libpldmresponder/platform.hpp"
 
+#include <array>
 #include <iostream>
 
 #include <gmock/gmock-matchers.h>
@@ -23,7 +24,8 @@ TEST(getPDR, testGoodPath)
     uint16_t* reqCount = reinterpret_cast<uint16_t*>(start);
     *reqCount = 100;
     using namespace pdr;
-    Repo& pdrRepo = get("./pdr_jsons/state_effecter/good");
+    auto snapshot = getSnapshot("./pdr_jsons/state_effecter/good");
+    const Repo& pdrRepo = *snapshot->repo;
     ASSERT_EQ(pdrRepo.empty(), false);
     platform::Handler handler;
     auto response = handler.getPDR(request, requestPayloadLength);
@@ -58,7 +60,8 @@ TEST(getPDR, testShortRead)
     // Read 1 byte of PDR
     *reqCount = 1;
     using namespace pdr;
-    Repo& pdrRepo = get("./pdr_jsons/state_effecter/good");
+    auto snapshot = getSnapshot("./pdr_jsons/state_effecter/good");
+    const Repo& pdrRepo = *snapshot->repo;
     ASSERT_EQ(pdrRepo.empty(), false);
     platform::Handler handler;
     auto response = handler.getPDR(request, requestPayloadLength);
@@ -86,7 +89,8 @@ TEST(getPDR, testBadRecordHandle)
     uint16_t* reqCount = reinterpret_cast<uint16_t*>(start);
     *reqCount = 1;
     using namespace pdr;
-    Repo& pdrRepo = get("./pdr_jsons/state_effecter/good");
+    auto snapshot = getSnapshot("./pdr_jsons/state_effecter/good");
+    const Repo& pdrRepo = *snapshot->repo;
     ASSERT_EQ(pdrRepo.empty(), false);
     platform::Handler handler;
     auto response = handler.getPDR(request, requestPayloadLength);
@@ -106,7 +110,8 @@ TEST(getPDR, testNoNextRecord)
     uint32_t* recordHandle = reinterpret_cast<uint32_t*>(start);
     *recordHandle = 3;
     using namespace pdr;
-    Repo& pdrRepo = get("./pdr_jsons/state_effecter/good");
+    auto snapshot = getSnapshot("./pdr_jsons/state_effecter/good");
+    const Repo& pdrRepo = *snapshot->repo;
     ASSERT_EQ(pdrRepo.empty(), false);
     platform::Handler handler;
     auto response = handler.getPDR(request, requestPayloadLength);
@@ -131,7 +136,8 @@ TEST(getPDR, testFindPDR)
     uint16_t* reqCount = reinterpret_cast<uint16_t*>(start);
     *reqCount = 100;
     using namespace pdr;
-    Repo& pdrRepo = get("./pdr_jsons/state_effecter/good");
+    auto snapshot = getSnapshot("./pdr_jsons/state_effecter/good");
+    const Repo& pdrRepo = *snapshot->repo;
     ASSERT_EQ(pdrRepo.empty(), false);
     platform::Handler handler;
     auto response = handler.getPDR(request, requestPayloadLength);
@@ -195,6 +201,18 @@ class MockdBusHandler
                        int(const std::string&, const std::string&,
                            const std::string&,
                            const std::variant<std::string>&));
+
+    template <typename T>
+    std::vector<bool> setDbusProperties(
+        const std::vector<pldm::utils::PropertyWrite<T>>& writes,
+        std::chrono::microseconds /*timeout*/) const
+    {
+        for (const auto& w : writes)
+        {
+            setDbusProperty(w.objPath, w.dbusProp, w.dbusInterface, *w.value);
+        }
+        return std::vector<bool>(writes.size(), true);
+    }
 };
 } // namespace responder
 } // namespace pldm
@@ -204,7 +222,8 @@ using ::testing::Return;
 
 TEST(setStateEffecterStatesHandler, testGoodRequest)
 {
-    Repo& pdrRepo = get("./pdr_jsons/state_effecter/good");
+    auto snapshot = getSnapshot("./pdr_jsons/state_effecter/good");
+    const Repo& pdrRepo = *snapshot->repo;
     pdr::Entry e = pdrRepo.at(1);
     pldm_state_effecter_pdr* pdr =
         reinterpret_cast<pldm_state_effecter_pdr*>(e.data());
@@ -232,7 +251,8 @@ TEST(setStateEffecterStatesHandler, testGoodRequest)
 
 TEST(setStateEffecterStatesHandler, testBadRequest)
 {
-    Repo& pdrRepo = get("./pdr_jsons/state_effecter/good");
+    auto snapshot = getSnapshot("./pdr_jsons/state_effecter/good");
+    const Repo& pdrRepo = *snapshot->repo;
     pdr::Entry e = pdrRepo.at(1);
     pldm_state_effecter_pdr* pdr =
         reinterpret_cast<pldm_state_effecter_pdr*>(e.data());
@@ -264,3 +284,295 @@ TEST(setStateEffecterStatesHandler, testBadRequest)
                                                                 newStateField);
     ASSERT_EQ(rc, PLDM_PLATFORM_INVALID_STATE_VALUE);
 }
+
+TEST(setStateEffecterStatesHandler, testCompilePlans)
+{
+    auto snapshot = getSnapshot("./pdr_jsons/state_effecter/good");
+    auto plans = platform::compileEffecterPlans(*snapshot);
+
+    // Effecter ids start at 1
+    ASSERT_EQ(plans.size(), 3);
+    ASSERT_TRUE(plans[0].composites.empty());
+
+    const auto& composites = plans[2].composites;
+    ASSERT_EQ(composites.size(), 2);
+    ASSERT_EQ(composites[0].stateSetId, 197);
+    ASSERT_EQ(composites[0].action, nullptr);
+    ASSERT_EQ(composites[1].stateSetId, 198);
+    ASSERT_EQ(composites[1].path, "/foo/bar/baz");
+    ASSERT_TRUE(composites[1].possibleStates.test(1));
+    ASSERT_TRUE(composites[1].possibleStates.test(2));
+    ASSERT_TRUE(composites[1].possibleStates.test(5));
+    ASSERT_TRUE(composites[1].possibleStates.test(15));
+    ASSERT_EQ(composites[1].possibleStates.count(), 4);
+
+    const auto action = plans[1].composites[0].action;
+    ASSERT_NE(action, nullptr);
+    ASSERT_STREQ(action->property, "OperatingSystemState");
+    ASSERT_NE(action->valueIndex[PLDM_BOOT_NOT_ACTIVE], 0);
+    ASSERT_NE(action->valueIndex[PLDM_BOOT_COMPLETED], 0);
+    ASSERT_EQ(action->valueIndex[0], 0);
+    ASSERT_TRUE(action->keepsState);
+}
+
+TEST(setStateEffecterStatesHandler, testCompileTransitionPlan)
+{
+    // A system power state effecter, with possible states of two bytes
+    std::vector<uint8_t> entry(sizeof(pldm_state_effecter_pdr) +
+                               sizeof(state_effecter_possible_states) + 1);
+    auto pdr = reinterpret_cast<pldm_state_effecter_pdr*>(entry.data());
+    pdr->hdr.record_handle = 1;
+    pdr->hdr.type = PLDM_STATE_EFFECTER_PDR;
+    pdr->effecter_id = 1;
+    pdr->composite_effecter_count = 1;
+    auto states =
+        reinterpret_cast<state_effecter_possible_states*>(pdr->possible_states);
+    states->state_set_id = PLDM_SYSTEM_POWER_STATE;
+    states->possible_states_size = 2;
+    states->states[PLDM_OFF_SOFT_GRACEFUL / 8].byte =
+        1 << (PLDM_OFF_SOFT_GRACEFUL % 8);
+
+    auto repo = std::make_shared<internal::IndexedRepo>();
+    repo->add(std::move(entry));
+    auto paths = std::make_shared<effecter::dbus_mapping::Map>();
+    (*paths)[1] = {"/xyz/openbmc_project/state/chassis0"};
+    auto plans =
+        platform::compileEffecterPlans(Snapshot{repo, paths, {}, {}, {}});
+
+    // A power transition request is written every time
+    ASSERT_EQ(plans.size(), 2);
+    const auto action = plans[1].composites[0].action;
+    ASSERT_NE(action, nullptr);
+    ASSERT_STREQ(action->property, "RequestedPowerTransition");
+    ASSERT_FALSE(action->keepsState);
+}
+
+TEST(setStateEffecterStatesHandler, testValidateBeforeSet)
+{
+    getSnapshot("./pdr_jsons/state_effecter/good");
+
+    // The second state is not a possible state of the second composite
+    // effecter, so nothing may be written for the first one either
+    std::vector<set_effecter_state_field> stateField;
+    stateField.push_back({PLDM_REQUEST_SET, 1});
+    stateField.push_back({PLDM_REQUEST_SET, 3});
+
+    MockdBusHandler handlerObj;
+    EXPECT_CALL(handlerObj, setDbusProperty(_, _, _, _)).Times(0);
+    platform::Handler handler(std::chrono::milliseconds(100));
+    auto rc = handler.setStateEffecterStatesHandler<MockdBusHandler>(
+        handlerObj, 0x1, stateField);
+    ASSERT_EQ(rc, PLDM_PLATFORM_SET_EFFECTER_UNSUPPORTED_SENSORSTATE);
+}
+
+TEST(setStateEffecterStatesHandler, testSkipRedundantWrites)
+{
+    getSnapshot("./pdr_jsons/state_effecter/good");
+
+    std::vector<set_effecter_state_field> stateField;
+    stateField.push_back({PLDM_REQUEST_SET, 1});
+    stateField.push_back({PLDM_REQUEST_SET, 1});
+
+    MockdBusHandler handlerObj;
+    EXPECT_CALL(handlerObj, setDbusProperty(_, _, _, _)).Times(2);
+    platform::Handler handler;
+    auto rc = handler.setStateEffecterStatesHandler<MockdBusHandler>(
+        handlerObj, 0x1, stateField);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(handler.getRedundantWrites(), 0);
+
+    // The effecter is already in the requested states
+    rc = handler.setStateEffecterStatesHandler<MockdBusHandler>(
+        handlerObj, 0x1, stateField);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(handler.getRedundantWrites(), 2);
+}
+
+namespace
+{
+
+/** @brief Find the id of the first sensor PDR of a type */
+sensor::Id findSensorId(const Repo& repo, Type pdrType)
+{
+    for (size_t i = 1; i <= repo.numEntries(); ++i)
+    {
+        auto e = repo.at(i);
+        if (reinterpret_cast<pldm_pdr_hdr*>(e.data())->type != pdrType)
+        {
+            continue;
+        }
+        // The sensor id is at the same offset in all sensor PDRs
+        return reinterpret_cast<pldm_state_sensor_pdr*>(e.data())->sensor_id;
+    }
+    return 0;
+}
+
+} // namespace
+
+TEST(getStateSensorReadings, testStateTable)
+{
+    rebuild("./pdr_jsons/generators/good");
+    auto snapshot = getSnapshot("./pdr_jsons/generators/good");
+    sensor::StateTable table(*snapshot);
+
+    const std::string path = "/xyz/openbmc_project/state/host0";
+    const std::string iface = "xyz.openbmc_project.State.Host";
+    auto objects = table.objects();
+    ASSERT_EQ(objects.size(), 1);
+    ASSERT_EQ(objects[0].first, path);
+    ASSERT_EQ(objects[0].second, iface);
+
+    std::vector<get_sensor_state_field> fields;
+    ASSERT_EQ(table.getReadings(0xFFFF, fields),
+              PLDM_PLATFORM_INVALID_SENSOR_ID);
+
+    auto id = findSensorId(*snapshot->repo, PLDM_STATE_SENSOR_PDR);
+    // The numeric sensor isn't a state sensor
+    ASSERT_EQ(table.getReadings(
+                  findSensorId(*snapshot->repo, PLDM_NUMERIC_SENSOR_PDR),
+                  fields),
+              PLDM_PLATFORM_INVALID_SENSOR_ID);
+    ASSERT_EQ(table.getReadings(id, fields), PLDM_SUCCESS);
+    ASSERT_EQ(fields.size(), 1);
+    ASSERT_EQ(fields[0].sensor_op_state, PLDM_SENSOR_UNAVAILABLE);
+
+    pldm::utils::PropertyMap properties{
+        {"CurrentHostState",
+         std::string("xyz.openbmc_project.State.Host.HostState.Running")}};
+    table.update(path, iface, properties);
+    properties["CurrentHostState"] =
+        std::string("xyz.openbmc_project.State.Host.HostState.Off");
+    table.update(path, iface, properties);
+    ASSERT_EQ(table.getReadings(id, fields), PLDM_SUCCESS);
+    ASSERT_EQ(fields[0].sensor_op_state, PLDM_SENSOR_ENABLED);
+    ASSERT_EQ(fields[0].present_state, 2);
+    ASSERT_EQ(fields[0].previous_state, 1);
+
+    // Other interfaces of the object don't affect the sensor
+    table.update(path, "xyz.openbmc_project.Other", {});
+    properties["CurrentHostState"] = std::string("Unknown");
+    table.update(path, iface, properties);
+    ASSERT_EQ(table.getReadings(id, fields), PLDM_SUCCESS);
+    ASSERT_EQ(fields[0].sensor_op_state, PLDM_SENSOR_UNAVAILABLE);
+    ASSERT_EQ(fields[0].present_state, 2);
+}
+
+TEST(getStateSensorReadings, testAnsweredFromTable)
+{
+    rebuild("./pdr_jsons/generators/good");
+    auto snapshot = getSnapshot("./pdr_jsons/generators/good");
+    auto id = findSensorId(*snapshot->repo, PLDM_STATE_SENSOR_PDR);
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                            PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    bitfield8_t rearm{};
+    ASSERT_EQ(encode_get_state_sensor_readings_req(0, id, rearm, 0, request),
+              PLDM_SUCCESS);
+
+    platform::Handler handler;
+    // Requests don't read D-Bus, the table is filled in by watchSensors()
+    auto response = handler.getStateSensorReadings(
+        request, PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    ASSERT_EQ(responsePtr->payload[0], PLDM_ERROR_NOT_READY);
+
+    handler.watchSensors();
+    response = handler.getStateSensorReadings(
+        request, PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES);
+    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    ASSERT_EQ(responsePtr->payload[0], PLDM_SUCCESS);
+    ASSERT_EQ(responsePtr->payload[1], 1);
+    auto field =
+        reinterpret_cast<get_sensor_state_field*>(responsePtr->payload + 2);
+    ASSERT_EQ(field->sensor_op_state, PLDM_SENSOR_UNAVAILABLE);
+}
+
+TEST(getSensorReading, testNumericTable)
+{
+    rebuild("./pdr_jsons/generators/good");
+    auto snapshot = getSnapshot("./pdr_jsons/generators/good");
+    sensor::NumericTable table(*snapshot);
+
+    const std::string path = "/xyz/openbmc_project/sensors/temperature/ambient";
+    const std::string iface = "xyz.openbmc_project.Sensor.Value";
+    auto objects = table.objects();
+    ASSERT_EQ(objects.size(), 1);
+    ASSERT_EQ(objects[0].first, path);
+    ASSERT_EQ(objects[0].second, iface);
+
+    sensor::NumericReading reading{};
+    ASSERT_EQ(table.getReading(0xFFFF, reading),
+              PLDM_PLATFORM_INVALID_SENSOR_ID);
+
+    auto id = findSensorId(*snapshot->repo, PLDM_NUMERIC_SENSOR_PDR);
+    // The state sensor isn't a numeric sensor
+    ASSERT_EQ(table.getReading(
+                  findSensorId(*snapshot->repo, PLDM_STATE_SENSOR_PDR),
+                  reading),
+              PLDM_PLATFORM_INVALID_SENSOR_ID);
+
+    ASSERT_EQ(table.getReading(id, reading), PLDM_SUCCESS);
+    ASSERT_EQ(reading.dataSize, PLDM_SENSOR_DATA_SIZE_SINT16);
+    ASSERT_EQ(reading.opState, PLDM_SENSOR_UNAVAILABLE);
+
+    // The PDR reports millidegrees
+    table.update(path, iface, {{"Value", 1.25}});
+    ASSERT_EQ(table.getReading(id, reading), PLDM_SUCCESS);
+    ASSERT_EQ(reading.opState, PLDM_SENSOR_ENABLED);
+    ASSERT_EQ(reading.presentState, PLDM_SENSOR_NORMAL);
+    ASSERT_EQ(reading.previousState, PLDM_SENSOR_UNKNOWN);
+    ASSERT_EQ(reading.raw, 1250);
+
+    // Readings past the thresholds the PDR advertises take their state
+    table.update(path, iface, {{"Value", 2.5}});
+    ASSERT_EQ(table.getReading(id, reading), PLDM_SUCCESS);
+    ASSERT_EQ(reading.presentState, PLDM_SENSOR_UPPERWARNING);
+    ASSERT_EQ(reading.previousState, PLDM_SENSOR_NORMAL);
+    table.update(path, iface, {{"Value", 3.0}});
+    ASSERT_EQ(table.getReading(id, reading), PLDM_SUCCESS);
+    ASSERT_EQ(reading.presentState, PLDM_SENSOR_UPPERCRITICAL);
+    ASSERT_EQ(reading.previousState, PLDM_SENSOR_UPPERWARNING);
+    table.update(path, iface, {{"Value", 1.0}});
+    ASSERT_EQ(table.getReading(id, reading), PLDM_SUCCESS);
+    ASSERT_EQ(reading.presentState, PLDM_SENSOR_NORMAL);
+
+    // Readings are clamped to the sensor data size
+    table.update(path, iface, {{"Value", -100.0}});
+    ASSERT_EQ(table.getReading(id, reading), PLDM_SUCCESS);
+    ASSERT_EQ(reading.raw, INT16_MIN);
+    ASSERT_EQ(reading.presentState, PLDM_SENSOR_LOWERFATAL);
+
+    table.invalidate(path);
+    ASSERT_EQ(table.getReading(id, reading), PLDM_SUCCESS);
+    ASSERT_EQ(reading.opState, PLDM_SENSOR_UNAVAILABLE);
+    ASSERT_EQ(reading.previousState, PLDM_SENSOR_LOWERFATAL);
+}
+
+TEST(getSensorReading, testAnsweredFromTable)
+{
+    rebuild("./pdr_jsons/generators/good");
+    auto snapshot = getSnapshot("./pdr_jsons/generators/good");
+    auto id = findSensorId(*snapshot->repo, PLDM_NUMERIC_SENSOR_PDR);
+
+    std::array<uint8_t,
+               sizeof(pldm_msg_hdr) + PLDM_GET_SENSOR_READING_REQ_BYTES>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    ASSERT_EQ(encode_get_sensor_reading_req(0, id, 0, request), PLDM_SUCCESS);
+
+    platform::Handler handler;
+    auto response =
+        handler.getSensorReading(request, PLDM_GET_SENSOR_READING_REQ_BYTES);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    ASSERT_EQ(responsePtr->payload[0], PLDM_ERROR_NOT_READY);
+
+    handler.watchSensors();
+    response =
+        handler.getSensorReading(request, PLDM_GET_SENSOR_READING_REQ_BYTES);
+    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    ASSERT_EQ(responsePtr->payload[0], PLDM_SUCCESS);
+    ASSERT_EQ(responsePtr->payload[1], PLDM_SENSOR_DATA_SIZE_SINT16);
+    ASSERT_EQ(responsePtr->payload[2], PLDM_SENSOR_UNAVAILABLE);
+}
@@ -0,0 +1,244 @@
+#include "fake_requester.hpp"
+#include "requester/pdr_aggregator.hpp"
+
+#include <endian.h>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <numeric>
+#include <set>
+
+#include "libpldm/base.h"
+#include "libpldm/platform.h"
+#include "libpldm/utils.h"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::requester;
+using namespace pldm::test;
+
+namespace
+{
+
+/** @class Terminus
+ *
+ *  @brief A remote terminus answering GetPDRRepositoryInfo and GetPDR
+ */
+class Terminus
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] order - record handles, in the order of the repository
+     *  @param[in] partSize - most record bytes sent in one response
+     */
+    Terminus(const std::vector<uint32_t>& order, uint16_t partSize) :
+        order(order), partSize(partSize)
+    {
+        for (auto handle : order)
+        {
+            // Records of varying size, the data is the record handle
+            std::vector<uint8_t> record(sizeof(pldm_pdr_hdr) + handle % 7 + 4,
+                                        static_cast<uint8_t>(handle));
+            auto hdr = reinterpret_cast<pldm_pdr_hdr*>(record.data());
+            hdr->record_handle = htole32(handle);
+            hdr->version = 1;
+            hdr->type = PLDM_STATE_SENSOR_PDR;
+            hdr->record_change_num = 0;
+            hdr->length = htole16(record.size() - sizeof(pldm_pdr_hdr));
+            records[handle] = std::move(record);
+        }
+    }
+
+    std::vector<uint8_t> respond(const std::vector<uint8_t>& msg)
+    {
+        auto request = reinterpret_cast<const pldm_msg*>(msg.data());
+        auto instanceId = request->hdr.instance_id;
+        if (request->hdr.command == PLDM_GET_PDR_REPOSITORY_INFO)
+        {
+            std::vector<uint8_t> response(
+                sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REPOSITORY_INFO_RESP_BYTES);
+            std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> oemUpdateTime{};
+            encode_get_pdr_repository_info_resp(
+                instanceId, PLDM_SUCCESS, PLDM_PDR_REPOSITORY_AVAILABLE,
+                updateTime.data(), oemUpdateTime.data(), records.size(), 0,
+                0, 30, reinterpret_cast<pldm_msg*>(response.data()));
+            return response;
+        }
+
+        uint32_t handle = 0;
+        uint32_t offset = 0;
+        uint8_t flag = 0;
+        uint16_t count = 0;
+        uint16_t changeNumber = 0;
+        decode_get_pdr_req(request, msg.size() - sizeof(pldm_msg_hdr), &handle,
+                           &offset, &flag, &count, &changeNumber);
+        ++asked[handle];
+        if (!handle)
+        {
+            handle = order.front();
+        }
+        auto found = records.find(handle);
+        if (found == records.end() || broken.count(handle))
+        {
+            std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + 1);
+            encode_cc_only_resp(instanceId, PLDM_PLATFORM, PLDM_GET_PDR,
+                                PLDM_PLATFORM_INVALID_RECORD_HANDLE,
+                                reinterpret_cast<pldm_msg*>(response.data()));
+            return response;
+        }
+
+        const auto& record = found->second;
+        auto position = std::find(order.begin(), order.end(), handle);
+        uint32_t next = position + 1 == order.end() ? 0 : *(position + 1);
+        uint16_t size = std::min<size_t>(
+            {partSize, count, record.size() - offset});
+        bool last = offset + size == record.size();
+        uint8_t transferFlag = PLDM_START_AND_END;
+        if (!offset && !last)
+        {
+            transferFlag = PLDM_START;
+        }
+        else if (offset)
+        {
+            transferFlag = last ? PLDM_END : PLDM_MIDDLE;
+        }
+        std::vector<uint8_t> response(sizeof(pldm_msg_hdr) +
+                                      PLDM_GET_PDR_MIN_RESP_BYTES + size +
+                                      (transferFlag == PLDM_END));
+        encode_get_pdr_resp(instanceId, PLDM_SUCCESS, next,
+                            last ? 0 : offset + size, transferFlag, size,
+                            record.data() + offset,
+                            crc8(record.data(), record.size()),
+                            reinterpret_cast<pldm_msg*>(response.data()));
+        return response;
+    }
+
+    std::vector<uint32_t> order;
+    uint16_t partSize;
+    std::map<uint32_t, std::vector<uint8_t>> records;
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime{1};
+    std::set<uint32_t> broken;
+    std::map<uint32_t, size_t> asked;
+};
+
+/** @brief Answer requests from the termini at their endpoints */
+FakeRequester::Respond answeredBy(std::map<uint8_t, Terminus*> termini)
+{
+    return [termini](uint8_t eid, const std::vector<uint8_t>& msg) {
+        return termini.at(eid)->respond(msg);
+    };
+}
+
+using Merged = std::map<uint8_t, std::vector<std::vector<uint8_t>>>;
+
+std::vector<std::vector<uint8_t>> inOrder(const Terminus& terminus)
+{
+    std::vector<std::vector<uint8_t>> records;
+    for (auto handle : terminus.order)
+    {
+        records.push_back(terminus.records.at(handle));
+    }
+    return records;
+}
+
+} // namespace
+
+TEST(PdrAggregator, testParallelPipelinedFetch)
+{
+    std::vector<uint32_t> handles(20);
+    std::iota(handles.begin(), handles.end(), 1);
+    Terminus first(handles, 1024);
+    Terminus second(handles, 1024);
+    FakeRequester network(answeredBy({{9, &first}, {10, &second}}));
+    Merged merged;
+    PdrAggregator aggregator(
+        network.sender(),
+        [&merged](uint8_t eid, std::vector<std::vector<uint8_t>>&& records) {
+            merged[eid] = std::move(records);
+        },
+        4);
+
+    aggregator.sync(9);
+    aggregator.sync(10);
+    EXPECT_EQ(network.sent.size(), 2);
+    EXPECT_TRUE(aggregator.isSyncing(9));
+
+    // A window of requests is kept in flight to both termini at once
+    auto rounds = network.answerAll();
+    EXPECT_EQ(network.mostInFlight[9], 4);
+    EXPECT_EQ(network.mostInFlight[10], 4);
+    EXPECT_LE(rounds, 8);
+    EXPECT_FALSE(aggregator.isSyncing(9));
+    EXPECT_FALSE(aggregator.isSyncing(10));
+    EXPECT_EQ(merged[9], inOrder(first));
+    EXPECT_EQ(merged[10], inOrder(second));
+
+    // Every record was asked for once, besides record 1 asked for as the
+    // first record
+    for (auto handle : handles)
+    {
+        EXPECT_EQ(first.asked[handle], handle == 1 ? 0 : 1);
+    }
+
+    // An unchanged repository isn't fetched again
+    merged.clear();
+    aggregator.sync(9);
+    EXPECT_EQ(network.answerAll(), 1);
+    EXPECT_TRUE(merged.empty());
+
+    first.updateTime[0] = 2;
+    aggregator.sync(9);
+    network.answerAll();
+    EXPECT_EQ(merged[9], inOrder(first));
+
+    // A forgotten terminus is fetched in full
+    merged.clear();
+    aggregator.forget(10);
+    aggregator.sync(10);
+    network.answerAll();
+    EXPECT_EQ(merged[10], inOrder(second));
+}
+
+TEST(PdrAggregator, testNonContiguousMultipart)
+{
+    Terminus terminus({10, 30, 20, 5}, 6);
+    FakeRequester network(answeredBy({{9, &terminus}}));
+    Merged merged;
+    PdrAggregator aggregator(
+        network.sender(),
+        [&merged](uint8_t eid, std::vector<std::vector<uint8_t>>&& records) {
+            merged[eid] = std::move(records);
+        });
+
+    aggregator.sync(9);
+    network.answerAll();
+    EXPECT_FALSE(aggregator.isSyncing(9));
+    EXPECT_EQ(merged[9], inOrder(terminus));
+}
+
+TEST(PdrAggregator, testFailedFetch)
+{
+    Terminus terminus({1, 2, 3}, 1024);
+    terminus.broken.insert(3);
+    FakeRequester network(answeredBy({{9, &terminus}}));
+    Merged merged;
+    PdrAggregator aggregator(
+        network.sender(),
+        [&merged](uint8_t eid, std::vector<std::vector<uint8_t>>&& records) {
+            merged[eid] = std::move(records);
+        });
+
+    aggregator.sync(9);
+    network.answerAll();
+    EXPECT_FALSE(aggregator.isSyncing(9));
+    EXPECT_TRUE(merged.empty());
+
+    // A sync asked for during a fetch runs once the fetch ends
+    terminus.broken.clear();
+    aggregator.sync(9);
+    aggregator.sync(9);
+    network.answerAll();
+    EXPECT_EQ(merged[9], inOrder(terminus));
+}
@@ -0,0 +1,292 @@
+#include "fake_requester.hpp"
+#include "requester/sensor_poller.hpp"
+
+#include <endian.h>
+
+#include <cstring>
+#include <map>
+#include <sdeventplus/event.hpp>
+
+#include "libpldm/base.h"
+#include "libpldm/platform.h"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::requester;
+using namespace pldm::responder;
+using namespace pldm::test;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+/** @brief Build a numeric sensor PDR with 16 bit readings from 0 to max,
+ *         and an upper warning threshold
+ */
+std::vector<uint8_t> numericPdr(uint16_t sensorId, uint16_t max,
+                                uint16_t warningHigh)
+{
+    std::vector<uint8_t> pdr(sizeof(pldm_numeric_sensor_pdr) - 1);
+    auto numeric = reinterpret_cast<pldm_numeric_sensor_pdr*>(pdr.data());
+    numeric->hdr.type = PLDM_NUMERIC_SENSOR_PDR;
+    numeric->sensor_id = htole16(sensorId);
+    numeric->sensor_data_size = PLDM_SENSOR_DATA_SIZE_UINT16;
+
+    auto append = [&pdr](auto value) {
+        auto pos = pdr.size();
+        pdr.resize(pos + sizeof(value));
+        std::memcpy(pdr.data() + pos, &value, sizeof(value));
+    };
+    append(float(1)); // resolution
+    append(float(0)); // offset
+    append(uint16_t(0));
+    append(uint8_t(0));
+    append(uint8_t(0));
+    append(uint16_t(0)); // hysteresis
+    append(uint8_t(1));  // supported thresholds, the upper warning
+    append(uint8_t(0));
+    append(float(0));
+    append(float(0)); // update interval
+    append(htole16(max));
+    append(uint16_t(0));
+    append(uint8_t(PLDM_RANGE_FIELD_FORMAT_UINT16));
+    append(uint8_t(0));
+    for (size_t field = 0; field < 9; ++field)
+    {
+        append(htole16(field == 3 ? warningHigh : 0));
+    }
+    reinterpret_cast<pldm_pdr_hdr*>(pdr.data())->length =
+        htole16(pdr.size() - sizeof(pldm_pdr_hdr));
+    return pdr;
+}
+
+/** @brief Build a state sensor PDR */
+std::vector<uint8_t> statePdr(uint16_t sensorId, uint8_t compositeCount)
+{
+    std::vector<uint8_t> pdr(sizeof(pldm_state_sensor_pdr) - 1);
+    auto state = reinterpret_cast<pldm_state_sensor_pdr*>(pdr.data());
+    state->hdr.type = PLDM_STATE_SENSOR_PDR;
+    state->hdr.length = htole16(pdr.size() - sizeof(pldm_pdr_hdr));
+    state->sensor_id = htole16(sensorId);
+    state->composite_sensor_count = compositeCount;
+    return pdr;
+}
+
+/** @class Terminus
+ *
+ *  @brief A remote terminus answering GetSensorReading and
+ *         GetStateSensorReadings
+ */
+class Terminus
+{
+  public:
+    std::vector<uint8_t> respond(const std::vector<uint8_t>& msg)
+    {
+        auto request = reinterpret_cast<const pldm_msg*>(msg.data());
+        auto payloadLength = msg.size() - sizeof(pldm_msg_hdr);
+        auto instanceId = request->hdr.instance_id;
+        uint16_t sensorId = 0;
+        ++polls;
+        if (request->hdr.command == PLDM_GET_SENSOR_READING)
+        {
+            bool8_t rearm = 0;
+            decode_get_sensor_reading_req(request, payloadLength, &sensorId,
+                                          &rearm);
+            constexpr auto respMsgLen =
+                PLDM_GET_SENSOR_READING_MIN_RESP_BYTES + 1;
+            std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + respMsgLen);
+            auto reading = htole16(numeric.at(sensorId));
+            encode_get_sensor_reading_resp(
+                instanceId, PLDM_SUCCESS, PLDM_SENSOR_DATA_SIZE_UINT16,
+                PLDM_SENSOR_ENABLED, PLDM_NO_EVENT_GENERATION,
+                PLDM_SENSOR_NORMAL, PLDM_SENSOR_NORMAL, PLDM_SENSOR_NORMAL,
+                reinterpret_cast<const uint8_t*>(&reading),
+                reinterpret_cast<pldm_msg*>(response.data()), respMsgLen);
+            return response;
+        }
+
+        bitfield8_t rearm{};
+        uint8_t reserved = 0;
+        decode_get_state_sensor_readings_req(request, payloadLength, &sensorId,
+                                             &rearm, &reserved);
+        std::vector<get_sensor_state_field> fields;
+        for (auto present : state.at(sensorId))
+        {
+            fields.push_back({PLDM_SENSOR_ENABLED, present, 0, present});
+        }
+        std::vector<uint8_t> response(
+            sizeof(pldm_msg_hdr) +
+            PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
+            sizeof(get_sensor_state_field) * (fields.size() - 1));
+        encode_get_state_sensor_readings_resp(
+            instanceId, PLDM_SUCCESS, fields.size(), fields.data(),
+            reinterpret_cast<pldm_msg*>(response.data()));
+        return response;
+    }
+
+    std::map<uint16_t, uint16_t> numeric;
+    std::map<uint16_t, std::vector<uint8_t>> state;
+    size_t polls = 0;
+};
+
+/** @brief Answer requests from the terminus */
+FakeRequester::Respond answeredBy(Terminus& terminus)
+{
+    return [&terminus](uint8_t, const std::vector<uint8_t>& msg) {
+        return terminus.respond(msg);
+    };
+}
+
+/** @brief Capabilities of a terminus with both sensor reading commands */
+Capabilities capabilities()
+{
+    Capabilities capabilities{};
+    capabilities.tid = 42;
+    capabilities.commands[PLDM_PLATFORM].set(PLDM_GET_SENSOR_READING);
+    capabilities.commands[PLDM_PLATFORM].set(PLDM_GET_STATE_SENSOR_READINGS);
+    return capabilities;
+}
+
+} // namespace
+
+TEST(SensorPoller, testOutstandingLimit)
+{
+    Terminus terminus;
+    FakeRequester network(answeredBy(terminus));
+    std::vector<events::SensorEvent> published;
+    SensorPoller poller(
+        sdeventplus::Event::get_default(), network.sender(),
+        [&published](const events::SensorEvent& event) {
+            published.push_back(event);
+        },
+        100ms, 800ms, 2);
+
+    std::vector<std::vector<uint8_t>> records;
+    for (uint16_t sensorId = 1; sensorId <= 10; ++sensorId)
+    {
+        records.push_back(statePdr(sensorId, 1));
+        terminus.state[sensorId] = {PLDM_SENSOR_NORMAL};
+    }
+    poller.track(9, capabilities(), records);
+    EXPECT_EQ(poller.size(), 10);
+    EXPECT_TRUE(network.sent.empty());
+
+    // The polls due together go out back to back, two at a time
+    poller.tick();
+    EXPECT_EQ(network.sent.size(), 2);
+    EXPECT_EQ(network.answerAll(), 5);
+    EXPECT_EQ(network.mostInFlight[9], 2);
+    EXPECT_EQ(terminus.polls, 10);
+    ASSERT_EQ(published.size(), 10);
+    EXPECT_EQ(published[0].tid, 42);
+    EXPECT_EQ(published[0].sensorEventClass, PLDM_STATE_SENSOR_STATE);
+}
+
+TEST(SensorPoller, testPublishOnChangeAndBackOff)
+{
+    Terminus terminus;
+    FakeRequester network(answeredBy(terminus));
+    std::vector<events::SensorEvent> published;
+    SensorPoller poller(
+        sdeventplus::Event::get_default(), network.sender(),
+        [&published](const events::SensorEvent& event) {
+            published.push_back(event);
+        },
+        100ms, 800ms, 1);
+    terminus.state[1] = {PLDM_SENSOR_NORMAL, PLDM_SENSOR_NORMAL};
+    poller.track(9, capabilities(), {statePdr(1, 2)});
+
+    // An unchanged reading is published once, and polled less and less
+    for (size_t tick = 0; tick < 16; ++tick)
+    {
+        poller.tick();
+        network.answerAll();
+    }
+    EXPECT_EQ(published.size(), 2);
+    EXPECT_EQ(terminus.polls, 5);
+    EXPECT_EQ(poller.getInterval(9, 1), 800ms);
+
+    // A change is published for the composite sensor that changed, and
+    // polling speeds up
+    terminus.state[1][1] = PLDM_SENSOR_WARNING;
+    for (size_t tick = 0; tick < 8; ++tick)
+    {
+        poller.tick();
+        network.answerAll();
+    }
+    ASSERT_EQ(published.size(), 3);
+    EXPECT_EQ(published[2].sensorOffset, 1);
+    EXPECT_EQ(published[2].eventState, PLDM_SENSOR_WARNING);
+    EXPECT_EQ(poller.getInterval(9, 1), 400ms);
+}
+
+TEST(SensorPoller, testThresholdProximity)
+{
+    Terminus terminus;
+    FakeRequester network(answeredBy(terminus));
+    std::vector<events::SensorEvent> published;
+    SensorPoller poller(
+        sdeventplus::Event::get_default(), network.sender(),
+        [&published](const events::SensorEvent& event) {
+            published.push_back(event);
+        },
+        100ms, 1600ms, 1);
+    terminus.numeric[7] = 100;
+    poller.track(9, capabilities(), {numericPdr(7, 1000, 800)});
+
+    for (size_t tick = 0; tick < 32; ++tick)
+    {
+        poller.tick();
+        network.answerAll();
+    }
+    EXPECT_EQ(poller.getInterval(9, 7), 1600ms);
+    ASSERT_EQ(published.size(), 1);
+    EXPECT_EQ(published[0].sensorEventClass, PLDM_NUMERIC_SENSOR_STATE);
+    EXPECT_EQ(published[0].presentReading, 100);
+
+    // A reading heading for the threshold is polled more often
+    terminus.numeric[7] = 400;
+    for (size_t tick = 0; tick < 16; ++tick)
+    {
+        poller.tick();
+        network.answerAll();
+    }
+    EXPECT_EQ(published.size(), 2);
+    EXPECT_EQ(poller.getInterval(9, 7), 400ms);
+
+    // Close to the threshold it's polled at the shortest interval
+    terminus.numeric[7] = 750;
+    for (size_t tick = 0; tick < 4; ++tick)
+    {
+        poller.tick();
+        network.answerAll();
+    }
+    EXPECT_EQ(published.back().presentReading, 750);
+    EXPECT_EQ(poller.getInterval(9, 7), 100ms);
+}
+
+TEST(SensorPoller, testUntrack)
+{
+    Terminus terminus;
+    FakeRequester network(answeredBy(terminus));
+    size_t published = 0;
+    SensorPoller poller(
+        sdeventplus::Event::get_default(), network.sender(),
+        [&published](const events::SensorEvent&) { ++published; }, 100ms,
+        800ms, 1);
+    terminus.numeric[7] = 100;
+    poller.track(9, capabilities(), {numericPdr(7, 1000, 800)});
+
+    // Readings of sensors no longer polled are dropped
+    poller.tick();
+    ASSERT_EQ(network.sent.size(), 1);
+    poller.untrack(9);
+    network.answerAll();
+    EXPECT_EQ(published, 0);
+    EXPECT_EQ(poller.size(), 0);
+
+    // Sensors the terminus has no reading command for aren't polled
+    Capabilities none{};
+    poller.track(9, none, {numericPdr(7, 1000, 800)});
+    EXPECT_EQ(poller.size(), 0);
+}
@@ -0,0 +1,343 @@
+#include "fake_requester.hpp"
+#include "instance_id.hpp"
+#include "requester/handler.hpp"
+#include "requester/terminus.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <map>
+#include <sdeventplus/event.hpp>
+
+#include "libpldm/base.h"
+#include "libpldm/platform.h"
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace pldm::requester;
+using namespace pldm::test;
+
+namespace
+{
+
+class InstanceIds
+{
+  public:
+    uint8_t getInstanceId(uint8_t eid)
+    {
+        return ids[eid].next();
+    }
+
+    void markFree(uint8_t eid, uint8_t instanceId)
+    {
+        ids[eid].markFree(instanceId);
+    }
+
+  private:
+    std::map<uint8_t, InstanceId> ids;
+};
+
+/** @brief Answer a base discovery command like a terminus supporting the
+ *         base and platform types would
+ */
+std::vector<uint8_t> respond(uint8_t tid, const std::vector<uint8_t>& msg)
+{
+    auto request = reinterpret_cast<const pldm_msg*>(msg.data());
+    auto payloadLength = msg.size() - sizeof(pldm_msg_hdr);
+    auto instanceId = request->hdr.instance_id;
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) +
+                                  PLDM_GET_COMMANDS_RESP_BYTES);
+    auto responseMsg = reinterpret_cast<pldm_msg*>(response.data());
+    size_t respMsgLen = 0;
+    switch (request->hdr.command)
+    {
+        case PLDM_GET_TID:
+            encode_get_tid_resp(instanceId, PLDM_SUCCESS, tid, responseMsg);
+            respMsgLen = PLDM_GET_TID_RESP_BYTES;
+            break;
+        case PLDM_GET_PLDM_TYPES:
+        {
+            bitfield8_t types[8]{};
+            types[0].byte = (1 << PLDM_BASE) | (1 << PLDM_PLATFORM);
+            encode_get_types_resp(instanceId, PLDM_SUCCESS, types,
+                                  responseMsg);
+            respMsgLen = PLDM_GET_TYPES_RESP_BYTES;
+            break;
+        }
+        case PLDM_GET_PLDM_VERSION:
+        {
+            uint32_t handle = 0;
+            uint8_t flag = 0;
+            uint8_t type = 0;
+            decode_get_version_req(request, payloadLength, &handle, &flag,
+                                   &type);
+            ver32_t version{0xF1, type, 0xF0, 0};
+            encode_get_version_resp(instanceId, PLDM_SUCCESS, 0,
+                                    PLDM_START_AND_END, &version,
+                                    sizeof(version), responseMsg);
+            respMsgLen = PLDM_GET_VERSION_RESP_BYTES;
+            break;
+        }
+        case PLDM_GET_PLDM_COMMANDS:
+        {
+            uint8_t type = 0;
+            ver32_t version{};
+            decode_get_commands_req(request, payloadLength, &type, &version);
+            bitfield8_t commands[32]{};
+            if (type == PLDM_PLATFORM)
+            {
+                commands[PLDM_GET_PDR / 8].byte |= 1 << (PLDM_GET_PDR % 8);
+            }
+            else
+            {
+                commands[0].byte = 1 << PLDM_GET_TID;
+            }
+            encode_get_commands_resp(instanceId, PLDM_SUCCESS, commands,
+                                     responseMsg);
+            respMsgLen = PLDM_GET_COMMANDS_RESP_BYTES;
+            break;
+        }
+    }
+    response.resize(sizeof(pldm_msg_hdr) + respMsgLen);
+    return response;
+}
+
+/** @brief Answer requests like termini with tids of their endpoint plus
+ *         100 would
+ */
+std::vector<uint8_t> respondByEid(uint8_t eid,
+                                  const std::vector<uint8_t>& msg)
+{
+    return respond(eid + 100, msg);
+}
+
+/** @brief Hand responses to the handler that sent the requests */
+ResponseHandler deliverTo(Handler<InstanceIds>& handler)
+{
+    return [&handler](uint8_t eid, const pldm_msg* response,
+                      size_t respMsgLen) {
+        handler.handleResponse(eid, response, respMsgLen);
+    };
+}
+
+} // namespace
+
+TEST(Handler, testResponseReachesItsRequest)
+{
+    InstanceIds ids;
+    FakeRequester network(respondByEid);
+    Handler<InstanceIds> handler(sdeventplus::Event::get_default(), ids,
+                                 network.transport(deliverTo(handler)),
+                                 std::chrono::milliseconds(100), 2);
+
+    std::map<uint8_t, uint8_t> tids;
+    for (uint8_t eid : {9, 10})
+    {
+        auto rc = handler.sendRequest(
+            eid, PLDM_BASE, PLDM_GET_TID, 0,
+            [](uint8_t instanceId, pldm_msg* msg) {
+                return encode_get_tid_req(instanceId, msg);
+            },
+            [&tids](uint8_t eid, const pldm_msg* response,
+                    size_t respMsgLen) {
+                uint8_t cc = 0;
+                ASSERT_EQ(decode_get_tid_resp(response, respMsgLen, &cc,
+                                              &tids[eid]),
+                          PLDM_SUCCESS);
+            });
+        ASSERT_EQ(rc, PLDM_SUCCESS);
+    }
+    ASSERT_EQ(network.sent.size(), 2);
+    EXPECT_EQ(handler.getPending(), 2);
+
+    // Answer out of order
+    std::reverse(network.sent.begin(), network.sent.end());
+    network.answer();
+    EXPECT_EQ(handler.getPending(), 0);
+    EXPECT_EQ(tids[9], 109);
+    EXPECT_EQ(tids[10], 110);
+
+    // The instance ids were freed
+    EXPECT_EQ(ids.getInstanceId(9), 0);
+}
+
+TEST(Handler, testStrayResponseKeepsInstanceId)
+{
+    InstanceIds ids;
+    FakeRequester network(respondByEid);
+    Handler<InstanceIds> handler(sdeventplus::Event::get_default(), ids,
+                                 network.transport(deliverTo(handler)),
+                                 std::chrono::milliseconds(100), 2);
+    auto send = [&handler](uint8_t command, const Encoder& encode) {
+        return handler.sendRequest(9, PLDM_BASE, command, 0, encode,
+                                   [](uint8_t, const pldm_msg*, size_t) {});
+    };
+
+    ASSERT_EQ(send(PLDM_GET_TID,
+                   [](uint8_t instanceId, pldm_msg* msg) {
+                       return encode_get_tid_req(instanceId, msg);
+                   }),
+              PLDM_SUCCESS);
+    auto response = respond(109, network.sent.front().msg);
+    auto responseMsg = reinterpret_cast<pldm_msg*>(response.data());
+    auto respMsgLen = response.size() - sizeof(pldm_msg_hdr);
+    handler.handleResponse(9, responseMsg, respMsgLen);
+
+    // The next request takes the instance id freed
+    ASSERT_EQ(send(PLDM_GET_PLDM_TYPES,
+                   [](uint8_t instanceId, pldm_msg* msg) {
+                       return encode_get_types_req(instanceId, msg);
+                   }),
+              PLDM_SUCCESS);
+    EXPECT_EQ(handler.getPending(), 1);
+
+    // A duplicate of the first response doesn't free it again
+    handler.handleResponse(9, responseMsg, respMsgLen);
+    EXPECT_EQ(handler.getPending(), 1);
+    EXPECT_EQ(ids.getInstanceId(9), 1);
+}
+
+TEST(Handler, testFailedSend)
+{
+    InstanceIds ids;
+    Handler<InstanceIds> handler(
+        sdeventplus::Event::get_default(), ids,
+        [](uint8_t, const std::vector<uint8_t>&) { return -EIO; },
+        std::chrono::milliseconds(100), 2);
+
+    auto rc = handler.sendRequest(
+        9, PLDM_BASE, PLDM_GET_TID, 0,
+        [](uint8_t instanceId, pldm_msg* msg) {
+            return encode_get_tid_req(instanceId, msg);
+        },
+        [](uint8_t, const pldm_msg*, size_t) { FAIL(); });
+    EXPECT_EQ(rc, PLDM_ERROR);
+    EXPECT_EQ(handler.getPending(), 0);
+    EXPECT_EQ(ids.getInstanceId(9), 0);
+}
+
+TEST(Discovery, testParallelDiscovery)
+{
+    InstanceIds ids;
+    FakeRequester network(respondByEid);
+    Handler<InstanceIds> handler(sdeventplus::Event::get_default(), ids,
+                                 network.transport(deliverTo(handler)),
+                                 std::chrono::milliseconds(100), 2);
+    Discovery discovery(
+        [&handler](uint8_t eid, uint8_t type, uint8_t command,
+                   size_t payloadLength, const Encoder& encode,
+                   ResponseHandler responseHandler) {
+            return handler.sendRequest(eid, type, command, payloadLength,
+                                       encode, std::move(responseHandler));
+        });
+    std::vector<uint8_t> discovered;
+    discovery.subscribe(
+        [&discovered](uint8_t eid, std::shared_ptr<const Capabilities> caps) {
+            if (caps)
+            {
+                discovered.push_back(eid);
+            }
+        });
+
+    discovery.discover({9, 10});
+    // GetTID and GetPLDMTypes went out to both endpoints at once
+    ASSERT_EQ(network.sent.size(), 4);
+
+    // Answer round by round, every endpoint is probed within each round
+    EXPECT_EQ(network.answerAll(), 3);
+    EXPECT_EQ(discovered.size(), 2);
+
+    auto caps = discovery.get(10);
+    ASSERT_NE(caps, nullptr);
+    EXPECT_EQ(caps->tid, 110);
+    EXPECT_TRUE(caps->types.test(PLDM_BASE));
+    EXPECT_TRUE(caps->types.test(PLDM_PLATFORM));
+    EXPECT_FALSE(caps->types.test(PLDM_BIOS));
+    EXPECT_EQ(caps->versions.at(PLDM_PLATFORM).minor, PLDM_PLATFORM);
+    EXPECT_TRUE(discovery.supports(9, PLDM_PLATFORM, PLDM_GET_PDR));
+    EXPECT_FALSE(discovery.supports(9, PLDM_PLATFORM, PLDM_GET_TID));
+    EXPECT_TRUE(discovery.supports(9, PLDM_BASE, PLDM_GET_TID));
+
+    // Cached termini aren't probed again
+    discovery.discover({9, 10});
+    EXPECT_TRUE(network.sent.empty());
+}
+
+TEST(Discovery, testInvalidate)
+{
+    InstanceIds ids;
+    FakeRequester network(respondByEid);
+    Handler<InstanceIds> handler(sdeventplus::Event::get_default(), ids,
+                                 network.transport(deliverTo(handler)),
+                                 std::chrono::milliseconds(100), 2);
+    Discovery discovery(
+        [&handler](uint8_t eid, uint8_t type, uint8_t command,
+                   size_t payloadLength, const Encoder& encode,
+                   ResponseHandler responseHandler) {
+            return handler.sendRequest(eid, type, command, payloadLength,
+                                       encode, std::move(responseHandler));
+        });
+    std::vector<std::pair<uint8_t, bool>> changes;
+    discovery.subscribe(
+        [&changes](uint8_t eid, std::shared_ptr<const Capabilities> caps) {
+            changes.emplace_back(eid, caps != nullptr);
+        });
+    discovery.discover({9});
+    network.answerAll();
+    ASSERT_NE(discovery.get(9), nullptr);
+
+    // Endpoint reset
+    discovery.invalidate(9);
+    EXPECT_EQ(discovery.get(9), nullptr);
+    EXPECT_FALSE(discovery.supports(9, PLDM_BASE, PLDM_GET_TID));
+
+    // Responses to a probe abandoned by a reset are ignored
+    discovery.discover({9});
+    discovery.invalidate(9);
+    network.answer();
+    EXPECT_TRUE(network.sent.empty());
+    EXPECT_EQ(discovery.get(9), nullptr);
+
+    discovery.discover({9});
+    network.answerAll();
+    EXPECT_NE(discovery.get(9), nullptr);
+
+    std::vector<std::pair<uint8_t, bool>> expected{
+        {9, true}, {9, false}, {9, true}};
+    EXPECT_EQ(changes, expected);
+}
+
+TEST(Discovery, testFailedProbeIsRetried)
+{
+    InstanceIds ids;
+    FakeRequester network(respondByEid);
+    Handler<InstanceIds> handler(sdeventplus::Event::get_default(), ids,
+                                 network.transport(deliverTo(handler)),
+                                 std::chrono::milliseconds(100), 2);
+    Discovery discovery(
+        [&handler](uint8_t eid, uint8_t type, uint8_t command,
+                   size_t payloadLength, const Encoder& encode,
+                   ResponseHandler responseHandler) {
+            return handler.sendRequest(eid, type, command, payloadLength,
+                                       encode, std::move(responseHandler));
+        });
+
+    discovery.discover({9});
+    ASSERT_EQ(network.sent.size(), 2);
+    for (const auto& request : network.sent)
+    {
+        auto msg = reinterpret_cast<const pldm_msg*>(request.msg.data());
+        std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + 1);
+        encode_cc_only_resp(msg->hdr.instance_id, PLDM_BASE, msg->hdr.command,
+                            PLDM_ERROR_UNSUPPORTED_PLDM_CMD,
+                            reinterpret_cast<pldm_msg*>(response.data()));
+        handler.handleResponse(9, reinterpret_cast<pldm_msg*>(response.data()),
+                               1);
+    }
+    network.sent.clear();
+    EXPECT_EQ(discovery.get(9), nullptr);
+
+    // Failures aren't cached
+    discovery.discover({9});
+    EXPECT_EQ(network.sent.size(), 2);
+}
@@ -0,0 +1,181 @@
+#include "transfer.hpp"
+
+#include <numeric>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder::transfer;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+constexpr uint8_t command = 0x01;
+constexpr uint8_t tableType = 0x02;
+
+/** @brief Builds a table of the given size, counting how often it's built */
+struct Builder
+{
+    uint8_t operator()(std::shared_ptr<const Table>& table)
+    {
+        ++built;
+        auto fresh = std::make_shared<Table>(size);
+        std::iota(fresh->begin(), fresh->end(), first);
+        table = std::move(fresh);
+        return PLDM_SUCCESS;
+    }
+
+    size_t size;
+    uint8_t first = 0;
+    size_t built = 0;
+};
+
+/** @brief Get a table from its parts
+ *
+ *  @param[in] sessions - the sessions
+ *  @param[in] eid - endpoint asking for the table
+ *  @param[in] build - builds the table
+ *  @param[out] flags - transfer flags of the parts
+ *
+ *  @return Table - the table
+ */
+Table getAll(Sessions& sessions, uint8_t eid, const Build& build,
+             std::vector<uint8_t>& flags)
+{
+    Table table;
+    uint32_t handle = 0;
+    uint8_t opFlag = PLDM_GET_FIRSTPART;
+    do
+    {
+        Part part;
+        EXPECT_EQ(sessions.getPart(eid, command, tableType, handle, opFlag,
+                                   build, part),
+                  PLDM_SUCCESS);
+        table.insert(table.end(), part.data, part.data + part.length);
+        flags.push_back(part.transferFlag);
+        handle = part.nextTransferHandle;
+        opFlag = PLDM_GET_NEXTPART;
+    } while (handle);
+    return table;
+}
+
+} // namespace
+
+TEST(Transfer, testParts)
+{
+    Sessions sessions(16, 1024, 1h);
+    Builder builder{40};
+    std::vector<uint8_t> flags;
+    auto table = getAll(sessions, 9, std::ref(builder), flags);
+
+    Table expected(40);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(table, expected);
+    EXPECT_EQ(flags,
+              std::vector<uint8_t>({PLDM_START, PLDM_MIDDLE, PLDM_END}));
+    EXPECT_EQ(builder.built, 1);
+
+    // A table that fits in a part takes no session
+    Sessions small(64, 1024, 1h);
+    flags.clear();
+    EXPECT_EQ(getAll(small, 9, std::ref(builder), flags), expected);
+    EXPECT_EQ(flags, std::vector<uint8_t>({PLDM_START_AND_END}));
+    EXPECT_EQ(small.size(), 0);
+}
+
+TEST(Transfer, testSnapshotPerEndpoint)
+{
+    Sessions sessions(16, 1024, 1h);
+    Builder builder{40};
+    Part first;
+    ASSERT_EQ(sessions.getPart(9, command, tableType, 0, PLDM_GET_FIRSTPART,
+                               std::ref(builder), first),
+              PLDM_SUCCESS);
+
+    // Another endpoint gets the table as it is now, the first one keeps
+    // getting the table as it was
+    builder.first = 100;
+    std::vector<uint8_t> flags;
+    EXPECT_EQ(getAll(sessions, 10, std::ref(builder), flags)[0], 100);
+    Part next;
+    ASSERT_EQ(sessions.getPart(9, command, tableType,
+                               first.nextTransferHandle, PLDM_GET_NEXTPART,
+                               std::ref(builder), next),
+              PLDM_SUCCESS);
+    EXPECT_EQ(next.data[0], 16);
+    EXPECT_EQ(sessions.size(), 2);
+    EXPECT_EQ(sessions.bytes(), 80);
+
+    // Handles other than the offsets of the table aren't taken
+    EXPECT_EQ(sessions.getPart(9, command, tableType, 40, PLDM_GET_NEXTPART,
+                               std::ref(builder), next),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(sessions.getPart(11, command, tableType, 16,
+                               PLDM_GET_NEXTPART, std::ref(builder), next),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(sessions.getPart(9, command, tableType, 16, 2,
+                               std::ref(builder), next),
+              PLDM_INVALID_TRANSFER_OPERATION_FLAG);
+}
+
+TEST(Transfer, testExpiryAndMemoryLimit)
+{
+    Builder builder{40};
+    Part part;
+    Sessions expiring(16, 1024, 0ms);
+    ASSERT_EQ(expiring.getPart(9, command, tableType, 0, PLDM_GET_FIRSTPART,
+                               std::ref(builder), part),
+              PLDM_SUCCESS);
+    EXPECT_EQ(expiring.getPart(9, command, tableType,
+                               part.nextTransferHandle, PLDM_GET_NEXTPART,
+                               std::ref(builder), part),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(expiring.size(), 0);
+
+    // The least recently used session makes room for a new one
+    Sessions limited(16, 100, 1h);
+    for (uint8_t eid = 9; eid < 12; ++eid)
+    {
+        ASSERT_EQ(limited.getPart(eid, command, tableType, 0,
+                                  PLDM_GET_FIRSTPART, std::ref(builder), part),
+                  PLDM_SUCCESS);
+    }
+    EXPECT_EQ(limited.size(), 2);
+    EXPECT_EQ(limited.bytes(), 80);
+    EXPECT_EQ(limited.getPart(9, command, tableType, 16, PLDM_GET_NEXTPART,
+                              std::ref(builder), part),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(limited.getPart(11, command, tableType, 16, PLDM_GET_NEXTPART,
+                              std::ref(builder), part),
+              PLDM_SUCCESS);
+
+    // A table larger than the limit is sent in the session kept outside
+    // the limit, the sessions within it are kept
+    builder.size = 200;
+    std::vector<uint8_t> flags;
+    EXPECT_EQ(getAll(limited, 9, std::ref(builder), flags).size(), 200);
+    EXPECT_EQ(limited.size(), 3);
+    EXPECT_EQ(limited.bytes(), 280);
+
+    // The next one takes its place
+    ASSERT_EQ(limited.getPart(12, command, tableType, 0, PLDM_GET_FIRSTPART,
+                              std::ref(builder), part),
+              PLDM_SUCCESS);
+    EXPECT_EQ(limited.size(), 3);
+    EXPECT_EQ(limited.getPart(9, command, tableType, 16, PLDM_GET_NEXTPART,
+                              std::ref(builder), part),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(limited.getPart(12, command, tableType, 16, PLDM_GET_NEXTPART,
+                              std::ref(builder), part),
+              PLDM_SUCCESS);
+
+    // Smaller tables don't evict it
+    builder.size = 40;
+    ASSERT_EQ(limited.getPart(13, command, tableType, 0, PLDM_GET_FIRSTPART,
+                              std::ref(builder), part),
+              PLDM_SUCCESS);
+    EXPECT_EQ(limited.bytes(), 280);
+    EXPECT_EQ(limited.getPart(12, command, tableType, 32, PLDM_GET_NEXTPART,
+                              std::ref(builder), part),
+              PLDM_SUCCESS);
+}
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "libpldm/base.h"
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace transfer
+{
+
+using Table = std::vector<uint8_t>;
+
+/** @brief Builds the table a transfer sends, or shares one already built
+ *
+ *  @param[out] table - the table, which mustn't change once shared
+ *
+ *  @return uint8_t - PLDM completion code
+ */
+using Build = std::function<uint8_t(std::shared_ptr<const Table>& table)>;
+
+/** @struct Part
+ *
+ *  @brief A part of a table, to go in a response
+ */
+struct Part
+{
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+    uint32_t nextTransferHandle = 0;
+    uint8_t transferFlag = PLDM_START_AND_END;
+
+    /** @brief The snapshot the part is of, kept alive while it's sent */
+    std::shared_ptr<const Table> snapshot;
+};
+
+/** @class Sessions
+ *
+ *  @brief Multipart transfers of tables, such as the BIOS tables or the FRU
+ *         record table, to the endpoints asking for them.
+ *
+ *  GetFirstPart takes a snapshot of the table, so the parts an endpoint gets
+ *  are of the same table even if it changes in the meantime. A table larger
+ *  than a part is kept in a session per endpoint, command and table type,
+ *  and the transfer handle of a part is its offset in the table. Sessions
+ *  idle for longer than the timeout are dropped, and so are the least
+ *  recently used ones when the snapshots would take more than the memory
+ *  limit. A table larger than the limit on its own is still sent, in the
+ *  one session kept outside the limit, which the next such table takes
+ *  over; at most the limit plus the largest table are held.
+ */
+class Sessions
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Constructor
+     *
+     *  @param[in] partSize - most table bytes sent in one response
+     *  @param[in] maxBytes - most bytes the snapshots of the sessions take
+     *  @param[in] timeout - time after which an idle session is dropped
+     */
+    Sessions(size_t partSize, size_t maxBytes, Clock::duration timeout) :
+        partSize(partSize), maxBytes(maxBytes), timeout(timeout)
+    {
+    }
+
+    /** @brief Get the part of a table asked for
+     *
+     *  @param[in] eid - MCTP endpoint asking for the table
+     *  @param[in] command - PLDM command asking for the table
+     *  @param[in] tableType - type of the table
+     *  @param[in] transferHandle - transfer handle of the part, ignored for
+     *                              the first part
+     *  @param[in] transferOpFlag - PLDM_GET_FIRSTPART or PLDM_GET_NEXTPART
+     *  @param[in] build - builds the table, called for the first part
+     *  @param[out] part - the part
+     *
+     *  @return uint8_t - PLDM completion code
+     */
+    uint8_t getPart(uint8_t eid, uint8_t command, uint8_t tableType,
+                    uint32_t transferHandle, uint8_t transferOpFlag,
+                    const Build& build, Part& part)
+    {
+        auto now = Clock::now();
+        expire(now);
+
+        Key key{eid, command, tableType};
+        uint32_t offset = 0;
+        if (transferOpFlag == PLDM_GET_FIRSTPART)
+        {
+            drop(key);
+            auto cc = build(part.snapshot);
+            if (cc != PLDM_SUCCESS)
+            {
+                return cc;
+            }
+            if (!part.snapshot)
+            {
+                part.snapshot = std::make_shared<const Table>();
+            }
+            if (part.snapshot->size() > partSize)
+            {
+                hold(key, part.snapshot, now);
+            }
+        }
+        else if (transferOpFlag == PLDM_GET_NEXTPART)
+        {
+            auto found = sessions.find(key);
+            if (found == sessions.end() || !transferHandle ||
+                transferHandle >= found->second.snapshot->size())
+            {
+                return PLDM_ERROR_INVALID_DATA;
+            }
+            found->second.lastUsed = now;
+            part.snapshot = found->second.snapshot;
+            offset = transferHandle;
+        }
+        else
+        {
+            return PLDM_INVALID_TRANSFER_OPERATION_FLAG;
+        }
+
+        const auto& table = *part.snapshot;
+        part.data = table.data() + offset;
+        part.length = std::min(partSize, table.size() - offset);
+        bool last = offset + part.length == table.size();
+        part.nextTransferHandle = last ? 0 : offset + part.length;
+        if (!offset)
+        {
+            part.transferFlag = last ? PLDM_START_AND_END : PLDM_START;
+        }
+        else
+        {
+            part.transferFlag = last ? PLDM_END : PLDM_MIDDLE;
+        }
+        return PLDM_SUCCESS;
+    }
+
+    /** @brief Get the number of open sessions
+     *
+     *  @return size_t - number of sessions
+     */
+    size_t size() const
+    {
+        return sessions.size();
+    }
+
+    /** @brief Get the bytes the snapshots of the open sessions take
+     *
+     *  @return size_t - number of bytes
+     */
+    size_t bytes() const
+    {
+        if (oversized)
+        {
+            return held + sessions.at(*oversized).snapshot->size();
+        }
+        return held;
+    }
+
+  private:
+    /** @brief Endpoint, command and table type of a session */
+    using Key = std::tuple<uint8_t, uint8_t, uint8_t>;
+
+    /** @struct Session
+     *
+     *  @brief A table being sent in parts
+     */
+    struct Session
+    {
+        std::shared_ptr<const Table> snapshot;
+        Clock::time_point lastUsed;
+    };
+
+    /** @brief Open a session, dropping the least recently used ones to make
+     *         room for it. A table larger than the memory limit takes the
+     *         place of the session kept outside the limit instead.
+     *
+     *  @param[in] key - the session
+     *  @param[in] snapshot - the table it sends
+     *  @param[in] now - the time
+     */
+    void hold(const Key& key, const std::shared_ptr<const Table>& snapshot,
+              Clock::time_point now)
+    {
+        if (snapshot->size() > maxBytes)
+        {
+            if (oversized)
+            {
+                drop(*oversized);
+            }
+            sessions[key] = {snapshot, now};
+            oversized = key;
+            return;
+        }
+        while (held + snapshot->size() > maxBytes)
+        {
+            auto oldest = sessions.end();
+            for (auto it = sessions.begin(); it != sessions.end(); ++it)
+            {
+                if (it->first != oversized &&
+                    (oldest == sessions.end() ||
+                     it->second.lastUsed < oldest->second.lastUsed))
+                {
+                    oldest = it;
+                }
+            }
+            erase(oldest);
+        }
+        sessions[key] = {snapshot, now};
+        held += snapshot->size();
+    }
+
+    /** @brief Drop a session if it's open
+     *
+     *  @param[in] key - the session
+     */
+    void drop(const Key& key)
+    {
+        auto found = sessions.find(key);
+        if (found != sessions.end())
+        {
+            erase(found);
+        }
+    }
+
+    /** @brief Close a session
+     *
+     *  @param[in] session - the session
+     *
+     *  @return iterator to the session after it
+     */
+    std::map<Key, Session>::iterator
+        erase(std::map<Key, Session>::iterator session)
+    {
+        if (session->first == oversized)
+        {
+            oversized.reset();
+        }
+        else
+        {
+            held -= session->second.snapshot->size();
+        }
+        return sessions.erase(session);
+    }
+
+    /** @brief Drop the sessions idle for longer than the timeout
+     *
+     *  @param[in] now - the time
+     */
+    void expire(Clock::time_point now)
+    {
+        for (auto it = sessions.begin(); it != sessions.end();)
+        {
+            if (now - it->second.lastUsed >= timeout)
+            {
+                it = erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    /** @brief Most table bytes sent in one response */
+    size_t partSize;
+
+    /** @brief Most bytes the snapshots of the sessions take */
+    size_t maxBytes;
+
+    /** @brief Time after which an idle session is dropped */
+    Clock::duration timeout;
+
+    /** @brief The open sessions */
+    std::map<Key, Session> sessions;
+
+    /** @brief Bytes the snapshots of the sessions within the memory limit
+     *         take
+     */
+    size_t held = 0;
+
+    /** @brief The session of a table larger than the memory limit, if any */
+    std::optional<Key> oversized;
+};
+
+} // namespace transfer
+
+} // namespace responder
+} // namespace pldm
@@ -1,11 +1,20 @@
 #include "utils.hpp"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <ctime>
 #include <iostream>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sdbusplus/bus/match.hpp>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 #include <xyz/openbmc_project/Common/error.hpp>
 
@@ -18,6 +27,176 @@ constexpr auto mapperBusName = "xyz.openbmc_project.ObjectMapper";
 constexpr auto mapperPath = "/xyz/openbmc_project/object_mapper";
 constexpr auto mapperInterface = "xyz.openbmc_project.ObjectMapper";
 
+namespace
+{
+
+/** @class ServiceCache
+ *
+ *  @brief Process wide (object path, interface) -> service name cache in
+ *         front of the ObjectMapper
+ */
+class ServiceCache
+{
+  public:
+    /** @brief Look up a cached service name
+     *
+     *  @param[in] path - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     *
+     *  @return std::optional<std::string> - the service, if cached
+     */
+    std::optional<std::string> find(const std::string& path,
+                                    const std::string& interface)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = services.find({path, interface});
+        if (it == services.end())
+        {
+            ++misses;
+            return std::nullopt;
+        }
+        ++hits;
+        return it->second;
+    }
+
+    /** @brief Cache a service name, and subscribe to the signals that
+     *         invalidate it if that's not done yet
+     *
+     *  @param[in] path - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     *  @param[in] service - service name returned by the ObjectMapper
+     */
+    void add(const std::string& path, const std::string& interface,
+             const std::string& service)
+    {
+        bool newPath = false;
+        bool newService = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            services[{path, interface}] = service;
+            newPath = watchedPaths.insert(path).second;
+            newService = watchedServices.insert(service).second;
+        }
+        if (newPath)
+        {
+            watchPath(path);
+        }
+        if (newService)
+        {
+            watchService(service);
+        }
+    }
+
+    ServiceCacheStats stats() const
+    {
+        return {hits, misses};
+    }
+
+  private:
+    /** @brief Subscribe to the interfaces of an object coming and going,
+     *         only the cached objects are watched so that objects added
+     *         elsewhere on the bus don't wake pldmd
+     *
+     *  @param[in] path - D-Bus object path
+     */
+    void watchPath(const std::string& path)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        auto& bus = DBusHandler::getBus();
+        auto onInterfacesChanged = [this,
+                                    path](sdbusplus::message::message&) {
+            erasePath(path);
+        };
+        std::lock_guard<std::mutex> lock(matchesMutex);
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match::match>(
+            bus, rules::interfacesAdded() + rules::argNpath(0, path),
+            onInterfacesChanged));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match::match>(
+            bus, rules::interfacesRemoved() + rules::argNpath(0, path),
+            onInterfacesChanged));
+    }
+
+    /** @brief Subscribe to a cached service going away
+     *
+     *  @param[in] service - service name
+     */
+    void watchService(const std::string& service)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        auto& bus = DBusHandler::getBus();
+        std::lock_guard<std::mutex> lock(matchesMutex);
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match::match>(
+            bus, rules::nameOwnerChanged() + rules::argN(0, service),
+            [this](sdbusplus::message::message& msg) {
+                std::string name;
+                std::string oldOwner;
+                std::string newOwner;
+                try
+                {
+                    msg.read(name, oldOwner, newOwner);
+                }
+                catch (const std::exception& e)
+                {
+                    clear();
+                    return;
+                }
+                if (!oldOwner.empty())
+                {
+                    eraseService(name);
+                }
+            }));
+    }
+
+    /** @brief Forget everything, when a signal can't be decoded */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        services.clear();
+    }
+
+    /** @brief Forget the objects of a service that went away */
+    void eraseService(const std::string& service)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = services.begin(); it != services.end();)
+        {
+            it = it->second == service ? services.erase(it) : std::next(it);
+        }
+    }
+
+    /** @brief Forget an object, some other service may implement the
+     *         interfaces it added */
+    void erasePath(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = services.lower_bound({path, ""});
+        while (it != services.end() && it->first.first == path)
+        {
+            it = services.erase(it);
+        }
+    }
+
+    std::mutex mutex;
+    std::map<std::pair<std::string, std::string>, std::string> services;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+
+    /** @brief Objects and services ever cached, each watched from then on */
+    std::set<std::string> watchedPaths;
+    std::set<std::string> watchedServices;
+
+    std::mutex matchesMutex;
+    std::vector<std::unique_ptr<sdbusplus::bus::match::match>> matches;
+};
+
+ServiceCache& serviceCache()
+{
+    static ServiceCache cache;
+    return cache;
+}
+
+} // namespace
+
 uint8_t getNumPadBytes(uint32_t data)
 {
     uint8_t pad;
@@ -92,6 +271,12 @@ bool decodeEffecterData(const std::vector<uint8_t>& effecterData,
 std::string DBusHandler::getService(const char* path,
                                     const char* interface) const
 {
+    auto& cache = serviceCache();
+    if (auto service = cache.find(path, interface))
+    {
+        return *service;
+    }
+
     using DbusInterfaceList = std::vector<std::string>;
     std::map<std::string, std::vector<std::string>> mapperResponse;
     auto& bus = DBusHandler::getBus();
@@ -102,7 +287,145 @@ std::string DBusHandler::getService(const char* path,
 
     auto mapperResponseMsg = bus.call(mapper);
     mapperResponseMsg.read(mapperResponse);
-    return mapperResponse.begin()->first;
+    if (mapperResponse.empty())
+    {
+        throw std::runtime_error("No service implements the interface");
+    }
+
+    const auto& service = mapperResponse.begin()->first;
+    cache.add(path, interface, service);
+    return service;
+}
+
+ServiceCacheStats DBusHandler::getServiceCacheStats()
+{
+    return serviceCache().stats();
+}
+
+std::vector<std::optional<PropertyMap>>
+    DBusHandler::getDbusPropertiesConcurrently(
+        const std::vector<std::pair<std::string, std::string>>& objects,
+        std::chrono::microseconds timeout) const
+{
+    auto& bus = DBusHandler::getCallBus();
+    std::vector<sdbusplus::message::message> methods;
+    std::vector<size_t> sent;
+    methods.reserve(objects.size());
+    sent.reserve(objects.size());
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        const auto& [path, interface] = objects[i];
+        try
+        {
+            auto service = getService(path.c_str(), interface.c_str());
+            auto method = bus.new_method_call(service.c_str(), path.c_str(),
+                                              dbusProperties, "GetAll");
+            method.append(interface);
+            methods.emplace_back(std::move(method));
+            sent.emplace_back(i);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error looking up service, ERROR=" << e.what()
+                      << " INTERFACE=" << interface << " PATH=" << path
+                      << "\n";
+        }
+    }
+
+    std::vector<std::optional<PropertyMap>> results(objects.size());
+    callConcurrently(
+        methods, timeout,
+        [&results, &sent](size_t index, sdbusplus::message::message& reply) {
+            PropertyMap properties;
+            reply.read(properties);
+            results[sent[index]] = std::move(properties);
+        });
+    return results;
+}
+
+std::vector<bool> DBusHandler::callConcurrently(
+    std::vector<sdbusplus::message::message>& methods,
+    std::chrono::microseconds timeout, const ReplyHandler& handler)
+{
+    struct Pending
+    {
+        sd_bus_slot* slot = nullptr;
+        bool done = false;
+        bool ok = false;
+        size_t index = 0;
+        const ReplyHandler* handler = nullptr;
+    };
+    std::vector<Pending> pending(methods.size());
+    auto onReply = [](sd_bus_message* reply, void* userdata,
+                      sd_bus_error* /*error*/) {
+        auto p = static_cast<Pending*>(userdata);
+        p->done = true;
+        p->ok = !sd_bus_message_is_method_error(reply, nullptr);
+        if (p->ok && *p->handler)
+        {
+            try
+            {
+                sdbusplus::message::message msg(reply);
+                (*p->handler)(p->index, msg);
+            }
+            catch (const std::exception& e)
+            {
+                p->ok = false;
+            }
+        }
+        return 0;
+    };
+
+    auto bus = DBusHandler::getCallBus().get();
+    for (size_t i = 0; i < methods.size(); ++i)
+    {
+        pending[i].index = i;
+        pending[i].handler = &handler;
+        auto rc = sd_bus_call_async(bus, &pending[i].slot, methods[i].get(),
+                                    onReply, &pending[i], timeout.count());
+        if (rc < 0)
+        {
+            std::cerr << "Failed to send D-Bus method call, RC=" << rc << "\n";
+            pending[i].done = true;
+        }
+    }
+
+    // sd-bus fails each call with a timeout reply on its own, the deadline
+    // only guards against the bus connection going away
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    auto busy = [&pending]() {
+        return std::any_of(pending.begin(), pending.end(),
+                           [](const Pending& p) { return !p.done; });
+    };
+    while (busy())
+    {
+        auto rc = sd_bus_process(bus, nullptr);
+        if (rc < 0)
+        {
+            break;
+        }
+        if (rc > 0)
+        {
+            continue;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+        {
+            break;
+        }
+        sd_bus_wait(bus, std::chrono::duration_cast<std::chrono::microseconds>(
+                             deadline - now)
+                             .count());
+    }
+
+    std::vector<bool> results;
+    results.reserve(pending.size());
+    for (auto& p : pending)
+    {
+        sd_bus_slot_unref(p.slot);
+        results.emplace_back(p.done && p.ok);
+    }
+    return results;
 }
 
 void reportError(const char* errorMsg)
@@ -4,10 +4,15 @@
 #include <systemd/sd-bus.h>
 #include <unistd.h>
 
+#include <chrono>
 #include <exception>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <optional>
 #include <sdbusplus/server.hpp>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
@@ -116,6 +121,34 @@ T decimalToBcd(T decimal)
 
 constexpr auto dbusProperties = "org.freedesktop.DBus.Properties";
 
+using PropertyValue =
+    std::variant<bool, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t,
+                 uint64_t, double, std::string>;
+using PropertyMap = std::map<std::string, PropertyValue>;
+
+/** @struct PropertyWrite
+ *
+ *  @brief One D-Bus property write of a batch
+ */
+template <typename T>
+struct PropertyWrite
+{
+    const char* objPath;          //!< Object path for the D-Bus object
+    const char* dbusProp;         //!< The D-Bus property
+    const char* dbusInterface;    //!< The D-Bus interface
+    const std::variant<T>* value; //!< The value to be set
+};
+
+/** @struct ServiceCacheStats
+ *
+ *  @brief Lookup counts of the D-Bus service name cache
+ */
+struct ServiceCacheStats
+{
+    uint64_t hits;   //!< lookups answered from the cache
+    uint64_t misses; //!< lookups that called the ObjectMapper
+};
+
 /**
  *  @class DBusHandler
  *
@@ -136,13 +169,22 @@ class DBusHandler
     }
 
     /**
-     *  @brief Get the DBUS Service name for the input dbus path
+     *  @brief Get the DBUS Service name for the input dbus path. Names are
+     *         cached process wide, the cache is invalidated when a cached
+     *         service loses its name or a cached object adds or removes
+     *         interfaces.
      *  @param[in] path - DBUS object path
      *  @param[in] interface - DBUS Interface
      *  @return std::string - the dbus service name
      */
     std::string getService(const char* path, const char* interface) const;
 
+    /** @brief Get the lookup counts of the D-Bus service name cache
+     *
+     *  @return ServiceCacheStats - hit and miss counts
+     */
+    static ServiceCacheStats getServiceCacheStats();
+
     /** @brief API to set a D-Bus property
      *
      *  @param[in] objPath - Object path for the D-Bus object
@@ -164,6 +206,53 @@ class DBusHandler
         bus.call_noreply(method);
     }
 
+    /** @brief API to set several D-Bus properties concurrently, the calls
+     *         are all sent before waiting for any reply
+     *
+     *  @param[in] writes - the property writes
+     *  @param[in] timeout - timeout of each property write
+     *
+     *  @return std::vector<bool> - true for each write that succeeded
+     */
+    template <typename T>
+    std::vector<bool>
+        setDbusProperties(const std::vector<PropertyWrite<T>>& writes,
+                          std::chrono::microseconds timeout) const
+    {
+        auto& bus = DBusHandler::getCallBus();
+        std::vector<sdbusplus::message::message> methods;
+        std::vector<size_t> sent;
+        methods.reserve(writes.size());
+        sent.reserve(writes.size());
+        for (size_t i = 0; i < writes.size(); ++i)
+        {
+            const auto& w = writes[i];
+            try
+            {
+                auto service = getService(w.objPath, w.dbusInterface);
+                auto method = bus.new_method_call(service.c_str(), w.objPath,
+                                                  dbusProperties, "Set");
+                method.append(w.dbusInterface, w.dbusProp, *w.value);
+                methods.emplace_back(std::move(method));
+                sent.emplace_back(i);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Error looking up service, ERROR=" << e.what()
+                          << " INTERFACE=" << w.dbusInterface
+                          << " PATH=" << w.objPath << "\n";
+            }
+        }
+
+        std::vector<bool> results(writes.size(), false);
+        auto replies = callConcurrently(methods, timeout);
+        for (size_t i = 0; i < sent.size(); ++i)
+        {
+            results[sent[i]] = replies[i];
+        }
+        return results;
+    }
+
     template <typename Variant>
     auto getDbusPropertyVariant(const char* objPath, const char* dbusProp,
                                 const char* dbusInterface)
@@ -180,6 +269,42 @@ class DBusHandler
         return value;
     }
 
+    /** @brief API to get all the D-Bus properties of an interface
+     *
+     *  @param[in] objPath - Object path for the D-Bus object
+     *  @param[in] dbusInterface - The D-Bus interface
+     *
+     *  @return PropertyMap - the properties by name
+     */
+    PropertyMap getDbusProperties(const char* objPath,
+                                  const char* dbusInterface) const
+    {
+        PropertyMap properties;
+        auto& bus = DBusHandler::getBus();
+        auto service = getService(objPath, dbusInterface);
+        auto method = bus.new_method_call(service.c_str(), objPath,
+                                          dbusProperties, "GetAll");
+        method.append(dbusInterface);
+        auto reply = bus.call(method);
+        reply.read(properties);
+
+        return properties;
+    }
+
+    /** @brief API to get all the D-Bus properties of several interfaces
+     *         concurrently, the calls are all sent before waiting for any
+     *         reply
+     *
+     *  @param[in] objects - object paths and interfaces of the properties
+     *  @param[in] timeout - timeout of each call
+     *
+     *  @return std::vector<std::optional<PropertyMap>> - the properties of
+     *          each interface, std::nullopt where they couldn't be got
+     */
+    std::vector<std::optional<PropertyMap>> getDbusPropertiesConcurrently(
+        const std::vector<std::pair<std::string, std::string>>& objects,
+        std::chrono::microseconds timeout) const;
+
     template <typename Property>
     auto getDbusProperty(const char* objPath, const char* dbusProp,
                          const char* dbusInterface)
@@ -188,6 +313,42 @@ class DBusHandler
             objPath, dbusProp, dbusInterface);
         return std::get<Property>(VariantValue);
     }
+
+  private:
+    /** @brief Get the connection the concurrent calls are made on. Nothing
+     *         subscribes to signals or serves objects on it, so waiting for
+     *         replies on it dispatches nothing but replies.
+     */
+    static auto& getCallBus()
+    {
+        static auto bus = sdbusplus::bus::new_system();
+        return bus;
+    }
+
+    /** @brief Handles the reply to the method call at an index, throwing if
+     *         the reply can't be read
+     */
+    using ReplyHandler =
+        std::function<void(size_t index, sdbusplus::message::message& reply)>;
+
+    /** @brief Send D-Bus method calls without waiting for the replies in
+     *         between, then process the bus until every call has its reply
+     *         or has timed out.
+     *
+     *  The calls go out on their own connection, so the handlers of the
+     *  signals on the main connection don't run while a caller waits, the
+     *  same as with a blocking call.
+     *
+     *  @param[in] methods - method calls to send, made on getCallBus()
+     *  @param[in] timeout - timeout of each method call
+     *  @param[in] handler - handles the reply of each call that succeeded
+     *
+     *  @return std::vector<bool> - true for each call that succeeded
+     */
+    static std::vector<bool>
+        callConcurrently(std::vector<sdbusplus::message::message>& methods,
+                         std::chrono::microseconds timeout,
+                         const ReplyHandler& handler = nullptr);
 };
 
 } // namespace utils